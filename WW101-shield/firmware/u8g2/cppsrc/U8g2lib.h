@@ -96,6 +96,11 @@ class U8G2 : public Print
     /* U8X8_MSG_GPIO_MENU_NEXT, U8X8_MSG_GPIO_MENU_PREV, */
     /* U8X8_MSG_GPIO_MENU_HOME */
     uint8_t getMenuEvent(void) { return u8x8_GetMenuEvent(u8g2_GetU8x8(&u8g2)); }
+    uint8_t waitMenuEvent(void) { return u8x8_WaitMenuEvent(u8g2_GetU8x8(&u8g2)); }
+#ifdef U8X8_WITH_EVENT
+    /* u8x8_event.c */
+    void setEventQueue(u8x8_event_queue_t *queue) { u8x8_SetEventQueue(u8g2_GetU8x8(&u8g2), queue); }
+#endif
 
     void initDisplay(void) {
       u8g2_InitDisplay(&u8g2); }
@@ -147,6 +152,59 @@ class U8G2 : public Print
     /* u8g2_buffer.c */
     void sendBuffer(void) { u8g2_SendBuffer(&u8g2); }
     void clearBuffer(void) { u8g2_ClearBuffer(&u8g2); }    
+    void invertBuffer(void) { u8g2_InvertBuffer(&u8g2); }
+    void xorBuffer(const uint8_t *src) { u8g2_XorBuffer(&u8g2, src); }
+    void copyBufferMasked(const uint8_t *src, const uint8_t *mask) { u8g2_CopyBufferMasked(&u8g2, src, mask); }
+    void fillBufferRegion(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) { u8g2_FillBufferRegion(&u8g2, x, y, w, h); }
+    
+    /* u8g2_sprite.c */
+    void initLayer(u8g2_layer_t *layer, const uint8_t *background, u8g2_sprite_t *sprite_list, uint8_t sprite_cnt, uint8_t *dirty) {
+      u8g2_InitLayer(&u8g2, layer, background, sprite_list, sprite_cnt, dirty); }
+    void markLayerArea(u8g2_layer_t *layer, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h) { u8g2_MarkLayerArea(&u8g2, layer, x, y, w, h); }
+    void moveSprite(u8g2_layer_t *layer, u8g2_sprite_t *sprite, u8g2_uint_t x, u8g2_uint_t y) { u8g2_MoveSprite(&u8g2, layer, sprite, x, y); }
+    void showSprite(u8g2_layer_t *layer, u8g2_sprite_t *sprite, uint8_t is_visible) { u8g2_ShowSprite(&u8g2, layer, sprite, is_visible); }
+    void updateLayer(u8g2_layer_t *layer) { u8g2_UpdateLayer(&u8g2, layer); }
+
+#ifdef U8G2_WITH_PROFILE
+    /* u8g2_profile.c */
+    void setProfile(u8g2_profile_t *profile) { u8g2_SetProfile(&u8g2, profile); }
+#endif
+
+#ifdef U8X8_WITH_XFER
+    /* u8x8_xfer.c, call after begin() */
+    void setXfer(u8x8_xfer_t *xfer, u8x8_xfer_seg_t *seg_list, uint8_t seg_max, uint8_t *pool, uint16_t pool_size) { 
+      u8x8_SetXfer(u8g2_GetU8x8(&u8g2), xfer, seg_list, seg_max, pool, pool_size); }
+    void waitXfer(void) { u8x8_WaitXfer(u8g2_GetU8x8(&u8g2)); }
+#endif
+#ifdef U8X8_WITH_BUS
+    /* u8x8_bus.c, call after begin() */
+    void setBusClient(u8x8_bus_client_t *client) { u8x8_SetBusClient(u8g2_GetU8x8(&u8g2), client); }
+#endif
+#ifdef U8X8_WITH_EPD
+    /* u8x8_epd.c, SSD1606/SSD1607 only */
+    void setEpd(u8x8_epd_t *epd, uint8_t full_interval) { u8x8_SetEpd(u8g2_GetU8x8(&u8g2), epd, full_interval); }
+    void requestFullRefresh(void) { u8x8_RequestFullRefresh(u8g2_GetU8x8(&u8g2)); }
+#endif
+#ifdef U8X8_WITH_FANOUT
+    /* u8x8_fanout.c, call after the setup of the object */
+    void setFanout(u8x8_fanout_t *fanout, u8x8_fanout_target_t *target_list, uint8_t target_cnt, uint8_t *shadow) { 
+      u8x8_SetFanout(u8g2_GetU8x8(&u8g2), fanout, target_list, target_cnt, shadow); }
+    void attachFanoutTarget(uint8_t idx) { u8x8_AttachFanoutTarget(u8g2_GetU8x8(&u8g2), idx); }
+    void detachFanoutTarget(uint8_t idx) { u8x8_DetachFanoutTarget(u8g2_GetU8x8(&u8g2), idx); }
+    void updateFanoutTargets(void) { u8x8_UpdateFanoutTargets(u8g2_GetU8x8(&u8g2)); }
+#endif
+#ifdef U8X8_WITH_GOVERNOR
+    /* u8x8_governor.c, call after begin() */
+    void setGovernor(u8x8_governor_t *governor, uint32_t min_frame_ms, uint32_t dim_ms, uint32_t power_save_ms) { 
+      u8x8_SetGovernor(u8g2_GetU8x8(&u8g2), governor, min_frame_ms, dim_ms, power_save_ms, millis()); }
+    void setGovernorContrast(uint8_t contrast, uint8_t dim_contrast) { u8x8_SetGovernorContrast(u8g2_GetU8x8(&u8g2), contrast, dim_contrast); }
+    void requestRedraw(void) { u8x8_RequestRedraw(u8g2_GetU8x8(&u8g2)); }
+    void notifyActivity(void) { u8x8_NotifyActivity(u8g2_GetU8x8(&u8g2), millis()); }
+    void setPresence(uint8_t is_present) { u8x8_SetPresence(u8g2_GetU8x8(&u8g2), is_present, millis()); }
+    uint8_t pollGovernor(void) { return u8x8_PollGovernor(u8g2_GetU8x8(&u8g2), millis()); }
+#endif
+    uint8_t isRefreshBusy(void) { return u8x8_IsRefreshBusy(u8g2_GetU8x8(&u8g2)); }
+    void waitRefresh(void) { u8x8_WaitRefresh(u8g2_GetU8x8(&u8g2)); }
     
     void firstPage(void) { u8g2_FirstPage(&u8g2); }
     uint8_t nextPage(void) { return u8g2_NextPage(&u8g2); }
@@ -162,6 +220,8 @@ class U8G2 : public Print
     /* u8g2_hvline.c */
     void setDrawColor(uint8_t color_index) { u8g2_SetDrawColor(&u8g2, color_index); }
     uint8_t getDrawColor(void) { return u8g2_GetDrawColor(&u8g2); }
+    void setGrayLevel(uint8_t level) { u8g2_SetGrayLevel(&u8g2, level); }
+    uint8_t getGrayLevel(void) { return u8g2_GetGrayLevel(&u8g2); }
     void drawPixel(u8g2_uint_t x, u8g2_uint_t y) { u8g2_DrawPixel(&u8g2, x, y); }
     void drawHLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w) { u8g2_DrawHLine(&u8g2, x, y, w); }
     void drawVLine(u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t h) { u8g2_DrawVLine(&u8g2, x, y, h); }
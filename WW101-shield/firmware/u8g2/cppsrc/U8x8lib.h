@@ -230,6 +230,11 @@ class U8X8 : public Print
     /* U8X8_MSG_GPIO_MENU_NEXT, U8X8_MSG_GPIO_MENU_PREV, */
     /* U8X8_MSG_GPIO_MENU_HOME */
     uint8_t getMenuEvent(void) { return u8x8_GetMenuEvent(&u8x8); }
+    uint8_t waitMenuEvent(void) { return u8x8_WaitMenuEvent(&u8x8); }
+#ifdef U8X8_WITH_EVENT
+    /* u8x8_event.c */
+    void setEventQueue(u8x8_event_queue_t *queue) { u8x8_SetEventQueue(&u8x8, queue); }
+#endif
 
     uint8_t userInterfaceSelectionList(const char *title, uint8_t start_pos, const char *sl) {
       return u8x8_UserInterfaceSelectionList(&u8x8, title, start_pos, sl); }
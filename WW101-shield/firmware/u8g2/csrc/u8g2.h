@@ -71,6 +71,16 @@
 */
 //#define U8G2_16BIT
 
+/*
+  Optional for 16 Bit mode: Clipping and intersection are still calculated 
+  with 16 Bit, but the low level pixel procedures use 8 Bit positions within 
+  the tile buffer (u8g2_buf_uint_t), which is faster on 8 Bit controllers.
+  This limits the tile buffer to 256x256 pixel: Do not use this for displays
+  with more than 256 pixel in one direction (e.g. the 384x240 a2printer), 
+  the pixel outside of this area are clipped.
+*/
+//#define U8G2_8BIT_BUFFER
+
 
 /*
   The following macro enables a special check and optimization
@@ -136,6 +146,18 @@
 */
 //#define U8G2_WITH_HVLINE_COUNT
 
+/*
+  The following macro enables the profiler. If a profile has been assigned with
+  u8g2_SetProfile(), then u8g2 counts the draw procedures, the lines and pixel
+  which are written into the buffer, the decoded glyphs and the messages (and 
+  bytes) which are sent to the display, cad and byte procedures. If a cycle 
+  counter is available (get_cycles of the profile), the time is measured for
+  the clear, draw and send phase of each frame.
+  The profile changes the size of the u8g2 structure: All files must be 
+  compiled with the same setting.
+*/
+//#define U8G2_WITH_PROFILE
+
 /*
   Defining the following variable adds the clipping and check procedures agains the display boundaries.
   Clipping procedures are mandatory for the picture loop (u8g2_FirstPage/NextPage).
@@ -147,6 +169,49 @@
 */
 #define U8G2_WITH_CLIPPING
 
+/*
+  The following macro enables the display list for the picture loop (u8g2_FirstPage/NextPage).
+  If a display list has been assigned with u8g2_SetDisplayList(), then all lines, which are drawn 
+  during the first page, are recorded. The remaining pages are rendered from the recorded lines,
+  so that the user draw procedure is executed only once instead of once per page.
+  If the display list is too small, u8g2 falls back to the normal picture loop.
+  Requires U8G2_WITH_CLIPPING.
+*/
+//#define U8G2_WITH_DISPLAY_LIST
+
+/*
+  The following macro enables the frame difference mode. If a shadow buffer has been 
+  assigned with u8g2_SetShadowBuffer(), then u8g2 keeps a copy of the display memory.
+  u8g2_SendBuffer() and u8g2_NextPage() will only send those tiles, which have 
+  been changed. This mainly improves the speed of slow (I2C) displays.
+*/
+//#define U8G2_WITH_FRAME_DIFF
+
+/*
+  The following macro enables double buffering with an asynchronous transfer.
+  If a back buffer has been assigned with u8g2_SetBackBuffer(), then 
+  u8g2_SendBufferAsync() exchanges the back buffer and the tile buffer and returns 
+  immediately. The transfer is done in small parts by u8g2_SendBufferStep(), 
+  for example from a separate transfer task, so that other devices on the same 
+  bus can be accessed between the parts.
+*/
+//#define U8G2_WITH_DOUBLE_BUFFER
+
+/*
+  Each line is rotated by the draw_l90 procedure of the rotation (U8G2_R0..U8G2_R3,
+  U8G2_MIRROR) and written into the buffer by the ll_hvline procedure of the display.
+  Both procedures are called via function pointer for every line.
+  If the rotation and the display are known at compile time, the following
+  macros remove this overhead:
+  U8G2_FIXED_ROTATION: 0: U8G2_R0, 1: U8G2_R1, 2: U8G2_R2, 3: U8G2_R3, 4: U8G2_MIRROR
+    The rotation is inlined into u8g2_DrawHVLine().
+  U8G2_FIXED_LL_HVLINE: u8g2_ll_hvline_vertical_top_lsb or u8g2_ll_hvline_horizontal_right_lsb
+    This procedure is called directly.
+  Other rotations and buffer layouts still work, but will be a little bit slower.
+*/
+//#define U8G2_FIXED_ROTATION 0
+//#define U8G2_FIXED_LL_HVLINE u8g2_ll_hvline_vertical_top_lsb
+
 
 
 
@@ -155,8 +220,10 @@
 
 #ifdef __GNUC__
 #  define U8G2_NOINLINE __attribute__((noinline))
+#  define U8G2_ALWAYS_INLINE __inline__ __attribute__((always_inline))
 #else
 #  define U8G2_NOINLINE
+#  define U8G2_ALWAYS_INLINE
 #endif
 
 #define U8G2_FONT_SECTION(name) U8X8_FONT_SECTION(name) 
@@ -187,6 +254,13 @@ typedef int8_t u8g2_int_t;		/* introduced for circle calculation */
 typedef int16_t u8g2_long_t;		/* introduced for ellipse calculation */
 #endif
 
+/* position and length within the tile buffer, used by the low level hvline procedures */
+#if defined(U8G2_16BIT) && !defined(U8G2_8BIT_BUFFER)
+typedef uint16_t u8g2_buf_uint_t;
+#else
+typedef uint8_t u8g2_buf_uint_t;	/* a length of 256 is truncated to 0, see u8g2_ll_hvline.c */
+#endif
+
 
 typedef struct u8g2_struct u8g2_t;
 typedef struct u8g2_cb_struct u8g2_cb_t;
@@ -194,9 +268,151 @@ typedef struct u8g2_cb_struct u8g2_cb_t;
 typedef void (*u8g2_update_dimension_cb)(u8g2_t *u8g2);
 typedef void (*u8g2_draw_l90_cb)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
 typedef void (*u8g2_draw_ll_hvline_cb)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+typedef void (*u8g2_send_done_cb)(u8g2_t *u8g2);
 
 typedef uint8_t (*u8g2_get_kerning_cb)(u8g2_t *u8g2, uint16_t e1, uint16_t e2);
 
+/* polygon point and edge, see u8g2_polygon.c */
+struct _u8g2_pg_point_t
+{
+  int16_t x;
+  int16_t y;
+};
+typedef struct _u8g2_pg_point_t u8g2_pg_point_t;
+
+struct _u8g2_pg_edge_t
+{
+  int32_t x;		/* x position at the current scan line, 16.16 fixed point */
+  int32_t dx;		/* x increment per scan line, 16.16 fixed point */
+  int16_t y0;		/* first scan line of the edge */
+  int16_t y1;		/* last scan line of the edge (excluded) */
+  uint16_t next;		/* next edge in the active edge list */
+};
+typedef struct _u8g2_pg_edge_t u8g2_pg_edge_t;
+
+/* number of points for u8g2_AddPolygonXY(), u8g2_DrawPolygonList() is not limited by this value */
+#ifndef U8G2_PG_MAX_POINTS
+#define U8G2_PG_MAX_POINTS 6
+#endif
+
+/* horizontal or vertical line, already clipped against the user box, see u8g2_span.c */
+struct _u8g2_span_t
+{
+  u8g2_uint_t x;
+  u8g2_uint_t y;
+  u8g2_uint_t len;
+};
+typedef struct _u8g2_span_t u8g2_span_t;
+
+/* number of spans, which are collected before they are drawn */
+#ifndef U8G2_SPAN_BATCH_SIZE
+#define U8G2_SPAN_BATCH_SIZE 16
+#endif
+
+struct _u8g2_span_batch_t
+{
+  u8g2_span_t list[U8G2_SPAN_BATCH_SIZE];
+  uint8_t cnt;
+  uint8_t dir;		/* 0: horizontal, 1: vertical, same for all spans */
+};
+typedef struct _u8g2_span_batch_t u8g2_span_batch_t;
+
+/* one recorded hv line of the display list, see u8g2_display_list.c */
+struct _u8g2_dl_rec_t
+{
+  u8g2_uint_t x;
+  u8g2_uint_t y;
+  u8g2_uint_t len;
+  uint8_t flags;		/* bit 0..1: dir, bit 2..3: draw color, bit 4..7: gray level */
+};
+typedef struct _u8g2_dl_rec_t u8g2_dl_rec_t;
+
+/* sprite of a layer, see u8g2_sprite.c */
+struct _u8g2_sprite_t
+{
+  const uint8_t *bitmap;	/* XBM format, same as for u8g2_DrawXBM() */
+  u8g2_uint_t w;
+  u8g2_uint_t h;
+  u8g2_uint_t x;		/* position, use u8g2_MoveSprite() to change it */
+  u8g2_uint_t y;
+  uint8_t is_visible;
+  uint8_t is_transparent;	/* 0: draw all pixel, 1: pixel with value 0 are not drawn */
+};
+typedef struct _u8g2_sprite_t u8g2_sprite_t;
+
+/* background and sprites, which are composed into the u8g2 buffer */
+struct _u8g2_layer_t
+{
+  const uint8_t *background;	/* full size buffer with the layout of the u8g2 buffer or NULL */
+  u8g2_sprite_t *sprite_list;	/* the last sprite is on top */
+  uint8_t *dirty;			/* one bit per tile, see U8G2_LAYER_DIRTY_SIZE() */
+  uint16_t sent_tiles;		/* number of tiles sent by the last u8g2_UpdateLayer() */
+  uint8_t sprite_cnt;
+};
+typedef struct _u8g2_layer_t u8g2_layer_t;
+
+/* number of bytes for the dirty tile memory of a layer */
+#define U8G2_LAYER_DIRTY_SIZE(tile_width, tile_height) (((tile_width)*(tile_height)+7)/8)
+
+/* profiler, see u8g2_profile.c */
+#define U8G2_PROFILE_PRIM_LINE 0
+#define U8G2_PROFILE_PRIM_BOX 1		/* DrawBox, DrawRBox */
+#define U8G2_PROFILE_PRIM_FRAME 2		/* DrawFrame, DrawRFrame */
+#define U8G2_PROFILE_PRIM_CIRCLE 3		/* DrawCircle, DrawDisc */
+#define U8G2_PROFILE_PRIM_ELLIPSE 4		/* DrawEllipse, DrawFilledEllipse */
+#define U8G2_PROFILE_PRIM_POLYGON 5		/* DrawPolygon, DrawTriangle */
+#define U8G2_PROFILE_PRIM_BITMAP 6		/* DrawBitmap, DrawXBM, DrawXBMP */
+#define U8G2_PROFILE_PRIM_GLYPH 7		/* DrawGlyph, also for each char of a string */
+#define U8G2_PROFILE_PRIM_CNT 8
+
+#define U8G2_PROFILE_PHASE_DRAW 0		/* everything outside of the other phases (user code) */
+#define U8G2_PROFILE_PHASE_CLEAR 1	/* u8g2_ClearBuffer() */
+#define U8G2_PROFILE_PHASE_SEND 2		/* u8g2_SendBuffer(), u8g2_NextPage() */
+#define U8G2_PROFILE_PHASE_CNT 3
+
+#define U8G2_PROFILE_LAYER_DISPLAY 0
+#define U8G2_PROFILE_LAYER_CAD 1
+#define U8G2_PROFILE_LAYER_BYTE 2
+#define U8G2_PROFILE_MSG_CNT 35		/* messages with a higher number are not counted */
+
+struct _u8g2_profile_msg_t
+{
+  uint32_t cnt;				/* number of calls */
+  uint32_t bytes;			/* tile bytes (display), command and data bytes (cad, byte) */
+};
+typedef struct _u8g2_profile_msg_t u8g2_profile_msg_t;
+
+/* counters of one frame, cleared after the frame callback */
+struct _u8g2_profile_counter_t
+{
+  uint32_t prim_cnt[U8G2_PROFILE_PRIM_CNT];	/* calls from other draw procedures are included (e.g. DrawRBox draws discs) */
+  uint32_t span_cnt;			/* lines, which are written into the buffer (ll_hvline) */
+  uint32_t span_reject_cnt;		/* lines, which are removed by intersection test or clipping */
+  uint32_t pixel_cnt;			/* sum of the length of all written lines */
+  uint32_t glyph_cnt;			/* decoded glyphs */
+  uint32_t cycles[U8G2_PROFILE_PHASE_CNT];
+  u8g2_profile_msg_t msg_list[3][U8G2_PROFILE_MSG_CNT];	/* index: U8G2_PROFILE_LAYER_xxx, U8X8_MSG_xxx */
+};
+typedef struct _u8g2_profile_counter_t u8g2_profile_counter_t;
+
+typedef struct _u8g2_profile_t u8g2_profile_t;
+typedef uint32_t (*u8g2_profile_cycles_cb)(void);
+typedef void (*u8g2_profile_frame_cb)(u8g2_t *u8g2, u8g2_profile_t *profile);
+
+struct _u8g2_profile_t
+{
+  u8g2_profile_counter_t counter;
+  uint32_t frame_cnt;			/* number of completed frames */
+  u8g2_profile_cycles_cb get_cycles;	/* free running counter (any unit) or NULL */
+  u8g2_profile_frame_cb frame_cb;	/* called after the last page of a frame has been sent, or NULL */
+  /* internal */
+  uint32_t last_cycles;
+  uint8_t phase;
+  u8x8_msg_cb display_cb;		/* callbacks of the u8x8 structure, replaced by the profiler */
+  u8x8_msg_cb cad_cb;
+  u8x8_msg_cb byte_cb;
+};
+
 
 /* from ucglib... */
 struct _u8g2_font_info_t
@@ -334,18 +550,72 @@ struct u8g2_struct
 
   uint8_t draw_color;		/* 0: clear pixel, 1: set pixel, modified and restored by font procedures */
 					/* draw_color can be used also directly by the user API */
+  uint8_t gray_level;		/* 0..15: pixel value for draw_color 1 (and XOR value for draw_color 2) */
+					/* only used by u8g2_ll_hvline_horizontal_gray4 */
 					
   uint8_t is_auto_page_clear; 		/* set to 0 to disable automatic page clear in firstPage() and nextPage() */
   
 #ifdef U8G2_WITH_HVLINE_COUNT
   unsigned long hv_cnt;
 #endif /* U8G2_WITH_HVLINE_COUNT */   
+
+#ifdef U8G2_WITH_PROFILE
+  u8g2_profile_t *profile;		/* NULL if not used */
+#endif /* U8G2_WITH_PROFILE */
+
+#ifdef U8G2_WITH_FRAME_DIFF
+  uint8_t *shadow_buf_ptr;		/* copy of the display memory: tile_width*tile_height*8 bytes, NULL if not used */
+  uint8_t is_shadow_valid;		/* 0: shadow_buf_ptr does not yet reflect the display content */
+  uint8_t diff_max_gap;			/* number of unchanged tiles, which are sent to avoid a new address window */
+  uint16_t diff_sent_bytes;		/* tile bytes sent during the last frame */
+  uint16_t diff_saved_bytes;		/* tile bytes not sent during the last frame */
+#endif /* U8G2_WITH_FRAME_DIFF */
+
+#ifdef U8G2_WITH_DOUBLE_BUFFER
+  uint8_t *back_buf_ptr;		/* second tile buffer, NULL if not used */
+  uint8_t *send_buf_ptr;		/* buffer, which is transfered to the display, NULL if no transfer is active */
+  u8g2_send_done_cb send_done_cb;	/* called after the last part has been sent, can be NULL */
+  uint16_t send_pos;			/* next tile of send_buf_ptr */
+  uint16_t send_tile_cnt;		/* number of tiles in send_buf_ptr */
+  uint8_t send_tile_row;		/* destination tile row of the first tile */
+  uint8_t send_chunk;			/* max number of tiles for one u8g2_SendBufferStep() */
+#endif /* U8G2_WITH_DOUBLE_BUFFER */
+
+#ifdef U8G2_WITH_DISPLAY_LIST
+  u8g2_dl_rec_t *dl_list;		/* memory for the display list, NULL if not used */
+  uint16_t dl_max;			/* number of records in dl_list */
+  uint16_t dl_cnt;			/* number of records used in the current frame */
+  uint8_t dl_state;			/* one of U8G2_DL_STATE_xxx */
+#endif /* U8G2_WITH_DISPLAY_LIST */
 };
 
 #define u8g2_GetU8x8(u8g2) ((u8x8_t *)(u8g2))
 
 #define u8g2_SetAutoPageClear(u8g2, mode) ((u8g2)->is_auto_page_clear = (mode))
 
+#ifdef U8G2_WITH_HVLINE_COUNT
+#define u8g2_GetHVLineCount(u8g2) ((u8g2)->hv_cnt)
+#define u8g2_ClearHVLineCount(u8g2) ((u8g2)->hv_cnt = 0)
+#endif /* U8G2_WITH_HVLINE_COUNT */
+
+/* internal: counting of the profiler, does nothing if no profile is assigned */
+#ifdef U8G2_WITH_PROFILE
+#define U8G2_PROFILE_ADD(u8g2, member, n) \
+  do { if ( (u8g2)->profile != NULL ) (u8g2)->profile->counter.member += (n); } while(0)
+#define U8G2_PROFILE_PHASE(u8g2, p) \
+  do { if ( (u8g2)->profile != NULL ) u8g2_profile_phase((u8g2), (p)); } while(0)
+#define U8G2_PROFILE_END_FRAME(u8g2) \
+  do { if ( (u8g2)->profile != NULL ) u8g2_profile_end_frame(u8g2); } while(0)
+#define U8G2_PROFILE_SPAN(u8g2, len) \
+  ((u8g2)->profile != NULL ? \
+    ((u8g2)->profile->counter.span_cnt++, (u8g2)->profile->counter.pixel_cnt += (len)) : 0)
+#else
+#define U8G2_PROFILE_ADD(u8g2, member, n) do { } while(0)
+#define U8G2_PROFILE_PHASE(u8g2, p) do { } while(0)
+#define U8G2_PROFILE_END_FRAME(u8g2) do { } while(0)
+#endif /* U8G2_WITH_PROFILE */
+#define U8G2_PROFILE_PRIM(u8g2, prim) U8G2_PROFILE_ADD(u8g2, prim_cnt[prim], 1)
+
 /*==========================================*/
 /* u8x8 wrapper */
 
@@ -362,9 +632,16 @@ void u8g2_ClearDisplay(u8g2_t *u8g2);
 #define u8g2_GetDisplayHeight(u8g2) ((u8g2)->height)
 #define u8g2_GetDisplayWidth(u8g2) ((u8g2)->width)
 #define u8g2_GetDrawColor(u8g2) ((u8g2)->draw_color)
+/* gray level for draw color 1, only used by the 4 bit gray buffer (u8g2_Setup_..._gray_x), default is 15 */
+#define u8g2_SetGrayLevel(u8g2, level) ((u8g2)->gray_level = (level) & 15)
+#define u8g2_GetGrayLevel(u8g2) ((u8g2)->gray_level)
 
 #define u8g2_SetI2CAddress(u8g2, address) ((u8g2_GetU8x8(u8g2))->i2c_address = (address))
 #define u8g2_GetI2CAddress(u8g2)   u8x8_GetI2CAddress(u8g2_GetU8x8(u8g2))
+#ifdef U8X8_WITH_USER_PTR
+#define u8g2_GetUserPtr(u8g2) u8x8_GetUserPtr(u8g2_GetU8x8(u8g2))
+#define u8g2_SetUserPtr(u8g2, p) u8x8_SetUserPtr(u8g2_GetU8x8(u8g2), (p))
+#endif
 
 #ifdef U8X8_USE_PINS 
 #define u8g2_SetMenuSelectPin(u8g2, val) u8x8_SetMenuSelectPin(u8g2_GetU8x8(u8g2), (val)) 
@@ -396,6 +673,7 @@ extern const u8g2_cb_t u8g2_cb_mirror;
   ll_hvline_cb:		one of:
     u8g2_ll_hvline_vertical_top_lsb
     u8g2_ll_hvline_horizontal_right_lsb
+    u8g2_ll_hvline_horizontal_gray4	(buf requires 4x the memory)
   u8g2_cb			U8G2_R0 .. U8G2_R3
       
 */
@@ -740,6 +1018,35 @@ void u8g2_Setup_a2printer_384x240_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x
 
 /* u8g2_d_setup.c generated code end */
 
+/*==========================================*/
+/* u8g2_d_gray.c */
+
+/* setup procedures for the 4 bit gray buffer (u8g2_ll_hvline_horizontal_gray4) */
+uint8_t *u8g2_m_ssd1322_32_gray_1(uint8_t *page_cnt);
+uint8_t *u8g2_m_ssd1322_32_gray_2(uint8_t *page_cnt);
+uint8_t *u8g2_m_ssd1322_32_gray_f(uint8_t *page_cnt);
+uint8_t *u8g2_m_ssd1325_16_gray_1(uint8_t *page_cnt);
+uint8_t *u8g2_m_ssd1325_16_gray_2(uint8_t *page_cnt);
+uint8_t *u8g2_m_ssd1325_16_gray_f(uint8_t *page_cnt);
+uint8_t *u8g2_m_ssd1327_12_gray_1(uint8_t *page_cnt);
+uint8_t *u8g2_m_ssd1327_12_gray_2(uint8_t *page_cnt);
+uint8_t *u8g2_m_ssd1327_12_gray_f(uint8_t *page_cnt);
+void u8g2_Setup_ssd1322_nhd_256x64_gray_1(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1322_nhd_256x64_gray_2(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1322_nhd_256x64_gray_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1325_nhd_128x64_gray_1(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1325_nhd_128x64_gray_2(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1325_nhd_128x64_gray_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1325_i2c_nhd_128x64_gray_1(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1325_i2c_nhd_128x64_gray_2(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1325_i2c_nhd_128x64_gray_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1327_seeed_96x96_gray_1(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1327_seeed_96x96_gray_2(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1327_seeed_96x96_gray_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1327_i2c_seeed_96x96_gray_1(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1327_i2c_seeed_96x96_gray_2(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+void u8g2_Setup_ssd1327_i2c_seeed_96x96_gray_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb);
+
 /*==========================================*/
 /* u8g2_buffer.c */
 
@@ -753,9 +1060,36 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2);
 #define u8g2_GetBufferPtr(u8g2) ((u8g2)->tile_buf_ptr)
 #define u8g2_GetBufferTileHeight(u8g2)	((u8g2)->tile_buf_height)
 #define u8g2_GetBufferTileWidth(u8g2)	(u8g2_GetU8x8(u8g2)->display_info->tile_width)
+/* number of bytes for one tile (8x8 pixel) in the buffer: 8 (1 bit per pixel) or 32 (4 bit gray) */
+#define u8g2_GetBufferTileSize(u8g2)	((u8g2)->ll_hvline == u8g2_ll_hvline_horizontal_gray4 ? 32 : 8)
 /* the following variable is only valid after calling u8g2_FirstPage */
 #define u8g2_GetPageCurrTileRow(u8g2) ((u8g2)->tile_curr_row)
 
+#ifdef U8G2_WITH_FRAME_DIFF
+/* buf must have u8g2_GetBufferTileWidth(u8g2)*u8g2_GetBufferTileSize(u8g2)*<tile_height of the display> bytes, NULL disables frame diff */
+void u8g2_SetShadowBuffer(u8g2_t *u8g2, uint8_t *buf);
+/* force transfer of all tiles with the next frame, e.g. after u8x8_ClearDisplay() */
+#define u8g2_InvalidateShadowBuffer(u8g2) ((u8g2)->is_shadow_valid = 0)
+/* number of unchanged tiles between two changed tiles, which are sent to avoid a new address window, default is 1 */
+#define u8g2_SetFrameDiffMaxGap(u8g2, gap) ((u8g2)->diff_max_gap = (gap))
+/* statistics for the last frame */
+#define u8g2_GetFrameDiffSentBytes(u8g2) ((u8g2)->diff_sent_bytes)
+#define u8g2_GetFrameDiffSavedBytes(u8g2) ((u8g2)->diff_saved_bytes)
+#endif /* U8G2_WITH_FRAME_DIFF */
+
+#ifdef U8G2_WITH_DOUBLE_BUFFER
+/* buf must have the same size as the tile buffer, NULL disables double buffering */
+void u8g2_SetBackBuffer(u8g2_t *u8g2, uint8_t *buf);
+/* returns 0 if the previous transfer is still active, done_cb can be NULL */
+uint8_t u8g2_SendBufferAsync(u8g2_t *u8g2, u8g2_send_done_cb done_cb);
+/* send the next part, returns 0 if the transfer is finished */
+uint8_t u8g2_SendBufferStep(u8g2_t *u8g2);
+void u8g2_FinishSendBuffer(u8g2_t *u8g2);
+#define u8g2_IsSendBusy(u8g2) ((u8g2)->send_buf_ptr != NULL)
+/* number of tiles (8 bytes) for one u8g2_SendBufferStep(), default is one tile row */
+#define u8g2_SetSendChunkSize(u8g2, tiles) ((u8g2)->send_chunk = (tiles))
+#endif /* U8G2_WITH_DOUBLE_BUFFER */
+
 /*==========================================*/
 /* u8g2_ll_hvline.c */
 /*
@@ -769,8 +1103,26 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2);
 
 /* SSD13xx, UC17xx, UC16xx */
 void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
-/* ST7920 */
+/* ST7920, LS013B7DH03, T6963 */
 void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+/* SSD1322, SSD1325, SSD1327: 4 bit per pixel, see U8X8_MSG_DISPLAY_DRAW_GRAY_TILE */
+void u8g2_ll_hvline_horizontal_gray4(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+
+/* call the ll_hvline procedure of the display, see U8G2_FIXED_LL_HVLINE */
+#ifdef U8G2_FIXED_LL_HVLINE
+#define u8g2_call_ll_hvline_cb(u8g2, x, y, len, dir) \
+  ((u8g2)->ll_hvline == U8G2_FIXED_LL_HVLINE ? \
+    U8G2_FIXED_LL_HVLINE((u8g2), (x), (y), (len), (dir)) : \
+    (u8g2)->ll_hvline((u8g2), (x), (y), (len), (dir)))
+#else
+#define u8g2_call_ll_hvline_cb(u8g2, x, y, len, dir) ((u8g2)->ll_hvline((u8g2), (x), (y), (len), (dir)))
+#endif
+#ifdef U8G2_WITH_PROFILE
+#define u8g2_call_ll_hvline(u8g2, x, y, len, dir) \
+  (U8G2_PROFILE_SPAN((u8g2), (len)), u8g2_call_ll_hvline_cb((u8g2), (x), (y), (len), (dir)))
+#else
+#define u8g2_call_ll_hvline(u8g2, x, y, len, dir) u8g2_call_ll_hvline_cb((u8g2), (x), (y), (len), (dir))
+#endif
 
 
 /*==========================================*/
@@ -802,6 +1154,44 @@ uint8_t u8g2_IsIntersection(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_u
 
 
 
+/*==========================================*/
+/* u8g2_buffer_ops.c */
+/* whole buffer operations, the rotation is not applied, src and mask have the size of the full display */
+void u8g2_InvertBuffer(u8g2_t *u8g2);
+void u8g2_XorBuffer(u8g2_t *u8g2, const uint8_t *src);
+void u8g2_CopyBufferMasked(u8g2_t *u8g2, const uint8_t *src, const uint8_t *mask);
+void u8g2_FillBufferRegion(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+
+/*==========================================*/
+/* u8g2_sprite.c */
+/* layer with background and sprites, only changed tiles are composed and sent, use U8G2_R0 */
+void u8g2_InitLayer(u8g2_t *u8g2, u8g2_layer_t *layer, const uint8_t *background, u8g2_sprite_t *sprite_list, uint8_t sprite_cnt, uint8_t *dirty);
+void u8g2_SetSprite(u8g2_sprite_t *sprite, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap);
+void u8g2_MarkLayerArea(u8g2_t *u8g2, u8g2_layer_t *layer, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h);
+void u8g2_MoveSprite(u8g2_t *u8g2, u8g2_layer_t *layer, u8g2_sprite_t *sprite, u8g2_uint_t x, u8g2_uint_t y);
+void u8g2_ShowSprite(u8g2_t *u8g2, u8g2_layer_t *layer, u8g2_sprite_t *sprite, uint8_t is_visible);
+void u8g2_UpdateLayer(u8g2_t *u8g2, u8g2_layer_t *layer);
+#define u8g2_GetLayerSentTiles(layer) ((layer)->sent_tiles)
+
+/*==========================================*/
+/* u8g2_profile.c */
+#ifdef U8G2_WITH_PROFILE
+/* call after the setup of the display and the buffer, the profile is cleared, NULL disables the profiler */
+void u8g2_SetProfile(u8g2_t *u8g2, u8g2_profile_t *profile);
+void u8g2_ClearProfile(u8g2_profile_t *profile);
+/* print the counters of the current frame to stdout */
+void u8g2_PrintProfile(u8g2_profile_t *profile);
+void u8g2_profile_phase(u8g2_t *u8g2, uint8_t phase);	/* internal, use U8G2_PROFILE_PHASE */
+void u8g2_profile_end_frame(u8g2_t *u8g2);		/* internal, use U8G2_PROFILE_END_FRAME */
+#endif /* U8G2_WITH_PROFILE */
+
+/*==========================================*/
+/* u8g2_span.c */
+void u8g2_InitSpanBatch(u8g2_t *u8g2, u8g2_span_batch_t *batch, uint8_t dir);
+void u8g2_AddSpan(u8g2_t *u8g2, u8g2_span_batch_t *batch, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len);
+void u8g2_FlushSpanBatch(u8g2_t *u8g2, u8g2_span_batch_t *batch);
+
+
 /*==========================================*/
 /* u8g2_circle.c */
 #define U8G2_DRAW_UPPER_RIGHT 0x01
@@ -829,13 +1219,38 @@ void u8g2_DrawRFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w,
 
 /*==========================================*/
 /* u8g2_polygon.c */
+/* edges: memory for cnt edges, the polygon is filled with the even-odd rule */
+void u8g2_DrawPolygonList(u8g2_t *u8g2, const u8g2_pg_point_t *list, uint16_t cnt, u8g2_pg_edge_t *edges);
+/* the points of u8g2_AddPolygonXY() are stored in one global list, shared by all displays */
 void u8g2_ClearPolygonXY(void);
 void u8g2_AddPolygonXY(u8g2_t *u8g2, int16_t x, int16_t y);
+/* convex polygons only, same pixel output as before u8g2_DrawPolygonList() */
 void u8g2_DrawPolygon(u8g2_t *u8g2);
 void u8g2_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
 
 
 
+/*==========================================*/
+/* u8g2_display_list.c */
+#ifdef U8G2_WITH_DISPLAY_LIST
+
+#define U8G2_DL_STATE_IDLE 0
+#define U8G2_DL_STATE_RECORD 1
+#define U8G2_DL_STATE_REPLAY 2
+
+/* list: memory for cnt records, use NULL to disable the display list */
+void u8g2_SetDisplayList(u8g2_t *u8g2, u8g2_dl_rec_t *list, uint16_t cnt);
+/* number of records, which had been used by the last frame */
+#define u8g2_GetDisplayListCnt(u8g2) ((u8g2)->dl_cnt)
+
+/* internal procedures, called by u8g2_buffer.c and u8g2_hvline.c */
+void u8g2_dl_start(u8g2_t *u8g2);
+void u8g2_dl_add(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+void u8g2_dl_replay(u8g2_t *u8g2);
+
+#endif /* U8G2_WITH_DISPLAY_LIST */
+
+
 /*==========================================*/
 /* u8g2_kerning.c */
 //uint8_t u8g2_GetNullKerning(u8g2_t *u8g2, uint16_t e1, uint16_t e2);
@@ -73,6 +73,7 @@ void u8g2_DrawBitmap(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t cnt
   u8g2_uint_t w;
   w = cnt;
   w *= 8;
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_BITMAP);
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
@@ -126,6 +127,7 @@ void u8g2_DrawXBM(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g
   blen = w;
   blen += 7;
   blen >>= 3;
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_BITMAP);
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
@@ -182,6 +184,7 @@ void u8g2_DrawXBMP(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
   blen = w;
   blen += 7;
   blen >>= 3;
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_BITMAP);
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
@@ -41,6 +41,7 @@
 */
 void u8g2_DrawBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
 {
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_BOX);
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
@@ -64,6 +65,7 @@ void u8g2_DrawFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u
 {
   u8g2_uint_t xtmp = x;
   
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_FRAME);
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
@@ -87,6 +89,7 @@ void u8g2_DrawRBox(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8
   u8g2_uint_t xl, yu;
   u8g2_uint_t yl, xr;
 
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_BOX);
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
@@ -145,6 +148,7 @@ void u8g2_DrawRFrame(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w,
 {
   u8g2_uint_t xl, yu;
 
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_FRAME);
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+w, y+h) == 0 ) 
     return;
@@ -40,14 +40,123 @@
 void u8g2_ClearBuffer(u8g2_t *u8g2)
 {
   size_t cnt;
+  U8G2_PROFILE_PHASE(u8g2, U8G2_PROFILE_PHASE_CLEAR);
   cnt = u8g2_GetU8x8(u8g2)->display_info->tile_width;
   cnt *= u8g2->tile_buf_height;
-  cnt *= 8;
+  cnt *= u8g2_GetBufferTileSize(u8g2);
   memset(u8g2->tile_buf_ptr, 0, cnt);
+  U8G2_PROFILE_PHASE(u8g2, U8G2_PROFILE_PHASE_DRAW);
+}
+
+/* the 4 bit gray buffer is sent without conversion, see U8X8_MSG_DISPLAY_DRAW_GRAY_TILE */
+static void u8g2_draw_tile(u8g2_t *u8g2, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *ptr)
+{
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_gray4 )
+    u8x8_DrawGrayTile(u8g2_GetU8x8(u8g2), x, y, cnt, ptr);
+  else
+    u8x8_DrawTile(u8g2_GetU8x8(u8g2), x, y, cnt, ptr);
 }
 
 /*============================================*/
 
+#ifdef U8G2_WITH_FRAME_DIFF
+
+void u8g2_SetShadowBuffer(u8g2_t *u8g2, uint8_t *buf)
+{
+  u8g2->shadow_buf_ptr = buf;
+  u8g2->is_shadow_valid = 0;
+  u8g2->diff_max_gap = 1;
+  u8g2->diff_sent_bytes = 0;
+  u8g2->diff_saved_bytes = 0;
+}
+
+static uint8_t u8g2_is_tile_changed(u8g2_t *u8g2, uint8_t *ptr, uint8_t *shadow)
+{
+  if ( u8g2->is_shadow_valid == 0 )
+    return 1;
+  if ( memcmp(ptr, shadow, 8) != 0 )
+    return 1;
+  return 0;
+}
+
+/*
+  Compare one tile row with the shadow buffer and send the changed tiles only.
+  Changed tiles, which are separated by not more than diff_max_gap unchanged tiles,
+  are sent with one DRAW_TILE message, because each message will 
+  also transfer the address window to the display.
+  
+  With u8g2_ll_hvline_horizontal_right_lsb and u8g2_ll_hvline_horizontal_gray4, 
+  a tile is not a continuous memory area, so only the complete row can be sent.
+*/
+static void u8g2_send_tile_row_diff(u8g2_t *u8g2, uint8_t *ptr, uint8_t dest_tile_row, uint8_t w)
+{
+  uint8_t *shadow;
+  uint16_t offset;
+  uint16_t row_size;
+  uint8_t x, x0, x1, gap;
+  
+  row_size = w;
+  row_size *= u8g2_GetBufferTileSize(u8g2);
+  offset = dest_tile_row;
+  offset *= row_size;
+  shadow = u8g2->shadow_buf_ptr + offset;
+  
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+  {
+    if ( u8g2->is_shadow_valid == 0 || memcmp(ptr, shadow, row_size) != 0 )
+    {
+      memcpy(shadow, ptr, row_size);
+      u8g2_draw_tile(u8g2, 0, dest_tile_row, w, ptr);
+      u8g2->diff_sent_bytes += row_size;
+    }
+    else
+    {
+      u8g2->diff_saved_bytes += row_size;
+    }
+    return;
+  }
+  
+  x = 0;
+  while( x < w )
+  {
+    if ( u8g2_is_tile_changed(u8g2, ptr+x*8, shadow+x*8) == 0 )
+    {
+      u8g2->diff_saved_bytes += 8;
+      x++;
+      continue;
+    }
+    
+    /* x0 is the first changed tile, find x1 (excluded) */
+    x0 = x;
+    x++;
+    x1 = x;
+    gap = 0;
+    while( x < w )
+    {
+      if ( u8g2_is_tile_changed(u8g2, ptr+x*8, shadow+x*8) != 0 )
+      {
+	x++;
+	x1 = x;
+	gap = 0;
+      }
+      else
+      {
+	gap++;
+	if ( gap > u8g2->diff_max_gap )
+	  break;
+	x++;
+      }
+    }
+    
+    memcpy(shadow+x0*8, ptr+x0*8, (size_t)(x1-x0)*8);
+    u8x8_DrawTile(u8g2_GetU8x8(u8g2), x0, dest_tile_row, x1-x0, ptr+x0*8);
+    u8g2->diff_sent_bytes += (uint16_t)(x1-x0)*8;
+    x = x1;
+  }
+}
+
+#endif /* U8G2_WITH_FRAME_DIFF */
+
 static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_tile_row)
 {
   uint8_t *ptr;
@@ -58,9 +167,33 @@ static void u8g2_send_tile_row(u8g2_t *u8g2, uint8_t src_tile_row, uint8_t dest_
   offset = src_tile_row;
   ptr = u8g2->tile_buf_ptr;
   offset *= w;
-  offset *= 8;
+  offset *= u8g2_GetBufferTileSize(u8g2);
   ptr += offset;
-  u8x8_DrawTile(u8g2_GetU8x8(u8g2), 0, dest_tile_row, w, ptr);
+#ifdef U8G2_WITH_FRAME_DIFF
+  if ( u8g2->shadow_buf_ptr != NULL )
+  {
+    u8g2_send_tile_row_diff(u8g2, ptr, dest_tile_row, w);
+    return;
+  }
+#endif /* U8G2_WITH_FRAME_DIFF */
+  u8g2_draw_tile(u8g2, 0, dest_tile_row, w, ptr);
+}
+
+/*
+  Send all rows of the tile buffer with one U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK
+  message. Only the vertical byte order has the tile layout of DRAW_TILE.
+  For one row, DRAW_TILE is shorter (three commands instead of two windows).
+  Returns 0 if the display does not support tile blocks.
+*/
+static uint8_t u8g2_send_tile_block(u8g2_t *u8g2, uint8_t dest_row, uint8_t rows)
+{
+  if ( rows < 2 || u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+    return 0;
+#ifdef U8G2_WITH_FRAME_DIFF
+  if ( u8g2->shadow_buf_ptr != NULL )
+    return 0;
+#endif
+  return u8x8_DrawTileBlock(u8g2_GetU8x8(u8g2), 0, dest_row, u8g2_GetU8x8(u8g2)->display_info->tile_width, rows, u8g2->tile_buf_ptr);
 }
 
 /* 
@@ -81,21 +214,156 @@ static void u8g2_send_buffer(u8g2_t *u8g2)
   dest_row = u8g2->tile_curr_row;
   dest_max = u8g2_GetU8x8(u8g2)->display_info->tile_height;
   
-  do
+#ifdef U8X8_WITH_XFER
+  /* with u8x8_SetXfer(), the page is sent while the next page is rendered */
+  u8x8_BeginXfer(u8g2_GetU8x8(u8g2));
+#endif
+  if ( u8g2_send_tile_block(u8g2, dest_row, src_max < dest_max-dest_row ? src_max : dest_max-dest_row) == 0 )
   {
-    u8g2_send_tile_row(u8g2, src_row, dest_row);
-    src_row++;
-    dest_row++;
-  } while( src_row < src_max && dest_row < dest_max );
+    do
+    {
+      u8g2_send_tile_row(u8g2, src_row, dest_row);
+      src_row++;
+      dest_row++;
+    } while( src_row < src_max && dest_row < dest_max );
+  }
+#ifdef U8X8_WITH_XFER
+  u8x8_EndXfer(u8g2_GetU8x8(u8g2), NULL);
+#endif
 }
 
 /* same as u8g2_send_buffer but also send the DISPLAY_REFRESH message (used by SSD1606) */
 void u8g2_SendBuffer(u8g2_t *u8g2)
 {
+  U8G2_PROFILE_PHASE(u8g2, U8G2_PROFILE_PHASE_SEND);
+#ifdef U8G2_WITH_FRAME_DIFF
+  u8g2->diff_sent_bytes = 0;
+  u8g2->diff_saved_bytes = 0;
+#endif
   u8g2_send_buffer(u8g2);
+#ifdef U8G2_WITH_FRAME_DIFF
+  if ( u8g2->tile_buf_height >= u8g2_GetU8x8(u8g2)->display_info->tile_height )
+    u8g2->is_shadow_valid = 1;
+#endif
   u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );  
+  U8G2_PROFILE_END_FRAME(u8g2);
 }
 
+/*============================================*/
+
+#ifdef U8G2_WITH_DOUBLE_BUFFER
+
+/*
+  Double buffering:
+  u8g2_SendBufferAsync() moves the content of the tile buffer to the transfer 
+  and continues with the back buffer as new tile buffer. The new tile buffer
+  still contains the frame before the previous frame, so usually 
+  u8g2_ClearBuffer() is called before drawing the next frame.
+  
+  u8g2_SendBufferStep() sends up to send_chunk tiles. It must be called 
+  until it returns 0, for example from a transfer task:
+
+    for(;;)
+    {
+      wait until u8g2_IsSendBusy()
+      lock bus
+      u8g2_SendBufferStep(u8g2);
+      unlock bus
+    }
+    
+  The done_cb is called from u8g2_SendBufferStep() after the last part 
+  (e.g. to set a semaphore). The frame diff mode is not used for the 
+  asynchronous transfer. Instead the shadow buffer is invalidated, so that
+  the next u8g2_SendBuffer() sends the complete frame again.
+*/
+
+void u8g2_SetBackBuffer(u8g2_t *u8g2, uint8_t *buf)
+{
+  u8g2->back_buf_ptr = buf;
+  u8g2->send_buf_ptr = NULL;
+  u8g2->send_done_cb = NULL;
+  u8g2->send_chunk = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+}
+
+uint8_t u8g2_SendBufferAsync(u8g2_t *u8g2, u8g2_send_done_cb done_cb)
+{
+  uint8_t rows;
+  
+  if ( u8g2->send_buf_ptr != NULL )
+    return 0;
+  
+  if ( u8g2->back_buf_ptr == NULL )
+  {
+    /* no back buffer: synchronous transfer */
+    u8g2_SendBuffer(u8g2);
+    if ( done_cb != NULL )
+      done_cb(u8g2);
+    return 1;
+  }
+  
+  rows = u8g2->tile_buf_height;
+  if ( rows + u8g2->tile_curr_row > u8g2_GetU8x8(u8g2)->display_info->tile_height )
+    rows = u8g2_GetU8x8(u8g2)->display_info->tile_height - u8g2->tile_curr_row;
+  
+  u8g2->send_tile_cnt = rows;
+  u8g2->send_tile_cnt *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  u8g2->send_tile_row = u8g2->tile_curr_row;
+  u8g2->send_pos = 0;
+  u8g2->send_done_cb = done_cb;
+#ifdef U8G2_WITH_FRAME_DIFF
+  u8g2->is_shadow_valid = 0;
+#endif
+  
+  /* exchange the buffers */
+  u8g2->send_buf_ptr = u8g2->tile_buf_ptr;
+  u8g2->tile_buf_ptr = u8g2->back_buf_ptr;
+  u8g2->back_buf_ptr = u8g2->send_buf_ptr;
+  return 1;
+}
+
+uint8_t u8g2_SendBufferStep(u8g2_t *u8g2)
+{
+  u8g2_send_done_cb done_cb;
+  uint8_t w, x, y, cnt;
+  
+  if ( u8g2->send_buf_ptr == NULL )
+    return 0;
+  
+  w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  x = u8g2->send_pos % w;
+  y = u8g2->send_pos / w;
+  
+  /* parts never cross a tile row */
+  cnt = w - x;
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+  {
+    if ( u8g2->send_chunk != 0 && cnt > u8g2->send_chunk )
+      cnt = u8g2->send_chunk;
+  }
+  
+  u8g2_draw_tile(u8g2, x, u8g2->send_tile_row + y, cnt, u8g2->send_buf_ptr + u8g2->send_pos*u8g2_GetBufferTileSize(u8g2));
+  u8g2->send_pos += cnt;
+  
+  if ( u8g2->send_pos < u8g2->send_tile_cnt )
+    return 1;
+  
+  u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );
+  done_cb = u8g2->send_done_cb;
+  u8g2->send_done_cb = NULL;
+  u8g2->send_buf_ptr = NULL;
+  if ( done_cb != NULL )
+    done_cb(u8g2);
+  return 0;
+}
+
+void u8g2_FinishSendBuffer(u8g2_t *u8g2)
+{
+  while( u8g2_SendBufferStep(u8g2) )
+    ;
+}
+
+#endif /* U8G2_WITH_DOUBLE_BUFFER */
+
 /*============================================*/
 void u8g2_SetBufferCurrTileRow(u8g2_t *u8g2, uint8_t row)
 {
@@ -110,17 +378,52 @@ void u8g2_FirstPage(u8g2_t *u8g2)
     u8g2_ClearBuffer(u8g2);
   }
   u8g2_SetBufferCurrTileRow(u8g2, 0);
+#ifdef U8G2_WITH_FRAME_DIFF
+  u8g2->diff_sent_bytes = 0;
+  u8g2->diff_saved_bytes = 0;
+#endif
+#ifdef U8G2_WITH_DISPLAY_LIST
+  u8g2_dl_start(u8g2);
+#endif
 }
 
 uint8_t u8g2_NextPage(u8g2_t *u8g2)
 {
   uint8_t row;
+  U8G2_PROFILE_PHASE(u8g2, U8G2_PROFILE_PHASE_SEND);
   u8g2_send_buffer(u8g2);
   row = u8g2->tile_curr_row;
   row += u8g2->tile_buf_height;
+#ifdef U8G2_WITH_DISPLAY_LIST
+  if ( u8g2->dl_state == U8G2_DL_STATE_RECORD )
+  {
+    /* the first page has been recorded: render all other pages from the display list */
+    u8g2->dl_state = U8G2_DL_STATE_REPLAY;
+    while ( row < u8g2_GetU8x8(u8g2)->display_info->tile_height )
+    {
+      /* 
+	always clear: without auto page clear, the application clears the
+	buffer in the body of the picture loop, which is not executed here
+      */
+      u8g2_ClearBuffer(u8g2);
+      u8g2_SetBufferCurrTileRow(u8g2, row);
+      U8G2_PROFILE_PHASE(u8g2, U8G2_PROFILE_PHASE_DRAW);
+      u8g2_dl_replay(u8g2);
+      U8G2_PROFILE_PHASE(u8g2, U8G2_PROFILE_PHASE_SEND);
+      u8g2_send_buffer(u8g2);
+      row += u8g2->tile_buf_height;
+    }
+    u8g2->dl_state = U8G2_DL_STATE_IDLE;
+  }
+#endif
   if ( row >= u8g2_GetU8x8(u8g2)->display_info->tile_height )
   {
+#ifdef U8G2_WITH_FRAME_DIFF
+    /* all pages are sent, the shadow buffer is now identical to the display memory */
+    u8g2->is_shadow_valid = 1;
+#endif
     u8x8_RefreshDisplay( u8g2_GetU8x8(u8g2) );
+    U8G2_PROFILE_END_FRAME(u8g2);
     return 0;
   }
   if ( u8g2->is_auto_page_clear )
@@ -128,5 +431,6 @@ uint8_t u8g2_NextPage(u8g2_t *u8g2)
     u8g2_ClearBuffer(u8g2);
   }
   u8g2_SetBufferCurrTileRow(u8g2, row);
+  U8G2_PROFILE_PHASE(u8g2, U8G2_PROFILE_PHASE_DRAW);
   return 1;
 }
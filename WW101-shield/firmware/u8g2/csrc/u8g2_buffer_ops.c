@@ -0,0 +1,287 @@
+/* 
+
+  u8g2_buffer_ops.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+
+  Whole buffer operations: invert, xor overlay, masked copy and region fill.
+  
+  The operations work on the raw tile buffer in machine words instead
+  of drawing pixel lines with u8g2_DrawBox(). They do not know about
+  the rotation: The source buffers (overlay, mask) must have the layout 
+  of the u8g2 buffer and the size of the complete display 
+  (tile_width*tile_height*u8g2_GetBufferTileSize() bytes), 
+  for example the buffer of another u8g2 object with a full buffer.
+  In page mode, only the part of the current page is used.
+  
+  Each byte d of the buffer is modified with
+    d = ((d & and_mask) ^ xor_mask)
+  
+  The word size is 8 bit on AVR, 32/64 bit on other controllers. With gcc on 
+  SSE2/NEON hosts, a 16 byte vector type is used.
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+#if defined(__AVR__)
+typedef uint8_t u8g2_bop_word_t;
+#elif defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+typedef uint8_t u8g2_bop_word_t __attribute__ ((vector_size (16)));
+#elif defined(__SIZEOF_POINTER__) && __SIZEOF_POINTER__ == 8
+typedef uint64_t u8g2_bop_word_t;
+#else
+typedef uint32_t u8g2_bop_word_t;
+#endif
+
+/* memcpy is used for the load and store, because the buffer might not be aligned */
+static void u8g2_bop_and_xor(uint8_t *dest, size_t cnt, uint8_t and_mask, uint8_t xor_mask)
+{
+  u8g2_bop_word_t d, a, x;
+  memset(&a, and_mask, sizeof(a));
+  memset(&x, xor_mask, sizeof(x));
+  while( cnt >= sizeof(u8g2_bop_word_t) )
+  {
+    memcpy(&d, dest, sizeof(d));
+    d = (d & a) ^ x;
+    memcpy(dest, &d, sizeof(d));
+    dest += sizeof(d);
+    cnt -= sizeof(d);
+  }
+  while( cnt > 0 )
+  {
+    *dest = (*dest & and_mask) ^ xor_mask;
+    dest++;
+    cnt--;
+  }
+}
+
+/* mask == NULL: dest ^= src, otherwise: dest = (dest & ~mask) | (src & mask) */
+static void u8g2_bop_combine(uint8_t *dest, const uint8_t *src, const uint8_t *mask, size_t cnt)
+{
+  u8g2_bop_word_t d, s, m;
+  if ( mask == NULL )
+  {
+    while( cnt >= sizeof(u8g2_bop_word_t) )
+    {
+      memcpy(&d, dest, sizeof(d));
+      memcpy(&s, src, sizeof(s));
+      d ^= s;
+      memcpy(dest, &d, sizeof(d));
+      dest += sizeof(d);
+      src += sizeof(d);
+      cnt -= sizeof(d);
+    }
+    while( cnt > 0 )
+    {
+      *dest++ ^= *src++;
+      cnt--;
+    }
+  }
+  else
+  {
+    while( cnt >= sizeof(u8g2_bop_word_t) )
+    {
+      memcpy(&d, dest, sizeof(d));
+      memcpy(&s, src, sizeof(s));
+      memcpy(&m, mask, sizeof(m));
+      d = (d & ~m) | (s & m);
+      memcpy(dest, &d, sizeof(d));
+      dest += sizeof(d);
+      src += sizeof(d);
+      mask += sizeof(d);
+      cnt -= sizeof(d);
+    }
+    while( cnt > 0 )
+    {
+      *dest = (*dest & ~*mask) | (*src & *mask);
+      dest++;
+      src++;
+      mask++;
+      cnt--;
+    }
+  }
+}
+
+/* number of bytes of one tile row in the buffer */
+static uint16_t u8g2_bop_get_row_size(u8g2_t *u8g2)
+{
+  uint16_t row_size;
+  row_size = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  row_size *= u8g2_GetBufferTileSize(u8g2);
+  return row_size;
+}
+
+/* number of tile rows of the current page, which are visible on the display */
+static uint8_t u8g2_bop_get_rows(u8g2_t *u8g2)
+{
+  uint8_t rows = u8g2->tile_buf_height;
+  uint8_t tile_height = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  if ( u8g2->tile_curr_row + rows > tile_height )
+    rows = tile_height - u8g2->tile_curr_row;
+  return rows;
+}
+
+/*
+  and/xor values for the draw color, pattern is the value for a 
+  set pixel: 255 for 1 bit per pixel, gray_level*0x11 for the gray buffer
+*/
+static void u8g2_bop_get_masks(u8g2_t *u8g2, uint8_t mask, uint8_t pattern, uint8_t *and_mask, uint8_t *xor_mask)
+{
+  *and_mask = ~mask;
+  *xor_mask = 0;
+  if ( u8g2->draw_color != 0 )
+    *xor_mask = pattern & mask;
+  if ( u8g2->draw_color == 2 )
+    *and_mask = 255;
+}
+
+/*============================================*/
+
+/* invert all pixel of the current page, also for the 4 bit gray buffer (value = 15-value) */
+void u8g2_InvertBuffer(u8g2_t *u8g2)
+{
+  size_t cnt;
+  cnt = u8g2_bop_get_row_size(u8g2);
+  cnt *= u8g2->tile_buf_height;
+  u8g2_bop_and_xor(u8g2->tile_buf_ptr, cnt, 255, 255);
+}
+
+/* XOR the corresponding part of the full size overlay buffer "src" into the current page */
+void u8g2_XorBuffer(u8g2_t *u8g2, const uint8_t *src)
+{
+  size_t offset;
+  size_t cnt;
+  offset = u8g2_bop_get_row_size(u8g2);
+  cnt = offset;
+  offset *= u8g2->tile_curr_row;
+  cnt *= u8g2_bop_get_rows(u8g2);
+  u8g2_bop_combine(u8g2->tile_buf_ptr, src+offset, NULL, cnt);
+}
+
+/* copy all bits from the full size buffer "src", where the bit in the full size buffer "mask" is set */
+void u8g2_CopyBufferMasked(u8g2_t *u8g2, const uint8_t *src, const uint8_t *mask)
+{
+  size_t offset;
+  size_t cnt;
+  offset = u8g2_bop_get_row_size(u8g2);
+  cnt = offset;
+  offset *= u8g2->tile_curr_row;
+  cnt *= u8g2_bop_get_rows(u8g2);
+  u8g2_bop_combine(u8g2->tile_buf_ptr, src+offset, mask+offset, cnt);
+}
+
+/*
+  Fill the area x, y, w, h with the current draw color.
+  x and y are buffer coordinates: The rotation is not applied.
+  The area is clipped against the buffer (tile_width*8 x tile_height*8).
+  
+  u8g2_ll_hvline_vertical_top_lsb: each page row is one call to u8g2_bop_and_xor
+  horizontal layouts: one call for areas with the full buffer width,
+  otherwise each pixel line is drawn with ll_hvline.
+*/
+void u8g2_FillBufferRegion(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  uint16_t x0, x1, y0, y1;
+  uint16_t page_y0, page_y1;
+  uint16_t buf_width;
+  uint16_t row_size;
+  uint8_t *ptr;
+  uint8_t mask, and_mask, xor_mask, pattern;
+  
+  buf_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  buf_width *= 8;
+  row_size = u8g2_bop_get_row_size(u8g2);
+  
+  /* intersection with the buffer and the current page */
+  x0 = x;
+  x1 = x0;
+  x1 += w;
+  if ( x1 > buf_width )
+    x1 = buf_width;
+  if ( x0 >= x1 )
+    return;
+  
+  page_y0 = u8g2->tile_curr_row;
+  page_y0 *= 8;
+  page_y1 = u8g2_bop_get_rows(u8g2);
+  page_y1 *= 8;
+  page_y1 += page_y0;
+  y0 = y;
+  y1 = y0;
+  y1 += h;
+  if ( y0 < page_y0 )
+    y0 = page_y0;
+  if ( y1 > page_y1 )
+    y1 = page_y1;
+  if ( y0 >= y1 )
+    return;
+  y0 -= page_y0;
+  y1 -= page_y0;
+  
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb )
+  {
+    /* one byte per column and page row, the lowest bit is the upper pixel */
+    while( y0 < y1 )
+    {
+      mask = 255 << (y0 & 7);
+      if ( (y0 | 7) >= y1 )
+	mask &= 255 >> (7 - ((y1-1) & 7));
+      u8g2_bop_get_masks(u8g2, mask, 255, &and_mask, &xor_mask);
+      ptr = u8g2->tile_buf_ptr;
+      ptr += (y0 >> 3) * row_size;
+      ptr += x0;
+      u8g2_bop_and_xor(ptr, x1-x0, and_mask, xor_mask);
+      y0 = (y0 | 7) + 1;
+    }
+    return;
+  }
+  
+  if ( x0 == 0 && x1 == buf_width )
+  {
+    /* full lines of a horizontal layout are continuous in the buffer */
+    pattern = 255;
+    if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_gray4 )
+      pattern = u8g2->gray_level * 0x011;
+    u8g2_bop_get_masks(u8g2, 255, pattern, &and_mask, &xor_mask);
+    ptr = u8g2->tile_buf_ptr;
+    ptr += y0 * (row_size / 8);
+    u8g2_bop_and_xor(ptr, (size_t)(y1-y0)*(row_size / 8), and_mask, xor_mask);
+    return;
+  }
+  
+  while( y0 < y1 )
+  {
+    u8g2_call_ll_hvline(u8g2, x0, y0, x1-x0, 0);
+    y0++;
+  }
+}
@@ -108,6 +108,7 @@ static void u8g2_draw_circle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_
 
 void u8g2_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
 {
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_CIRCLE);
   /* check for bounding box */
 #ifdef U8G2_WITH_INTERSECTION
   {
@@ -124,47 +125,50 @@ void u8g2_DrawCircle(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t r
 /*==============================================*/
 /* Disk */
 
-static void u8g2_draw_disc_section(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option) U8G2_NOINLINE;
+static void u8g2_draw_disc_section(u8g2_t *u8g2, u8g2_span_batch_t *batch, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option) U8G2_NOINLINE;
 
-static void u8g2_draw_disc_section(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option)
+static void u8g2_draw_disc_section(u8g2_t *u8g2, u8g2_span_batch_t *batch, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option)
 {
     /* upper right */
     if ( option & U8G2_DRAW_UPPER_RIGHT )
     {
-      u8g2_DrawVLine(u8g2, x0+x, y0-y, y+1);
-      u8g2_DrawVLine(u8g2, x0+y, y0-x, x+1);
+      u8g2_AddSpan(u8g2, batch, x0+x, y0-y, y+1);
+      u8g2_AddSpan(u8g2, batch, x0+y, y0-x, x+1);
     }
     
     /* upper left */
     if ( option & U8G2_DRAW_UPPER_LEFT )
     {
-      u8g2_DrawVLine(u8g2, x0-x, y0-y, y+1);
-      u8g2_DrawVLine(u8g2, x0-y, y0-x, x+1);
+      u8g2_AddSpan(u8g2, batch, x0-x, y0-y, y+1);
+      u8g2_AddSpan(u8g2, batch, x0-y, y0-x, x+1);
     }
     
     /* lower right */
     if ( option & U8G2_DRAW_LOWER_RIGHT )
     {
-      u8g2_DrawVLine(u8g2, x0+x, y0, y+1);
-      u8g2_DrawVLine(u8g2, x0+y, y0, x+1);
+      u8g2_AddSpan(u8g2, batch, x0+x, y0, y+1);
+      u8g2_AddSpan(u8g2, batch, x0+y, y0, x+1);
     }
     
     /* lower left */
     if ( option & U8G2_DRAW_LOWER_LEFT )
     {
-      u8g2_DrawVLine(u8g2, x0-x, y0, y+1);
-      u8g2_DrawVLine(u8g2, x0-y, y0, x+1);
+      u8g2_AddSpan(u8g2, batch, x0-x, y0, y+1);
+      u8g2_AddSpan(u8g2, batch, x0-y, y0, x+1);
     }
 }
 
 static void u8g2_draw_disc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
 {
+  u8g2_span_batch_t batch;
   u8g2_int_t f;
   u8g2_int_t ddF_x;
   u8g2_int_t ddF_y;
   u8g2_uint_t x;
   u8g2_uint_t y;
 
+  u8g2_InitSpanBatch(u8g2, &batch, 1);
+
   f = 1;
   f -= rad;
   ddF_x = 1;
@@ -174,7 +178,7 @@ static void u8g2_draw_disc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_ui
   x = 0;
   y = rad;
 
-  u8g2_draw_disc_section(u8g2, x, y, x0, y0, option);
+  u8g2_draw_disc_section(u8g2, &batch, x, y, x0, y0, option);
   
   while ( x < y )
   {
@@ -188,12 +192,14 @@ static void u8g2_draw_disc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_ui
     ddF_x += 2;
     f += ddF_x;
 
-    u8g2_draw_disc_section(u8g2, x, y, x0, y0, option);    
+    u8g2_draw_disc_section(u8g2, &batch, x, y, x0, y0, option);    
   }
+  u8g2_FlushSpanBatch(u8g2, &batch);
 }
 
 void u8g2_DrawDisc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad, uint8_t option)
 {
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_CIRCLE);
   /* check for bounding box */
 #ifdef U8G2_WITH_INTERSECTION
   {
@@ -327,11 +333,11 @@ static void u8g2_draw_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2
       ychg += rxrx2;
     }
   }
-  
 }
 
 void u8g2_DrawEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
 {
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_ELLIPSE);
   /* check for bounding box */
 #ifdef U8G2_WITH_INTERSECTION
   {
@@ -346,36 +352,37 @@ void u8g2_DrawEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t
 /*==============================================*/
 /* Filled Ellipse */
 
-static void u8g2_draw_filled_ellipse_section(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option) U8G2_NOINLINE;
-static void u8g2_draw_filled_ellipse_section(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option)
+static void u8g2_draw_filled_ellipse_section(u8g2_t *u8g2, u8g2_span_batch_t *batch, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option) U8G2_NOINLINE;
+static void u8g2_draw_filled_ellipse_section(u8g2_t *u8g2, u8g2_span_batch_t *batch, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0, uint8_t option)
 {
     /* upper right */
     if ( option & U8G2_DRAW_UPPER_RIGHT )
     {
-      u8g2_DrawVLine(u8g2, x0+x, y0-y, y+1);
+      u8g2_AddSpan(u8g2, batch, x0+x, y0-y, y+1);
     }
     
     /* upper left */
     if ( option & U8G2_DRAW_UPPER_LEFT )
     {
-      u8g2_DrawVLine(u8g2, x0-x, y0-y, y+1);
+      u8g2_AddSpan(u8g2, batch, x0-x, y0-y, y+1);
     }
     
     /* lower right */
     if ( option & U8G2_DRAW_LOWER_RIGHT )
     {
-      u8g2_DrawVLine(u8g2, x0+x, y0, y+1);
+      u8g2_AddSpan(u8g2, batch, x0+x, y0, y+1);
     }
     
     /* lower left */
     if ( option & U8G2_DRAW_LOWER_LEFT )
     {
-      u8g2_DrawVLine(u8g2, x0-x, y0, y+1);
+      u8g2_AddSpan(u8g2, batch, x0-x, y0, y+1);
     }
 }
 
 static void u8g2_draw_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
 {
+  u8g2_span_batch_t batch;
   u8g2_uint_t x, y;
   u8g2_long_t xchg, ychg;
   u8g2_long_t err;
@@ -383,6 +390,8 @@ static void u8g2_draw_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y
   u8g2_long_t ryry2;
   u8g2_long_t stopx, stopy;
   
+  u8g2_InitSpanBatch(u8g2, &batch, 1);
+
   rxrx2 = rx;
   rxrx2 *= rx;
   rxrx2 *= 2;
@@ -411,7 +420,7 @@ static void u8g2_draw_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y
   
   while( stopx >= stopy )
   {
-    u8g2_draw_filled_ellipse_section(u8g2, x, y, x0, y0, option);
+    u8g2_draw_filled_ellipse_section(u8g2, &batch, x, y, x0, y0, option);
     y++;
     stopy += rxrx2;
     err += ychg;
@@ -447,7 +456,7 @@ static void u8g2_draw_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y
 
   while( stopx <= stopy )
   {
-    u8g2_draw_filled_ellipse_section(u8g2, x, y, x0, y0, option);
+    u8g2_draw_filled_ellipse_section(u8g2, &batch, x, y, x0, y0, option);
     x++;
     stopx += ryry2;
     err += xchg;
@@ -460,11 +469,12 @@ static void u8g2_draw_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y
       ychg += rxrx2;
     }
   }
-  
+  u8g2_FlushSpanBatch(u8g2, &batch);
 }
 
 void u8g2_DrawFilledEllipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry, uint8_t option)
 {
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_ELLIPSE);
   /* check for bounding box */
 #ifdef U8G2_WITH_INTERSECTION
   {
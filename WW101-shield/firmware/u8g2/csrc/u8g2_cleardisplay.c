@@ -38,6 +38,10 @@
 /* this is, becasue we can not used the u8x8 function in all cases */
 void u8g2_ClearDisplay(u8g2_t *u8g2)
 {
+#ifdef U8G2_WITH_FRAME_DIFF
+  /* the display content is not known, so all tiles must be sent */
+  u8g2_InvalidateShadowBuffer(u8g2);
+#endif
   u8g2_FirstPage(u8g2);
   do {
   } while ( u8g2_NextPage(u8g2) );
@@ -0,0 +1,236 @@
+/* 
+
+  u8g2_d_gray.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  Memory and setup procedures for the 4 bit gray buffer 
+  (u8g2_ll_hvline_horizontal_gray4). Same as the generated procedures 
+  in u8g2_d_memory.c and u8g2_d_setup.c, but each tile requires 32 bytes 
+  instead of 8 bytes.
+
+*/
+
+#include "u8g2.h"
+
+uint8_t *u8g2_m_ssd1322_32_gray_1(uint8_t *page_cnt)
+{
+  static uint8_t buf[1024];
+  *page_cnt = 1;
+  return buf;
+}
+uint8_t *u8g2_m_ssd1322_32_gray_2(uint8_t *page_cnt)
+{
+  static uint8_t buf[2048];
+  *page_cnt = 2;
+  return buf;
+}
+uint8_t *u8g2_m_ssd1322_32_gray_f(uint8_t *page_cnt)
+{
+  static uint8_t buf[8192];
+  *page_cnt = 8;
+  return buf;
+}
+uint8_t *u8g2_m_ssd1325_16_gray_1(uint8_t *page_cnt)
+{
+  static uint8_t buf[512];
+  *page_cnt = 1;
+  return buf;
+}
+uint8_t *u8g2_m_ssd1325_16_gray_2(uint8_t *page_cnt)
+{
+  static uint8_t buf[1024];
+  *page_cnt = 2;
+  return buf;
+}
+uint8_t *u8g2_m_ssd1325_16_gray_f(uint8_t *page_cnt)
+{
+  static uint8_t buf[4096];
+  *page_cnt = 8;
+  return buf;
+}
+uint8_t *u8g2_m_ssd1327_12_gray_1(uint8_t *page_cnt)
+{
+  static uint8_t buf[384];
+  *page_cnt = 1;
+  return buf;
+}
+uint8_t *u8g2_m_ssd1327_12_gray_2(uint8_t *page_cnt)
+{
+  static uint8_t buf[768];
+  *page_cnt = 2;
+  return buf;
+}
+uint8_t *u8g2_m_ssd1327_12_gray_f(uint8_t *page_cnt)
+{
+  static uint8_t buf[4608];
+  *page_cnt = 12;
+  return buf;
+}
+/* ssd1322 */
+/* ssd1322 gray 1 */
+void u8g2_Setup_ssd1322_nhd_256x64_gray_1(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1322_nhd_256x64, u8x8_cad_011, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1322_32_gray_1(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1322 gray 2 */
+void u8g2_Setup_ssd1322_nhd_256x64_gray_2(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1322_nhd_256x64, u8x8_cad_011, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1322_32_gray_2(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1322 gray f */
+void u8g2_Setup_ssd1322_nhd_256x64_gray_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1322_nhd_256x64, u8x8_cad_011, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1322_32_gray_f(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1325 */
+/* ssd1325 gray 1 */
+void u8g2_Setup_ssd1325_nhd_128x64_gray_1(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1325_nhd_128x64, u8x8_cad_001, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1325_16_gray_1(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1325 gray 2 */
+void u8g2_Setup_ssd1325_nhd_128x64_gray_2(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1325_nhd_128x64, u8x8_cad_001, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1325_16_gray_2(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1325 gray f */
+void u8g2_Setup_ssd1325_nhd_128x64_gray_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1325_nhd_128x64, u8x8_cad_001, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1325_16_gray_f(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1325 */
+/* ssd1325 gray 1 */
+void u8g2_Setup_ssd1325_i2c_nhd_128x64_gray_1(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1325_nhd_128x64, u8x8_cad_ssd13xx_i2c, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1325_16_gray_1(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1325 gray 2 */
+void u8g2_Setup_ssd1325_i2c_nhd_128x64_gray_2(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1325_nhd_128x64, u8x8_cad_ssd13xx_i2c, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1325_16_gray_2(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1325 gray f */
+void u8g2_Setup_ssd1325_i2c_nhd_128x64_gray_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1325_nhd_128x64, u8x8_cad_ssd13xx_i2c, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1325_16_gray_f(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1327 */
+/* ssd1327 gray 1 */
+void u8g2_Setup_ssd1327_seeed_96x96_gray_1(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1327_seeed_96x96, u8x8_cad_001, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1327_12_gray_1(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1327 gray 2 */
+void u8g2_Setup_ssd1327_seeed_96x96_gray_2(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1327_seeed_96x96, u8x8_cad_001, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1327_12_gray_2(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1327 gray f */
+void u8g2_Setup_ssd1327_seeed_96x96_gray_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1327_seeed_96x96, u8x8_cad_001, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1327_12_gray_f(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1327 */
+/* ssd1327 gray 1 */
+void u8g2_Setup_ssd1327_i2c_seeed_96x96_gray_1(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1327_seeed_96x96, u8x8_cad_ssd13xx_i2c, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1327_12_gray_1(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1327 gray 2 */
+void u8g2_Setup_ssd1327_i2c_seeed_96x96_gray_2(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1327_seeed_96x96, u8x8_cad_ssd13xx_i2c, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1327_12_gray_2(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
+/* ssd1327 gray f */
+void u8g2_Setup_ssd1327_i2c_seeed_96x96_gray_f(u8g2_t *u8g2, const u8g2_cb_t *rotation, u8x8_msg_cb byte_cb, u8x8_msg_cb gpio_and_delay_cb)
+{
+  uint8_t tile_buf_height;
+  uint8_t *buf;
+  u8g2_SetupDisplay(u8g2, u8x8_d_ssd1327_seeed_96x96, u8x8_cad_ssd13xx_i2c, byte_cb, gpio_and_delay_cb);
+  buf = u8g2_m_ssd1327_12_gray_f(&tile_buf_height);
+  u8g2_SetupBuffer(u8g2, buf, tile_buf_height, u8g2_ll_hvline_horizontal_gray4, rotation);
+}
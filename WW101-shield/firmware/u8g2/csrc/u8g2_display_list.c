@@ -0,0 +1,197 @@
+/* 
+
+  u8g2_display_list.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+
+  Display list for the picture loop
+
+  With a page buffer, the user draw procedure is called once for each page
+  (8 times for a 128x64 display with a one page buffer). Each call will 
+  decode all glyphs and calculate all graphics elements again.
+  
+  The display list stores the lines, which are generated by u8g2_DrawHVLine() 
+  during the first page. All other pages are rendered from these records,
+  the user draw procedure is called only once.
+  
+  Each record has 4 bytes (8 bytes with U8G2_16BIT). A record is skipped 
+  if it does not intersect with the current page. Adjacent horizontal 
+  lines with the same color (and gray level) are combined into one record.
+  
+  Usage:
+    u8g2_dl_rec_t dl[200];
+    u8g2_SetDisplayList(&u8g2, dl, 200);
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      draw();
+    } while( u8g2_NextPage(&u8g2) );
+  
+  If the display list is too small, then the recording stops and
+  u8g2_NextPage() will return 1 as usual: The user draw procedure 
+  is called again for all remaining pages.
+  
+  The buffer is always cleared before a page is rendered from the 
+  display list, also with u8g2_SetAutoPageClear(&u8g2, 0).
+
+*/
+
+#include "u8g2.h"
+
+#ifdef U8G2_WITH_DISPLAY_LIST
+
+#ifndef U8G2_WITH_CLIPPING
+#error "U8G2_WITH_DISPLAY_LIST requires U8G2_WITH_CLIPPING"
+#endif
+
+/*
+  list:	memory for cnt records, NULL will disable the display list
+*/
+void u8g2_SetDisplayList(u8g2_t *u8g2, u8g2_dl_rec_t *list, uint16_t cnt)
+{
+  u8g2->dl_list = list;
+  u8g2->dl_max = cnt;
+  u8g2->dl_cnt = 0;
+  u8g2->dl_state = U8G2_DL_STATE_IDLE;
+}
+
+/*
+  Called by u8g2_FirstPage() after the first page has been assigned.
+  Recording is only started if there is more than one page.
+*/
+void u8g2_dl_start(u8g2_t *u8g2)
+{
+  u8g2->dl_cnt = 0;
+  u8g2->dl_state = U8G2_DL_STATE_IDLE;
+  if ( u8g2->dl_list == NULL )
+    return;
+  if ( u8g2->tile_buf_height >= u8g2_GetU8x8(u8g2)->display_info->tile_height )
+    return;
+  u8g2->dl_state = U8G2_DL_STATE_RECORD;
+  
+  /* all elements must be recorded, so open the user clip box to the full display */
+  /* lines outside the current page are still removed by u8g2_draw_hv_line_2dir() */
+  u8g2->user_x0 = 0;
+  u8g2->user_x1 = u8g2->width;
+  u8g2->user_y0 = 0;
+  u8g2->user_y1 = u8g2->height;
+}
+
+/*
+  Called by u8g2_DrawHVLine() during the first page. 
+  x, y, len, dir are the arguments of u8g2_DrawHVLine(), len is not 0.
+*/
+void u8g2_dl_add(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  u8g2_dl_rec_t *rec;
+  uint8_t flags;
+  
+  flags = u8g2->gray_level;
+  flags <<= 2;
+  flags |= u8g2->draw_color;
+  flags <<= 2;
+  flags |= dir;
+  
+  /* extend the previous record, if this is the continuation of a horizontal line */
+  if ( dir == 0 && u8g2->dl_cnt > 0 )
+  {
+    rec = u8g2->dl_list + u8g2->dl_cnt - 1;
+    if ( rec->flags == flags && rec->y == y && (u8g2_uint_t)(rec->x + rec->len) == x )
+    {
+      if ( (u8g2_uint_t)(rec->len + len) > rec->len )
+      {
+	rec->len += len;
+	return;
+      }
+    }
+  }
+  
+  if ( u8g2->dl_cnt >= u8g2->dl_max )
+  {
+    /* list is full: stop recording, u8g2_NextPage() continues with the normal picture loop */
+    u8g2->dl_state = U8G2_DL_STATE_IDLE;
+    return;
+  }
+  
+  rec = u8g2->dl_list + u8g2->dl_cnt;
+  rec->x = x;
+  rec->y = y;
+  rec->len = len;
+  rec->flags = flags;
+  u8g2->dl_cnt++;
+}
+
+/*
+  Draw all records, which intersect with the current page.
+  Called by u8g2_NextPage() for all pages except the first page.
+*/
+void u8g2_dl_replay(u8g2_t *u8g2)
+{
+  u8g2_dl_rec_t *rec;
+  uint16_t cnt;
+  uint8_t color, gray_level;
+  uint8_t dir;
+#ifdef U8G2_WITH_INTERSECTION
+  u8g2_uint_t x0, y0, x1, y1;
+#endif
+  
+  color = u8g2->draw_color;
+  gray_level = u8g2->gray_level;
+  rec = u8g2->dl_list;
+  for( cnt = u8g2->dl_cnt; cnt > 0; cnt-- )
+  {
+    dir = rec->flags & 3;
+#ifdef U8G2_WITH_INTERSECTION
+    x0 = rec->x;
+    y0 = rec->y;
+    x1 = x0+1;
+    y1 = y0+1;
+    switch(dir)
+    {
+      case 0: x1 = x0 + rec->len; break;
+      case 1: y1 = y0 + rec->len; break;
+      case 2: x0 = x1 - rec->len; break;
+      case 3: y0 = y1 - rec->len; break;
+    }
+    if ( u8g2_IsIntersection(u8g2, x0, y0, x1, y1) != 0 ) 
+#endif /* U8G2_WITH_INTERSECTION */
+    {
+      u8g2->draw_color = (rec->flags >> 2) & 3;
+      u8g2->gray_level = rec->flags >> 4;
+      u8g2->cb->draw_l90(u8g2, rec->x, rec->y, rec->len, dir);
+    }
+    rec++;
+  }
+  u8g2->draw_color = color;
+  u8g2->gray_level = gray_level;
+}
+
+#endif /* U8G2_WITH_DISPLAY_LIST */
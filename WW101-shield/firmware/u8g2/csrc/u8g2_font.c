@@ -489,6 +489,7 @@ int8_t u8g2_font_decode_glyph(u8g2_t *u8g2, const uint8_t *glyph_data)
   int8_t h;
   u8g2_font_decode_t *decode = &(u8g2->font_decode);
     
+  U8G2_PROFILE_ADD(u8g2, glyph_cnt, 1);
   u8g2_font_setup_decode(u8g2, glyph_data);
   h = u8g2->font_decode.glyph_height;
   
@@ -696,6 +697,7 @@ void u8g2_SetFontMode(u8g2_t *u8g2, uint8_t is_transparent)
 
 u8g2_uint_t u8g2_DrawGlyph(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, uint16_t encoding)
 {
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_GLYPH);
 #ifdef U8G2_WITH_FONT_ROTATION
   switch(u8g2->font_decode.dir)
   {
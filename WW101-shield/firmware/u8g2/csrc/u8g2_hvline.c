@@ -128,27 +128,39 @@ static void u8g2_draw_hv_line_2dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u
   if ( dir == 0 )
   {
     if ( y >= h )
+    {
+      U8G2_PROFILE_ADD(u8g2, span_reject_cnt, 1);
       return;
+    }
     a = x;
     a += len;
     if ( u8g2_clip_intersection(&x, &a, w) == 0 )
+    {
+      U8G2_PROFILE_ADD(u8g2, span_reject_cnt, 1);
       return;
+    }
     len = a;
     len -= x;
   }
   else
   {
     if ( x >= w )
+    {
+      U8G2_PROFILE_ADD(u8g2, span_reject_cnt, 1);
       return;
+    }
     a = y;
     a += len;
     if ( u8g2_clip_intersection(&y, &a, h) == 0 )
+    {
+      U8G2_PROFILE_ADD(u8g2, span_reject_cnt, 1);
       return;
+    }
     len = a;
     len -= y;
   }
   
-  u8g2->ll_hvline(u8g2, x, y, len, dir);
+  u8g2_call_ll_hvline(u8g2, x, y, len, dir);
   //u8g2_draw_low_level_hv_line(u8g2, x, y, len, dir);
 }
 
@@ -165,7 +177,7 @@ static void u8g2_draw_hv_line_2dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u
   This function will remove directions 2 and 3. Instead 0 and 1 are used.
 
 */
-void u8g2_draw_hv_line_4dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+static U8G2_ALWAYS_INLINE void u8g2_draw_hv_line_dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
 {
 #ifdef U8G2_WITH_HVLINE_COUNT
   u8g2->hv_cnt++;
@@ -179,7 +191,9 @@ void u8g2_draw_hv_line_4dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uin
   {
     y -= u8g2->tile_curr_row*8;
     if ( x < u8g2->pixel_buf_width && y < u8g2->pixel_buf_height )
-      u8g2->ll_hvline(u8g2, x, y, len, dir);
+      u8g2_call_ll_hvline(u8g2, x, y, len, dir);
+    else
+      U8G2_PROFILE_ADD(u8g2, span_reject_cnt, 1);
     return;
   }
 #endif
@@ -198,11 +212,75 @@ void u8g2_draw_hv_line_4dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uin
 #ifdef U8G2_WITH_CLIPPING
   u8g2_draw_hv_line_2dir(u8g2, x, y, len, dir);
 #else
-  u8g2->ll_hvline(u8g2, x, y, len, dir);
+  u8g2_call_ll_hvline(u8g2, x, y, len, dir);
   //u8g2_draw_low_level_hv_line(u8g2, x, y, len, dir);
 #endif
 }
 
+void u8g2_draw_hv_line_4dir(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  u8g2_draw_hv_line_dir(u8g2, x, y, len, dir);
+}
+
+#ifdef U8G2_FIXED_ROTATION
+
+#if U8G2_FIXED_ROTATION == 0
+#define U8G2_FIXED_CB U8G2_R0
+#elif U8G2_FIXED_ROTATION == 1
+#define U8G2_FIXED_CB U8G2_R1
+#elif U8G2_FIXED_ROTATION == 2
+#define U8G2_FIXED_CB U8G2_R2
+#elif U8G2_FIXED_ROTATION == 3
+#define U8G2_FIXED_CB U8G2_R3
+#elif U8G2_FIXED_ROTATION == 4
+#define U8G2_FIXED_CB U8G2_MIRROR
+#else
+#error "U8G2_FIXED_ROTATION must be 0..4"
+#endif
+
+/*
+  Same as the draw_l90 procedures in u8g2_setup.c, but for the 
+  rotation U8G2_FIXED_ROTATION only, so that it can be inlined.
+*/
+static U8G2_ALWAYS_INLINE void u8g2_draw_l90_fixed(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+#if U8G2_FIXED_ROTATION == 1
+  u8g2_uint_t t = x;
+  x = u8g2->height;
+  x -= y;
+  x--;
+  y = t;
+  dir++;
+  dir &= 3;
+#elif U8G2_FIXED_ROTATION == 2
+  y = u8g2->height - y;
+  y--;
+  x = u8g2->width - x;
+  x--;
+  dir += 2;
+  dir &= 3;
+#elif U8G2_FIXED_ROTATION == 3
+  u8g2_uint_t t = y;
+  y = u8g2->width;
+  y -= x;
+  y--;
+  x = t;
+  dir += 3;
+  dir &= 3;
+#elif U8G2_FIXED_ROTATION == 4
+  u8g2_uint_t t = u8g2->width;
+  t -= x;
+  if ( (dir & 1) == 0 )
+    t -= len;
+  else
+    t--;
+  x = t;
+#endif
+  u8g2_draw_hv_line_dir(u8g2, x, y, len, dir);
+}
+
+#endif /* U8G2_FIXED_ROTATION */
+
 /*
   This is the toplevel function for the hv line draw procedures.
   This function should be called by the user.
@@ -215,14 +293,29 @@ void u8g2_DrawHVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len
   /* The callback may rotate the hv line */
   /* after rotation this will call u8g2_draw_hv_line_4dir() */
   if ( len != 0 )
-    u8g2->cb->draw_l90(u8g2, x, y, len, dir);
+  {
+#ifdef U8G2_WITH_DISPLAY_LIST
+    /* first page of the picture loop: store the line for the other pages */
+    if ( u8g2->dl_state == U8G2_DL_STATE_RECORD )
+      u8g2_dl_add(u8g2, x, y, len, dir);
+#endif
+#ifdef U8G2_FIXED_ROTATION
+    if ( u8g2->cb == U8G2_FIXED_CB )
+      u8g2_draw_l90_fixed(u8g2, x, y, len, dir);
+    else
+#endif
+      u8g2->cb->draw_l90(u8g2, x, y, len, dir);
+  }
 }
 
 void u8g2_DrawHLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len)
 {
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+len, y+1) == 0 ) 
+  {
+    U8G2_PROFILE_ADD(u8g2, span_reject_cnt, 1);
     return;
+  }
 #endif /* U8G2_WITH_INTERSECTION */
   u8g2_DrawHVLine(u8g2, x, y, len, 0);
 }
@@ -231,7 +324,10 @@ void u8g2_DrawVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len)
 {
 #ifdef U8G2_WITH_INTERSECTION
   if ( u8g2_IsIntersection(u8g2, x, y, x+1, y+len) == 0 ) 
+  {
+    U8G2_PROFILE_ADD(u8g2, span_reject_cnt, 1);
     return;
+  }
 #endif /* U8G2_WITH_INTERSECTION */
   u8g2_DrawHVLine(u8g2, x, y, len, 1);
 }
@@ -239,14 +335,11 @@ void u8g2_DrawVLine(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len)
 void u8g2_DrawPixel(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y)
 {
 #ifdef U8G2_WITH_INTERSECTION
-  if ( y < u8g2->user_y0 )
-    return;
-  if ( y >= u8g2->user_y1 )
-    return;
-  if ( x < u8g2->user_x0 )
-    return;
-  if ( x >= u8g2->user_x1 )
+  if ( y < u8g2->user_y0 || y >= u8g2->user_y1 || x < u8g2->user_x0 || x >= u8g2->user_x1 )
+  {
+    U8G2_PROFILE_ADD(u8g2, span_reject_cnt, 1);
     return;
+  }
 #endif /* U8G2_WITH_INTERSECTION */
   u8g2_DrawHVLine(u8g2, x, y, 1, 0);
 }
@@ -53,6 +53,7 @@ uint8_t u8g2_UserInterfaceInputValue(u8g2_t *u8g2, const char *title, const char
   uint8_t local_value = *value;
   //uint8_t r; /* not used ??? */
   uint8_t event;
+  char buf[4];
 
   /* only horizontal strings are supported, so force this here */
   u8g2_SetFontDirection(u8g2, 0);
@@ -106,7 +107,7 @@ uint8_t u8g2_UserInterfaceInputValue(u8g2_t *u8g2, const char *title, const char
       yy += u8g2_DrawUTF8Lines(u8g2, 0, yy, u8g2_GetDisplayWidth(u8g2), line_height, title);
       xx = x;
       xx += u8g2_DrawUTF8(u8g2, xx, yy, pre);
-      xx += u8g2_DrawUTF8(u8g2, xx, yy, u8x8_u8toa(local_value, digits));
+      xx += u8g2_DrawUTF8(u8g2, xx, yy, u8x8_u8toap(buf, local_value)+3-digits);
       u8g2_DrawUTF8(u8g2, xx, yy, post);
     } while( u8g2_NextPage(u8g2) );
     
@@ -116,7 +117,7 @@ uint8_t u8g2_UserInterfaceInputValue(u8g2_t *u8g2, const char *title, const char
     
     for(;;)
     {
-      event = u8x8_GetMenuEvent(u8g2_GetU8x8(u8g2));
+      event = u8x8_WaitMenuEvent(u8g2_GetU8x8(u8g2));
       if ( event == U8X8_MSG_GPIO_MENU_SELECT )
       {
 	*value = local_value;
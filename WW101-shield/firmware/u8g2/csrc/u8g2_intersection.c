@@ -37,12 +37,6 @@
 
 #include "u8g2.h"
 
-#ifdef __GNUC__
-#define U8G2_ALWAYS_INLINE __inline__ __attribute__((always_inline))
-#else
-#define U8G2_ALWAYS_INLINE
-#endif 
-
 
 #ifdef U8G2_WITH_INTERSECTION    
 
@@ -119,8 +113,11 @@ static uint8_t u8g2_is_intersection_decision_tree(u8g2_uint_t a0, u8g2_uint_t a1
   version with asymetric boundaries.
   a1 and v1 are excluded
   v0 == v1 is not support end return 1
+  
+  This is called twice for each u8g2_IsIntersection(), so force inlining:
+  In 16 Bit mode, a function call costs more than the comparisons itself.
 */
-uint8_t u8g2_is_intersection_decision_tree(u8g2_uint_t a0, u8g2_uint_t a1, u8g2_uint_t v0, u8g2_uint_t v1)
+static U8G2_ALWAYS_INLINE uint8_t u8g2_is_intersection_decision_tree(u8g2_uint_t a0, u8g2_uint_t a1, u8g2_uint_t v0, u8g2_uint_t v1)
 {
   if ( v0 < a1 )		// v0 <= a1
   {
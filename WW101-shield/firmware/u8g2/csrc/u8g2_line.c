@@ -39,6 +39,7 @@ void u8g2_DrawLine(u8g2_t *u8g2, u8g2_uint_t x1, u8g2_uint_t y1, u8g2_uint_t x2,
 
   uint8_t swapxy = 0;
   
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_LINE);
   /* no intersection check at the moment, should be added... */
 
   if ( x1 > x2 ) dx = x1-x2; else dx = x2-x1;
@@ -46,6 +46,13 @@
   if ( color != 1 )
     xor_mask = mask;
     
+
+  x, y and len are positions within the tile buffer. Clipping is done 
+  with u8g2_uint_t (which might be 16 Bit), but the loops below use 
+  u8g2_buf_uint_t (8 Bit, unless U8G2_16BIT is defined without U8G2_8BIT_BUFFER).
+  A len of 256 will be truncated to 0, which is still correct for the 
+  do-while loops (256 iterations).
+    
 */
 
 #include "u8g2.h"
@@ -71,6 +78,7 @@
 */
 void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
 {
+  u8g2_buf_uint_t cnt = len;
   uint16_t offset;
   uint8_t *ptr;
   uint8_t bit_pos, mask;
@@ -114,8 +122,8 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
 	*ptr |= or_mask;
 	*ptr ^= xor_mask;
 	ptr++;
-	len--;
-      } while( len != 0 );
+	cnt--;
+      } while( cnt != 0 );
       /*
     }
     else
@@ -125,13 +133,16 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
       {
 	*ptr &= mask;
 	ptr++;
-	len--;
-      } while( len != 0 );
+	cnt--;
+      } while( cnt != 0 );
     }  
     */
   }
   else
   {    
+    /* distance to the next tile row, this might be 256 in 8 Bit mode */
+    offset = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+    offset *= 8;
     do
     {
       *ptr |= or_mask;
@@ -150,11 +161,12 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
       bit_pos++;
       bit_pos &= 7;
 
-      len--;
+      cnt--;
 
       if ( bit_pos == 0 )
       {
-	ptr+=u8g2->pixel_buf_width;	/* 6 Jan 17: Changed u8g2->width to u8g2->pixel_buf_width, issue #148 */
+	ptr+=offset;	/* 6 Jan 17: Changed u8g2->width to u8g2->pixel_buf_width, issue #148 */
+			/* pixel_buf_width is not used any more, because it is limited to 248 in 8 Bit mode */
 	
 	/* another speed optimization, but requires about 60 bytes on AVR */
 	/*
@@ -186,7 +198,7 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
 	or_mask <<= 1;
 	xor_mask <<= 1;
       }
-    } while( len != 0 );
+    } while( cnt != 0 );
   }
 }
 
@@ -197,7 +209,7 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
 /*
   x,y position within the buffer
 */
-static void u8g2_draw_pixel_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y)
+static void u8g2_draw_pixel_vertical_top_lsb(u8g2_t *u8g2, u8g2_buf_uint_t x, u8g2_buf_uint_t y)
 {
   uint16_t offset;
   uint8_t *ptr;
@@ -250,14 +262,15 @@ static void u8g2_draw_pixel_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_u
 */
 void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
 {
+  u8g2_buf_uint_t cnt = len;
   if ( dir == 0 )
   {
     do
     {
       u8g2_draw_pixel_vertical_top_lsb(u8g2, x, y);
       x++;
-      len--;
-    } while( len != 0 );
+      cnt--;
+    } while( cnt != 0 );
   }
   else
   {
@@ -265,8 +278,8 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
     {
       u8g2_draw_pixel_vertical_top_lsb(u8g2, x, y);
       y++;
-      len--;
-    } while( len != 0 );
+      cnt--;
+    } while( cnt != 0 );
   }
 }
 
@@ -276,7 +289,11 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
 /*=================================================*/
 /*
   u8g2_ll_hvline_horizontal_right_lsb
-    ST7920
+    ST7920, LS013B7DH03, T6963
+    
+  Each pixel line of the buffer has tile_width bytes, the msb is the left 
+  pixel. This is the memory layout of these controllers, so each tile row 
+  is sent line by line without conversion.
 */
 
 #ifdef U8G2_HVLINE_SPEED_OPTIMIZATION
@@ -288,20 +305,25 @@ void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y,
 		1: vertical line (top to bottom)
   asumption: 
     all clipping done
+    
+  A horizontal line is written byte by byte: The first and the last byte 
+  are masked, all bytes in between are written completely.
+  or_mask and xor_mask are 0 or 255, see the description at the 
+  beginning of this file.
 */
 
 void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
 {
+  u8g2_buf_uint_t cnt = len;
   uint16_t offset;
   uint8_t *ptr;
   uint8_t bit_pos;
   uint8_t mask;
+  uint8_t or_mask, xor_mask;
   uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
 
   bit_pos = x;		/* overflow truncate is ok here... */
   bit_pos &= 7; 	/* ... because only the lowest 3 bits are needed */
-  mask = 128;
-  mask >>= bit_pos;
 
   offset = y;		/* y might be 8 or 16 bit, but we need 16 bit, so use a 16 bit variable */
   offset *= tile_width;
@@ -309,41 +331,65 @@ void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_
   ptr = u8g2->tile_buf_ptr;
   ptr += offset;
   
+  or_mask = 0;
+  xor_mask = 0;
+  if ( u8g2->draw_color <= 1 )
+    or_mask = 255;
+  if ( u8g2->draw_color != 1 )
+    xor_mask = 255;
+  
   if ( dir == 0 )
   {
-      
-    do
+    /* len is used instead of cnt, because a length of 256 must not be truncated here */
+    
+    /* first byte: pixel from bit_pos to the right edge of the byte */
+    mask = 255;
+    mask >>= bit_pos;
+    if ( len + bit_pos < 8 )
     {
-
-      if ( u8g2->draw_color <= 1 )
-	*ptr |= mask;
-      if ( u8g2->draw_color != 1 )
-	*ptr ^= mask;
-      
-      mask >>= 1;
-      if ( mask == 0 )
-      {
-	mask = 128;
-        ptr++;
-      }
-      
-      //x++;
-      len--;
-    } while( len != 0 );
+      /* the line ends within the first byte */
+      mask &= ~(uint8_t)(255 >> (len + bit_pos));
+      *ptr |= mask & or_mask;
+      *ptr ^= mask & xor_mask;
+      return;
+    }
+    *ptr |= mask & or_mask;
+    *ptr ^= mask & xor_mask;
+    ptr++;
+    len -= 8 - bit_pos;
+    
+    /* complete bytes */
+    while( len >= 8 )
+    {
+      *ptr |= or_mask;
+      *ptr ^= xor_mask;
+      ptr++;
+      len -= 8;
+    }
+    
+    /* last byte: len pixel from the left edge of the byte */
+    if ( len != 0 )
+    {
+      mask = ~(uint8_t)(255 >> len);
+      *ptr |= mask & or_mask;
+      *ptr ^= mask & xor_mask;
+    }
   }
   else
   {
+    mask = 128;
+    mask >>= bit_pos;
+    or_mask &= mask;
+    xor_mask &= mask;
     do
     {
-      if ( u8g2->draw_color <= 1 )
-	*ptr |= mask;
-      if ( u8g2->draw_color != 1 )
-	*ptr ^= mask;
+      *ptr |= or_mask;
+      *ptr ^= xor_mask;
       
       ptr += tile_width;
       //y++;
-      len--;
-    } while( len != 0 );
+      cnt--;
+    } while( cnt != 0 );
   }
 }
 
@@ -353,7 +399,7 @@ void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_
 /*
   x,y position within the buffer
 */
-static void u8g2_draw_pixel_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y)
+static void u8g2_draw_pixel_horizontal_right_lsb(u8g2_t *u8g2, u8g2_buf_uint_t x, u8g2_buf_uint_t y)
 {
   uint16_t offset;
   uint8_t *ptr;
@@ -395,14 +441,15 @@ static void u8g2_draw_pixel_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8
 */
 void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
 {
+  u8g2_buf_uint_t cnt = len;
   if ( dir == 0 )
   {
     do
     {
       u8g2_draw_pixel_horizontal_right_lsb(u8g2, x, y);
       x++;
-      len--;
-    } while( len != 0 );
+      cnt--;
+    } while( cnt != 0 );
   }
   else
   {
@@ -410,9 +457,106 @@ void u8g2_ll_hvline_horizontal_right_lsb(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_
     {
       u8g2_draw_pixel_horizontal_right_lsb(u8g2, x, y);
       y++;
-      len--;
-    } while( len != 0 );
+      cnt--;
+    } while( cnt != 0 );
   }
 }
 
 #endif /* U8G2_HVLINE_SPEED_OPTIMIZATION */
+
+/*=================================================*/
+/*
+  u8g2_ll_hvline_horizontal_gray4
+    SSD1322, SSD1325, SSD1327
+    
+  4 bit per pixel, two pixel per byte, the upper nibble is the left pixel.
+  Each pixel line has tile_width*4 bytes, so one tile row of the buffer
+  is sent with U8X8_MSG_DISPLAY_DRAW_GRAY_TILE without any conversion.
+  
+  The value of a pixel is u8g2->gray_level for draw color 1:
+
+  *ptr &= and_mask
+  *ptr ^= xor_mask
+  
+  color = 0:   and_mask = ~mask, xor_mask = 0
+  color = 1:   and_mask = ~mask, xor_mask = gray_level (nibble at mask)
+  color = 2:   and_mask = 0xff,  xor_mask = gray_level (nibble at mask)
+
+  A horizontal line writes two pixel per byte. No separate version
+  for U8G2_HVLINE_SPEED_OPTIMIZATION.
+*/
+
+void u8g2_ll_hvline_horizontal_gray4(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir)
+{
+  u8g2_uint_t cnt = len;
+  uint16_t offset;
+  uint16_t line_width;
+  uint8_t *ptr;
+  uint8_t value;
+  uint8_t mask;
+  uint8_t and_mask;
+
+  line_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  line_width *= 4;
+
+  /* gray level in both nibbles */
+  value = 0;
+  if ( u8g2->draw_color != 0 )
+    value = u8g2->gray_level * 0x011;
+  
+  offset = y;		/* y might be 8 or 16 bit, but we need 16 bit, so use a 16 bit variable */
+  offset *= line_width;
+  offset += x>>1;
+  ptr = u8g2->tile_buf_ptr;
+  ptr += offset;
+  
+  mask = 0x0f0;
+  if ( x & 1 )
+    mask = 0x00f;
+  
+  if ( dir == 0 )
+  {
+    if ( mask == 0x00f )
+    {
+      /* first pixel is the right pixel of a byte */
+      if ( u8g2->draw_color != 2 )
+	*ptr &= 0x0f0;
+      *ptr ^= value & 0x00f;
+      ptr++;
+      cnt--;
+    }
+    
+    and_mask = 0;
+    if ( u8g2->draw_color == 2 )
+      and_mask = 0x0ff;
+    while( cnt >= 2 )
+    {
+      *ptr &= and_mask;
+      *ptr ^= value;
+      ptr++;
+      cnt -= 2;
+    }
+    
+    if ( cnt != 0 )
+    {
+      /* last pixel is the left pixel of a byte */
+      if ( u8g2->draw_color != 2 )
+	*ptr &= 0x00f;
+      *ptr ^= value & 0x0f0;
+    }
+  }
+  else
+  {
+    and_mask = 0x0ff;
+    if ( u8g2->draw_color != 2 )
+      and_mask = ~mask;
+    value &= mask;
+    do
+    {
+      *ptr &= and_mask;
+      *ptr ^= value;
+      ptr += line_width;
+      cnt--;
+    } while( cnt != 0 );
+  }
+}
@@ -170,7 +170,7 @@ uint8_t u8g2_UserInterfaceMessage(u8g2_t *u8g2, const char *title1, const char *
 	  
       for(;;)
       {
-	    event = u8x8_GetMenuEvent(u8g2_GetU8x8(u8g2));
+	    event = u8x8_WaitMenuEvent(u8g2_GetU8x8(u8g2));
 	    if ( event == U8X8_MSG_GPIO_MENU_SELECT )
 	      return cursor+1;
 	    else if ( event == U8X8_MSG_GPIO_MENU_HOME )
@@ -1,26 +1,176 @@
 /*
 
-  u8g22_polygon.c
+  u8g2_polygon.c
 
-*/	
+  Scan line polygon fill with an active edge table.
 
+  1. All edges, except horizontal edges, are sorted by their first
+     scan line (edge table).
+  2. For each scan line, the edges which start at this scan line are
+     added to the active edge list and the edges which end at this scan
+     line are removed. The active edge list is sorted by x.
+  3. The area between the first and second, third and fourth, ... active
+     edge is filled (even-odd rule).
 
-#include "u8g2.h"
+  Any number of points is supported, the caller provides the memory for
+  the edges. No static variables are used.
+
+  Only the scan lines within the current page are calculated. The
+  horizontal spans are clipped against the user clip box and passed
+  directly to u8g2_DrawHVLine(), so no further intersection test is required.
+
+  A pixel is set, if its upper left corner is inside the polygon.
 
+  u8g2_DrawPolygon() and u8g2_DrawTriangle() keep the original convex 
+  polygon algorithm below, so that their pixel output does not change: 
+  Two Bresenham edges walk down the left and right side of the polygon, 
+  the first scan line of a pointed top and the last scan line are not 
+  drawn and the right edge is excluded.
 
+*/
 
 
+#include "u8g2.h"
+
 /*===========================================*/
 /* local definitions */
 
 typedef int16_t pg_word_t;
 
+/* end of the active edge list */
+#define PG_END 0xffff
 
-struct pg_point_struct
+/* x position of the pixel at or right of the 16.16 fixed point value */
+static pg_word_t pg_ceil(int32_t x)
 {
-  pg_word_t x;
-  pg_word_t y;
-};
+  x += 0x0ffffL;
+  x >>= 16;
+  return (pg_word_t)x;
+}
+
+/*
+  x position of an edge from (x0, 0) to (x0+dx, dy) at scan line y (0 <= y < dy),
+  16.16 fixed point, rounded down. The products do not fit into 32 bit, 
+  the result does.
+*/
+static int32_t pg_x_at(int32_t x0, int32_t dx, int32_t dy, int32_t y)
+{
+  int64_t n;
+  int64_t q;
+  n = (int64_t)dx * 65536 * y;
+  q = n / dy;
+  if ( n % dy < 0 )
+    q--;
+  return (int32_t)((int64_t)x0 * 65536 + q);
+}
+
+/*
+  x increment per scan line, 16.16 fixed point, rounded down, so that the 
+  computed x position is never right of the exact position. An edge with 
+  dy = 1 is not advanced (see u8g2_DrawPolygonList), the increment is 
+  not required. For dy >= 2 the increment fits into 32 bit.
+*/
+static int32_t pg_slope(int32_t dx, int32_t dy)
+{
+  if ( dy < 2 )
+    return 0;
+  return pg_x_at(0, dx, dy, 1);
+}
+
+/*===========================================*/
+/* edge table */
+
+/* 
+  returns the number of edges, edges are sorted by y0 
+  Edges which start above y_top (first scan line of the page) start at y_top. 
+  The x position at y_top is calculated exactly, adding dx for each 
+  scan line would accumulate the rounding error.
+*/
+static uint16_t pg_build_edge_table(const u8g2_pg_point_t *list, uint16_t cnt, u8g2_pg_edge_t *edges, pg_word_t y_top)
+{
+  const u8g2_pg_point_t *p1, *p2, *t;
+  u8g2_pg_edge_t e;
+  uint16_t i, j, edge_cnt;
+
+  edge_cnt = 0;
+  for( i = 0; i < cnt; i++ )
+  {
+    p1 = list+i;
+    p2 = list;
+    if ( i+1 < cnt )
+      p2 = list+i+1;
+
+    /* horizontal edges do not contribute to the scan line crossings */
+    if ( p1->y == p2->y )
+      continue;
+    if ( p1->y > p2->y )
+    {
+      t = p1;
+      p1 = p2;
+      p2 = t;
+    }
+
+    e.y0 = p1->y;
+    e.y1 = p2->y;
+    e.x = (int32_t)p1->x * 65536L;
+    e.dx = pg_slope(p2->x - p1->x, p2->y - p1->y);
+    e.next = PG_END;
+    if ( e.y0 < y_top && e.y1 > y_top )
+    {
+      e.x = pg_x_at(p1->x, p2->x - p1->x, p2->y - p1->y, y_top - e.y0);
+      e.y0 = y_top;
+    }
+
+    /* insertion sort by y0 */
+    j = edge_cnt;
+    while( j > 0 && edges[j-1].y0 > e.y0 )
+    {
+      edges[j] = edges[j-1];
+      j--;
+    }
+    edges[j] = e;
+    edge_cnt++;
+  }
+  return edge_cnt;
+}
+
+/*===========================================*/
+/* active edge list */
+
+/*
+  Remove all edges, which end before scan line y and sort
+  the remaining edges by x. The list is almost sorted, so
+  insertion sort is fast enough.
+*/
+static uint16_t pg_update_active_list(u8g2_pg_edge_t *edges, uint16_t active, pg_word_t y)
+{
+  uint16_t sorted = PG_END;
+  uint16_t i, next;
+  uint16_t *pos;
+
+  while( active != PG_END )
+  {
+    i = active;
+    active = edges[i].next;
+    if ( edges[i].y1 <= y )
+      continue;
+
+    pos = &sorted;
+    while( *pos != PG_END && edges[*pos].x < edges[i].x )
+      pos = &(edges[*pos].next);
+    next = *pos;
+    edges[i].next = next;
+    *pos = i;
+  }
+  return sorted;
+}
+
+/*===========================================*/
+/* convex polygon algorithm (u8g2_DrawPolygon, u8g2_DrawTriangle) */
+
+/* index numbers for the pge structures below */
+#define PG_LEFT 0
+#define PG_RIGHT 1
 
 typedef struct _pg_struct pg_struct;	/* forward declaration */
 
@@ -42,28 +192,16 @@ struct pg_edge_struct
   uint8_t curr_idx;
 };
 
-/* maximum number of points in the polygon */
-/* can be redefined, but highest possible value is 254 */
-#define PG_MAX_POINTS 6
-
-/* index numbers for the pge structures below */
-#define PG_LEFT 0
-#define PG_RIGHT 1
-
-
 struct _pg_struct
 {
-  struct pg_point_struct list[PG_MAX_POINTS];
+  const u8g2_pg_point_t *list;
   uint8_t cnt;
   uint8_t is_min_y_not_flat;
   pg_word_t total_scan_line_cnt;
   struct pg_edge_struct pge[2];	/* left and right line draw structures */
 };
 
-
-/*===========================================*/
 /* procedures, which should not be inlined (save as much flash ROM as possible */
-
 #define PG_NOINLINE U8G2_NOINLINE
 
 static uint8_t pge_Next(struct pg_edge_struct *pge) PG_NOINLINE;
@@ -72,9 +210,6 @@ static uint8_t pg_dec(pg_struct *pg, uint8_t i) PG_NOINLINE;
 static void pg_expand_min_y(pg_struct *pg, pg_word_t min_y, uint8_t pge_idx) PG_NOINLINE;
 static void pg_line_init(pg_struct * const pg, uint8_t pge_index) PG_NOINLINE;
 
-/*===========================================*/
-/* line draw algorithm */
-
 static uint8_t pge_Next(struct pg_edge_struct *pge)
 {
   if ( pge->current_y >= pge->max_y )
@@ -120,9 +255,6 @@ static void pge_Init(struct pg_edge_struct *pge, pg_word_t x1, pg_word_t y1, pg_
   pge->error_offset = width % pge->height;
 }
 
-/*===========================================*/
-/* convex polygon algorithm */
-
 static uint8_t pg_inc(pg_struct *pg, uint8_t i)
 {
     i++;
@@ -216,7 +348,7 @@ static void pg_hline(pg_struct *pg, u8g2_t *u8g2)
   
   if ( y < 0 )
     return;
-  if ( y >= u8g2_GetDisplayHeight(u8g2) )  // does not work for 256x64 display???
+  if ( y >= u8g2_GetDisplayHeight(u8g2) )
     return;
   if ( x1 < x2 )
   {
@@ -237,7 +369,7 @@ static void pg_hline(pg_struct *pg, u8g2_t *u8g2)
     if ( x2 >= u8g2_GetDisplayWidth(u8g2) )
       return;
     if ( x2 < 0 )
-      x1 = 0;
+      x2 = 0;
     if ( x1 >= u8g2_GetDisplayWidth(u8g2) )
       x1 = u8g2_GetDisplayWidth(u8g2);
     u8g2_DrawHLine(u8g2, x2, y, x1 - x2);
@@ -293,54 +425,136 @@ static void pg_exec(pg_struct *pg, u8g2_t *u8g2)
   } while( i > 0 );
 }
 
+static void pg_DrawConvexPolygon(u8g2_t *u8g2, const u8g2_pg_point_t *list, uint8_t cnt)
+{
+  pg_struct pg;
+  
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_POLYGON);
+  if ( cnt == 0 )
+    return;
+  pg.list = list;
+  pg.cnt = cnt;
+  if ( pg_prepare(&pg) == 0 )
+    return;
+  pg_exec(&pg, u8g2);
+}
+
 /*===========================================*/
 /* API procedures */
 
-void pg_ClearPolygonXY(pg_struct *pg)
+/*
+  Fill the polygon with the points list[0] ... list[cnt-1]
+  edges:	Memory for cnt edges, only used during this call.
+*/
+void u8g2_DrawPolygonList(u8g2_t *u8g2, const u8g2_pg_point_t *list, uint16_t cnt, u8g2_pg_edge_t *edges)
 {
-  pg->cnt = 0;
-}
+  uint16_t edge_cnt;
+  uint16_t next_edge;
+  uint16_t active;
+  uint16_t i;
+  pg_word_t y, y_end;
+  pg_word_t x0, x1;
+  pg_word_t clip_x0, clip_x1;
+  u8g2_span_batch_t batch;
+
+  U8G2_PROFILE_PRIM(u8g2, U8G2_PROFILE_PRIM_POLYGON);
+  if ( cnt < 3 )
+    return;
+  edge_cnt = pg_build_edge_table(list, cnt, edges, (pg_word_t)u8g2->user_y0);
+  if ( edge_cnt == 0 )
+    return;
 
-void pg_AddPolygonXY(pg_struct *pg, int16_t x, int16_t y)
-{
-  if ( pg->cnt < PG_MAX_POINTS )
+  /* scan line range: intersection of the polygon and the current page */
+  y = edges[0].y0;
+  y_end = y;
+  for( i = 0; i < edge_cnt; i++ )
+    if ( y_end < edges[i].y1 )
+      y_end = edges[i].y1;
+  if ( y < (pg_word_t)u8g2->user_y0 )
+    y = (pg_word_t)u8g2->user_y0;
+  if ( y_end > (pg_word_t)u8g2->user_y1 )
+    y_end = (pg_word_t)u8g2->user_y1;
+
+  clip_x0 = (pg_word_t)u8g2->user_x0;
+  clip_x1 = (pg_word_t)u8g2->user_x1;
+
+  u8g2_InitSpanBatch(u8g2, &batch, 0);
+  next_edge = 0;
+  active = PG_END;
+  while( y < y_end )
   {
-    pg->list[pg->cnt].x = x;
-    pg->list[pg->cnt].y = y;
-    pg->cnt++;
-  }
-}
+    /* move edges, which start at or above this scan line, to the active list */
+    while( next_edge < edge_cnt && edges[next_edge].y0 <= y )
+    {
+      if ( edges[next_edge].y1 > y )
+      {
+	edges[next_edge].next = active;
+	active = next_edge;
+      }
+      next_edge++;
+    }
 
-void pg_DrawPolygon(pg_struct *pg, u8g2_t *u8g2)
-{
-  if ( pg_prepare(pg) == 0 )
-    return;
-  pg_exec(pg, u8g2);
+    active = pg_update_active_list(edges, active, y);
+
+    /* fill the spans between pairs of edges */
+    i = active;
+    while( i != PG_END && edges[i].next != PG_END )
+    {
+      x0 = pg_ceil(edges[i].x);
+      i = edges[i].next;
+      x1 = pg_ceil(edges[i].x);
+      i = edges[i].next;
+
+      if ( x0 < clip_x0 )
+	x0 = clip_x0;
+      if ( x1 > clip_x1 )
+	x1 = clip_x1;
+      if ( x0 < x1 )
+	u8g2_AddSpan(u8g2, &batch, x0, y, x1-x0);
+    }
+
+    /* advance the active edges to the next scan line, edges which end here are removed anyway */
+    for( i = active; i != PG_END; i = edges[i].next )
+      if ( edges[i].y1 > y+1 )
+	edges[i].x += edges[i].dx;
+
+    y++;
+  }
+  u8g2_FlushSpanBatch(u8g2, &batch);
 }
 
-pg_struct u8g2_pg;
+/* points for u8g2_AddPolygonXY() and u8g2_DrawPolygon() */
+static u8g2_pg_point_t u8g2_pg_list[U8G2_PG_MAX_POINTS];
+static uint8_t u8g2_pg_cnt;
 
 void u8g2_ClearPolygonXY(void)
 {
-  pg_ClearPolygonXY(&u8g2_pg);
+  u8g2_pg_cnt = 0;
 }
 
 void u8g2_AddPolygonXY(U8X8_UNUSED u8g2_t *u8g2, int16_t x, int16_t y)
 {
-  pg_AddPolygonXY(&u8g2_pg, x, y);
+  if ( u8g2_pg_cnt < U8G2_PG_MAX_POINTS )
+  {
+    u8g2_pg_list[u8g2_pg_cnt].x = x;
+    u8g2_pg_list[u8g2_pg_cnt].y = y;
+    u8g2_pg_cnt++;
+  }
 }
 
 void u8g2_DrawPolygon(u8g2_t *u8g2)
 {
-  pg_DrawPolygon(&u8g2_pg, u8g2);
+  pg_DrawConvexPolygon(u8g2, u8g2_pg_list, u8g2_pg_cnt);
 }
 
 void u8g2_DrawTriangle(u8g2_t *u8g2, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2)
 {
-  u8g2_ClearPolygonXY();
-  u8g2_AddPolygonXY(u8g2, x0, y0);
-  u8g2_AddPolygonXY(u8g2, x1, y1);
-  u8g2_AddPolygonXY(u8g2, x2, y2);
-  u8g2_DrawPolygon(u8g2);
+  u8g2_pg_point_t list[3];
+  list[0].x = x0;
+  list[0].y = y0;
+  list[1].x = x1;
+  list[1].y = y1;
+  list[2].x = x2;
+  list[2].y = y2;
+  pg_DrawConvexPolygon(u8g2, list, 3);
 }
-
@@ -0,0 +1,226 @@
+/* 
+
+  u8g2_profile.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  Profiler, enabled with U8G2_WITH_PROFILE in u8g2.h
+
+  The draw procedures count into u8g2->profile (U8G2_PROFILE_PRIM, 
+  U8G2_PROFILE_ADD). The display, cad and byte callbacks of the u8x8 
+  structure are replaced by the procedures below, which count the 
+  messages and bytes and then call the original callback.
+  
+  Each frame ends with the last page of u8g2_NextPage() or with 
+  u8g2_SendBuffer(). Then the frame callback is called (e.g. to print
+  the counters) and the counters are cleared.
+  
+*/
+
+#include "u8g2.h"
+
+#ifdef U8G2_WITH_PROFILE
+
+#include <stdio.h>
+#include <string.h>
+
+static void u8g2_profile_msg(u8g2_t *u8g2, uint8_t layer, uint8_t msg, uint32_t bytes)
+{
+  u8g2_profile_msg_t *m;
+  if ( msg >= U8G2_PROFILE_MSG_CNT )
+    return;
+  m = &(u8g2->profile->counter.msg_list[layer][msg]);
+  m->cnt++;
+  m->bytes += bytes;
+}
+
+static uint8_t u8g2_profile_display_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8g2_t *u8g2 = (u8g2_t *)u8x8;
+  uint32_t bytes = 0;
+  if ( msg == U8X8_MSG_DISPLAY_DRAW_TILE )
+    bytes = (uint32_t)((u8x8_tile_t *)arg_ptr)->cnt * arg_int * 8;
+  else if ( msg == U8X8_MSG_DISPLAY_DRAW_GRAY_TILE )
+    bytes = (uint32_t)((u8x8_tile_t *)arg_ptr)->cnt * arg_int * 32;
+  else if ( msg == U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK )
+    bytes = (uint32_t)((u8x8_tile_t *)arg_ptr)->cnt * arg_int * 8;
+  u8g2_profile_msg(u8g2, U8G2_PROFILE_LAYER_DISPLAY, msg, bytes);
+  return u8g2->profile->display_cb(u8x8, msg, arg_int, arg_ptr);
+}
+
+static uint8_t u8g2_profile_cad_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8g2_t *u8g2 = (u8g2_t *)u8x8;
+  uint32_t bytes = 0;
+  if ( msg == U8X8_MSG_CAD_SEND_CMD || msg == U8X8_MSG_CAD_SEND_ARG )
+    bytes = 1;
+  else if ( msg == U8X8_MSG_CAD_SEND_DATA )
+    bytes = arg_int;
+  u8g2_profile_msg(u8g2, U8G2_PROFILE_LAYER_CAD, msg, bytes);
+  return u8g2->profile->cad_cb(u8x8, msg, arg_int, arg_ptr);
+}
+
+static uint8_t u8g2_profile_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8g2_t *u8g2 = (u8g2_t *)u8x8;
+  u8g2_profile_msg(u8g2, U8G2_PROFILE_LAYER_BYTE, msg, msg == U8X8_MSG_BYTE_SEND ? arg_int : 0);
+  return u8g2->profile->byte_cb(u8x8, msg, arg_int, arg_ptr);
+}
+
+void u8g2_ClearProfile(u8g2_profile_t *profile)
+{
+  memset(&(profile->counter), 0, sizeof(u8g2_profile_counter_t));
+  profile->frame_cnt = 0;
+  profile->phase = U8G2_PROFILE_PHASE_DRAW;
+  if ( profile->get_cycles != NULL )
+    profile->last_cycles = profile->get_cycles();
+}
+
+void u8g2_SetProfile(u8g2_t *u8g2, u8g2_profile_t *profile)
+{
+  u8x8_t *u8x8 = u8g2_GetU8x8(u8g2);
+  
+  /* restore the callbacks of the previous profile */
+  if ( u8g2->profile != NULL )
+  {
+    u8x8->display_cb = u8g2->profile->display_cb;
+    u8x8->cad_cb = u8g2->profile->cad_cb;
+    u8x8->byte_cb = u8g2->profile->byte_cb;
+  }
+  u8g2->profile = profile;
+  if ( profile == NULL )
+    return;
+  
+  u8g2_ClearProfile(profile);
+  profile->display_cb = u8x8->display_cb;
+  profile->cad_cb = u8x8->cad_cb;
+  profile->byte_cb = u8x8->byte_cb;
+  u8x8->display_cb = u8g2_profile_display_cb;
+  u8x8->cad_cb = u8g2_profile_cad_cb;
+  u8x8->byte_cb = u8g2_profile_byte_cb;
+}
+
+/* assign the time since the last call to the current phase and start the new phase */
+void u8g2_profile_phase(u8g2_t *u8g2, uint8_t phase)
+{
+  u8g2_profile_t *profile = u8g2->profile;
+  uint32_t c;
+  if ( profile->get_cycles != NULL )
+  {
+    c = profile->get_cycles();
+    profile->counter.cycles[profile->phase] += c - profile->last_cycles;
+    profile->last_cycles = c;
+  }
+  profile->phase = phase;
+}
+
+void u8g2_profile_end_frame(u8g2_t *u8g2)
+{
+  u8g2_profile_t *profile = u8g2->profile;
+  u8g2_profile_phase(u8g2, U8G2_PROFILE_PHASE_DRAW);
+  profile->frame_cnt++;
+  if ( profile->frame_cb != NULL )
+    profile->frame_cb(u8g2, profile);
+  memset(&(profile->counter), 0, sizeof(u8g2_profile_counter_t));
+  /* the time of the frame callback is not counted */
+  if ( profile->get_cycles != NULL )
+    profile->last_cycles = profile->get_cycles();
+}
+
+static const char *u8g2_profile_msg_name(uint8_t layer, uint8_t msg)
+{
+  if ( layer == U8G2_PROFILE_LAYER_DISPLAY )
+  {
+    switch(msg)
+    {
+      case U8X8_MSG_DISPLAY_SETUP_MEMORY: return "DISPLAY_SETUP_MEMORY";
+      case U8X8_MSG_DISPLAY_INIT: return "DISPLAY_INIT";
+      case U8X8_MSG_DISPLAY_SET_POWER_SAVE: return "DISPLAY_SET_POWER_SAVE";
+      case U8X8_MSG_DISPLAY_SET_FLIP_MODE: return "DISPLAY_SET_FLIP_MODE";
+      case U8X8_MSG_DISPLAY_SET_CONTRAST: return "DISPLAY_SET_CONTRAST";
+      case U8X8_MSG_DISPLAY_DRAW_TILE: return "DISPLAY_DRAW_TILE";
+      case U8X8_MSG_DISPLAY_REFRESH: return "DISPLAY_REFRESH";
+      case U8X8_MSG_DISPLAY_SET_START_LINE: return "DISPLAY_SET_START_LINE";
+      case U8X8_MSG_DISPLAY_DRAW_GRAY_TILE: return "DISPLAY_DRAW_GRAY_TILE";
+      case U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK: return "DISPLAY_DRAW_TILE_BLOCK";
+      case U8X8_MSG_DISPLAY_POLL_REFRESH: return "DISPLAY_POLL_REFRESH";
+    }
+    return "DISPLAY_?";
+  }
+  switch(msg)
+  {
+    case U8X8_MSG_CAD_INIT: return layer == U8G2_PROFILE_LAYER_CAD ? "CAD_INIT" : "BYTE_INIT";
+    case U8X8_MSG_CAD_SEND_CMD: return "CAD_SEND_CMD";
+    case U8X8_MSG_CAD_SEND_ARG: return "CAD_SEND_ARG";
+    case U8X8_MSG_CAD_SEND_DATA: return layer == U8G2_PROFILE_LAYER_CAD ? "CAD_SEND_DATA" : "BYTE_SEND";
+    case U8X8_MSG_CAD_START_TRANSFER: return layer == U8G2_PROFILE_LAYER_CAD ? "CAD_START_TRANSFER" : "BYTE_START_TRANSFER";
+    case U8X8_MSG_CAD_END_TRANSFER: return layer == U8G2_PROFILE_LAYER_CAD ? "CAD_END_TRANSFER" : "BYTE_END_TRANSFER";
+    case U8X8_MSG_BYTE_SET_DC: return "BYTE_SET_DC";
+    case U8X8_MSG_BYTE_XFER_SUBMIT: return "BYTE_XFER_SUBMIT";
+    case U8X8_MSG_BYTE_XFER_POLL: return "BYTE_XFER_POLL";
+  }
+  return layer == U8G2_PROFILE_LAYER_CAD ? "CAD_?" : "BYTE_?";
+}
+
+void u8g2_PrintProfile(u8g2_profile_t *profile)
+{
+  static const char *prim_name[U8G2_PROFILE_PRIM_CNT] = 
+    { "line", "box", "frame", "circle", "ellipse", "polygon", "bitmap", "glyph" };
+  u8g2_profile_counter_t *c = &(profile->counter);
+  uint32_t total;
+  uint8_t i, layer;
+  
+  printf("frame %lu\n", (unsigned long)profile->frame_cnt);
+  if ( profile->get_cycles != NULL )
+  {
+    total = c->cycles[U8G2_PROFILE_PHASE_DRAW] + c->cycles[U8G2_PROFILE_PHASE_CLEAR] + c->cycles[U8G2_PROFILE_PHASE_SEND];
+    if ( total == 0 )
+      total = 1;
+    printf("  cycles: draw %lu (%lu%%), clear %lu (%lu%%), send %lu (%lu%%)\n",
+      (unsigned long)c->cycles[U8G2_PROFILE_PHASE_DRAW], (unsigned long)((uint64_t)c->cycles[U8G2_PROFILE_PHASE_DRAW]*100/total),
+      (unsigned long)c->cycles[U8G2_PROFILE_PHASE_CLEAR], (unsigned long)((uint64_t)c->cycles[U8G2_PROFILE_PHASE_CLEAR]*100/total),
+      (unsigned long)c->cycles[U8G2_PROFILE_PHASE_SEND], (unsigned long)((uint64_t)c->cycles[U8G2_PROFILE_PHASE_SEND]*100/total));
+  }
+  printf("  primitives:");
+  for( i = 0; i < U8G2_PROFILE_PRIM_CNT; i++ )
+    if ( c->prim_cnt[i] != 0 )
+      printf(" %s %lu", prim_name[i], (unsigned long)c->prim_cnt[i]);
+  printf("\n");
+  printf("  spans %lu, rejected %lu, pixel %lu, glyphs %lu\n", 
+    (unsigned long)c->span_cnt, (unsigned long)c->span_reject_cnt, 
+    (unsigned long)c->pixel_cnt, (unsigned long)c->glyph_cnt);
+  for( layer = 0; layer < 3; layer++ )
+    for( i = 0; i < U8G2_PROFILE_MSG_CNT; i++ )
+      if ( c->msg_list[layer][i].cnt != 0 )
+	printf("  %-24s %8lu calls %8lu bytes\n", u8g2_profile_msg_name(layer, i), 
+	  (unsigned long)c->msg_list[layer][i].cnt, (unsigned long)c->msg_list[layer][i].bytes);
+}
+
+#endif /* U8G2_WITH_PROFILE */
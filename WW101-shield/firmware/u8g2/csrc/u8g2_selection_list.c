@@ -264,7 +264,7 @@ uint8_t u8g2_UserInterfaceSelectionList(u8g2_t *u8g2, const char *title, uint8_t
 
       for(;;)
       {
-        event = u8x8_GetMenuEvent(u8g2_GetU8x8(u8g2));
+        event = u8x8_WaitMenuEvent(u8g2_GetU8x8(u8g2));
         if ( event == U8X8_MSG_GPIO_MENU_SELECT )
           return u8sl.current_pos+1;		/* +1, issue 112 */
         else if ( event == U8X8_MSG_GPIO_MENU_HOME )
@@ -55,8 +55,22 @@ void u8g2_SetupBuffer(u8g2_t *u8g2, uint8_t *buf, uint8_t tile_buf_height, u8g2_
   
   u8g2->tile_curr_row = 0;
   u8g2->draw_color = 1;
+  u8g2->gray_level = 15;
   u8g2->is_auto_page_clear = 1;
   
+#ifdef U8G2_WITH_FRAME_DIFF
+  u8g2_SetShadowBuffer(u8g2, NULL);
+#endif
+#ifdef U8G2_WITH_PROFILE
+  u8g2->profile = NULL;
+#endif
+#ifdef U8G2_WITH_DISPLAY_LIST
+  u8g2_SetDisplayList(u8g2, NULL, 0);
+#endif
+#ifdef U8G2_WITH_DOUBLE_BUFFER
+  u8g2_SetBackBuffer(u8g2, NULL);
+#endif
+  
   u8g2->cb = u8g2_cb;
   u8g2->cb->update(u8g2);
 
@@ -92,7 +106,16 @@ static void u8g2_update_dimension_common(u8g2_t *u8g2)
 {
   u8g2_uint_t t;
   
+  /* the buffer dimension must fit into u8g2_uint_t (8 Bit mode) and into */
+  /* u8g2_buf_uint_t (U8G2_8BIT_BUFFER), pixel outside this area are clipped */
   t = u8g2->tile_buf_height;
+#ifndef U8G2_16BIT
+  if ( t >= 32 )
+    t = 31;
+#elif defined(U8G2_8BIT_BUFFER)
+  if ( t >= 32 )
+    t = 32;
+#endif
   t *= 8;
   u8g2->pixel_buf_height = t;
   
@@ -100,6 +123,9 @@ static void u8g2_update_dimension_common(u8g2_t *u8g2)
 #ifndef U8G2_16BIT
   if ( t >= 32 )
     t = 31;
+#elif defined(U8G2_8BIT_BUFFER)
+  if ( t >= 32 )
+    t = 32;
 #endif
   t *= 8;
   u8g2->pixel_buf_width = t;
@@ -126,7 +152,9 @@ static void u8g2_update_dimension_common(u8g2_t *u8g2)
   u8g2->width = 240;
   if ( u8g2_GetU8x8(u8g2)->display_info->pixel_width <= 240 )
     u8g2->width = u8g2_GetU8x8(u8g2)->display_info->pixel_width;
-  u8g2->height = u8g2_GetU8x8(u8g2)->display_info->pixel_height;
+  u8g2->height = 240;
+  if ( u8g2_GetU8x8(u8g2)->display_info->pixel_height <= 240 )
+    u8g2->height = u8g2_GetU8x8(u8g2)->display_info->pixel_height;
 #endif
 
 }
@@ -147,10 +175,14 @@ void u8g2_update_dimension_r0(u8g2_t *u8g2)
 
 void u8g2_update_dimension_r1(u8g2_t *u8g2)
 {
+  u8g2_uint_t t;
+  
   u8g2_update_dimension_common(u8g2);
   
-  u8g2->height = u8g2_GetU8x8(u8g2)->display_info->pixel_width;
-  u8g2->width = u8g2_GetU8x8(u8g2)->display_info->pixel_height;
+  /* swap width and height, use the limited values from u8g2_update_dimension_common() */
+  t = u8g2->height;
+  u8g2->height = u8g2->width;
+  u8g2->width = t;
   
   u8g2->user_x0 = u8g2->buf_y0;
   u8g2->user_x1 = u8g2->buf_y1;
@@ -178,10 +210,14 @@ void u8g2_update_dimension_r2(u8g2_t *u8g2)
 
 void u8g2_update_dimension_r3(u8g2_t *u8g2)
 {
+  u8g2_uint_t t;
+  
   u8g2_update_dimension_common(u8g2);
   
-  u8g2->height = u8g2_GetU8x8(u8g2)->display_info->pixel_width;
-  u8g2->width = u8g2_GetU8x8(u8g2)->display_info->pixel_height;
+  /* swap width and height, use the limited values from u8g2_update_dimension_common() */
+  t = u8g2->height;
+  u8g2->height = u8g2->width;
+  u8g2->width = t;
 
   u8g2->user_x0 = u8g2->width - u8g2->buf_y1;
   u8g2->user_x1 = u8g2->width - u8g2->buf_y0;
@@ -0,0 +1,170 @@
+/* 
+
+  u8g2_span.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  Span batch: Collect horizontal or vertical lines of one graphics
+  primitive (e.g. the lines of a disc) and draw them together.
+
+  u8g2_AddSpan() clips the line against the user box. Lines outside the
+  current page are dropped at this point, so u8g2_IsIntersection() is 
+  not required for the single line. u8g2_FlushSpanBatch() draws all
+  collected lines. For U8G2_R0, the user box is identical to the
+  page buffer and the lines are passed directly to the ll_hvline 
+  procedure. All other rotations use the draw_l90 callback.
+
+  Usage:
+    u8g2_span_batch_t batch;
+    u8g2_InitSpanBatch(u8g2, &batch, 1);
+    u8g2_AddSpan(u8g2, &batch, x, y, len);
+    ...
+    u8g2_FlushSpanBatch(u8g2, &batch);
+  
+*/
+
+#include "u8g2.h"
+
+/*
+  clip the range a (included) to a+len (excluded) against c (included) to d (excluded)
+  a+len may wrap around (negative a or a line which exceeds the range of u8g2_uint_t)
+  returns 0 if there is no intersection
+*/
+static uint8_t u8g2_span_clip(u8g2_uint_t *ap, u8g2_uint_t *lenp, u8g2_uint_t c, u8g2_uint_t d)
+{
+  u8g2_uint_t a = *ap;
+  u8g2_uint_t b = a;
+  b += *lenp;
+  
+  if ( a > b )
+  {
+    if ( a < d )
+      b = d;		/* the end has wrapped around */
+    else
+      a = 0;		/* the start is negative */
+  }
+  if ( a < c )
+    a = c;
+  if ( b > d )
+    b = d;
+  if ( a >= b )
+    return 0;
+  *ap = a;
+  *lenp = b - a;
+  return 1;
+}
+
+void u8g2_InitSpanBatch(u8g2_t *u8g2, u8g2_span_batch_t *batch, uint8_t dir)
+{
+  batch->cnt = 0;
+  batch->dir = dir;
+}
+
+/*
+  x,y		Upper left position of the line (user coordinates)
+  len		length of the line in pixel
+*/
+void u8g2_AddSpan(u8g2_t *u8g2, u8g2_span_batch_t *batch, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len)
+{
+  u8g2_span_t *s;
+  
+  if ( batch->dir == 0 )
+  {
+    if ( y < u8g2->user_y0 || y >= u8g2->user_y1 || u8g2_span_clip(&x, &len, u8g2->user_x0, u8g2->user_x1) == 0 )
+    {
+      U8G2_PROFILE_ADD(u8g2, span_reject_cnt, 1);
+      return;
+    }
+  }
+  else
+  {
+    if ( x < u8g2->user_x0 || x >= u8g2->user_x1 || u8g2_span_clip(&y, &len, u8g2->user_y0, u8g2->user_y1) == 0 )
+    {
+      U8G2_PROFILE_ADD(u8g2, span_reject_cnt, 1);
+      return;
+    }
+  }
+  
+  if ( batch->cnt >= U8G2_SPAN_BATCH_SIZE )
+    u8g2_FlushSpanBatch(u8g2, batch);
+  s = batch->list + batch->cnt;
+  s->x = x;
+  s->y = y;
+  s->len = len;
+  batch->cnt++;
+}
+
+void u8g2_FlushSpanBatch(u8g2_t *u8g2, u8g2_span_batch_t *batch)
+{
+  u8g2_span_t *s = batch->list;
+  uint8_t cnt = batch->cnt;
+  uint8_t dir = batch->dir;
+  u8g2_uint_t y_offset;
+  
+  batch->cnt = 0;
+  
+#ifdef U8G2_WITH_DISPLAY_LIST
+  /* the lines must be recorded for the other pages */
+  if ( u8g2->dl_state == U8G2_DL_STATE_RECORD )
+  {
+    while( cnt > 0 )
+    {
+      u8g2_DrawHVLine(u8g2, s->x, s->y, s->len, dir);
+      s++;
+      cnt--;
+    }
+    return;
+  }
+#endif
+
+  if ( u8g2->cb == U8G2_R0 )
+  {
+#ifdef U8G2_WITH_HVLINE_COUNT
+    u8g2->hv_cnt += cnt;
+#endif /* U8G2_WITH_HVLINE_COUNT */   
+    /* lines are already clipped against the buffer, only move them into the buffer */
+    y_offset = u8g2->pixel_curr_row;
+    while( cnt > 0 )
+    {
+      u8g2_call_ll_hvline(u8g2, s->x, s->y - y_offset, s->len, dir);
+      s++;
+      cnt--;
+    }
+  }
+  else
+  {
+    while( cnt > 0 )
+    {
+      u8g2->cb->draw_l90(u8g2, s->x, s->y, s->len, dir);
+      s++;
+      cnt--;
+    }
+  }
+}
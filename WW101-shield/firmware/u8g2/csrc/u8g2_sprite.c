@@ -0,0 +1,313 @@
+/* 
+
+  u8g2_sprite.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+
+  Layer with a static background and sprites.
+  
+  Moving a sprite marks the tiles of the old and the new position as dirty.
+  u8g2_UpdateLayer() composes the dirty tiles only: The background is 
+  copied into the u8g2 buffer and all visible sprites, which overlap 
+  the dirty tiles, are drawn on top of it. The sprites are clipped 
+  against the dirty tiles, so the other tiles of the buffer are not 
+  touched. Then the dirty tiles are sent to the display with
+  u8x8_DrawTile().
+  
+  The background has the layout and the size of a full u8g2 buffer, for
+  example the buffer of another u8g2 object with the same display, where
+  the background was drawn once. With background == NULL, the background
+  is cleared.
+  
+  Requirements:
+    - U8G2_R0: sprite and tile positions are display coordinates
+    - full buffer: with a page buffer, u8g2_UpdateLayer() falls back
+      to a complete page loop.
+  
+  With the horizontal buffer layouts (u8g2_ll_hvline_horizontal_right_lsb, 
+  u8g2_ll_hvline_horizontal_gray4), a tile is not a continuous memory 
+  area, so the complete tile row is composed and sent.
+
+*/
+
+#include "u8g2.h"
+#include <string.h>
+
+static uint8_t u8g2_layer_is_dirty(u8g2_t *u8g2, u8g2_layer_t *layer, uint8_t tx, uint8_t ty)
+{
+  uint16_t pos;
+  pos = ty;
+  pos *= u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  pos += tx;
+  return (layer->dirty[pos >> 3] >> (pos & 7)) & 1;
+}
+
+static uint16_t u8g2_layer_get_dirty_size(u8g2_t *u8g2)
+{
+  return U8G2_LAYER_DIRTY_SIZE(u8g2_GetU8x8(u8g2)->display_info->tile_width, u8g2_GetU8x8(u8g2)->display_info->tile_height);
+}
+
+/* bit of a XBM line, the lowest bit of the first byte is the left pixel */
+static uint8_t u8g2_sprite_get_bit(const uint8_t *line, uint16_t x)
+{
+  return (line[x >> 3] >> (x & 7)) & 1;
+}
+
+/*
+  Draw the part of the sprite, which is inside x0..x1-1, y0..y1-1.
+  Pixel with the same value are drawn as one horizontal line.
+*/
+static void u8g2_draw_sprite_clipped(u8g2_t *u8g2, const u8g2_sprite_t *sprite, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+  uint16_t x, y, xs, blen;
+  const uint8_t *line;
+  uint8_t v;
+  
+  if ( x0 < sprite->x )
+    x0 = sprite->x;
+  if ( y0 < sprite->y )
+    y0 = sprite->y;
+  if ( x1 > (uint16_t)sprite->x + sprite->w )
+    x1 = (uint16_t)sprite->x + sprite->w;
+  if ( y1 > (uint16_t)sprite->y + sprite->h )
+    y1 = (uint16_t)sprite->y + sprite->h;
+  if ( x0 >= x1 || y0 >= y1 )
+    return;
+  
+  blen = sprite->w;
+  blen += 7;
+  blen >>= 3;
+  
+  for( y = y0; y < y1; y++ )
+  {
+    line = sprite->bitmap + (y - sprite->y) * blen;
+    x = x0;
+    while( x < x1 )
+    {
+      xs = x;
+      v = u8g2_sprite_get_bit(line, x - sprite->x);
+      do
+      {
+	x++;
+      } while( x < x1 && u8g2_sprite_get_bit(line, x - sprite->x) == v );
+      if ( v != 0 || sprite->is_transparent == 0 )
+      {
+	u8g2->draw_color = v;
+	u8g2_DrawHVLine(u8g2, xs, y, x - xs, 0);
+      }
+    }
+  }
+}
+
+/* copy the background of the tiles tx0..tx1-1 of tile row ty into the buffer */
+static void u8g2_layer_copy_background(u8g2_t *u8g2, u8g2_layer_t *layer, uint8_t tx0, uint8_t tx1, uint8_t ty)
+{
+  uint16_t row_size;
+  uint16_t offset;
+  uint16_t cnt;
+  uint8_t tile_size;
+  uint8_t lines, bytes_per_tile;
+  
+  tile_size = u8g2_GetBufferTileSize(u8g2);
+  row_size = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  row_size *= tile_size;
+  
+  /* vertical_top_lsb: one line of 8 bytes per tile, otherwise: 8 lines */
+  lines = 1;
+  bytes_per_tile = tile_size;
+  if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+  {
+    lines = 8;
+    bytes_per_tile /= 8;
+  }
+  
+  offset = ty;
+  offset *= row_size;
+  offset += tx0 * bytes_per_tile;
+  cnt = (tx1 - tx0) * bytes_per_tile;
+  while( lines > 0 )
+  {
+    if ( layer->background == NULL )
+      memset(u8g2->tile_buf_ptr + offset, 0, cnt);
+    else
+      memcpy(u8g2->tile_buf_ptr + offset, layer->background + offset, cnt);
+    offset += row_size / 8;
+    lines--;
+  }
+}
+
+/* page buffer: draw the complete layer with the picture loop */
+static void u8g2_layer_update_pages(u8g2_t *u8g2, u8g2_layer_t *layer)
+{
+  uint8_t i;
+  u8g2_FirstPage(u8g2);
+  do
+  {
+    /* xor into the cleared page is a copy of the background */
+    u8g2_ClearBuffer(u8g2);
+    if ( layer->background != NULL )
+      u8g2_XorBuffer(u8g2, layer->background);
+    for( i = 0; i < layer->sprite_cnt; i++ )
+      if ( layer->sprite_list[i].is_visible )
+	u8g2_draw_sprite_clipped(u8g2, layer->sprite_list+i, 0, 0, 
+	  u8g2_GetU8x8(u8g2)->display_info->pixel_width, u8g2_GetU8x8(u8g2)->display_info->pixel_height);
+  } while( u8g2_NextPage(u8g2) );
+  layer->sent_tiles = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  layer->sent_tiles *= u8g2_GetU8x8(u8g2)->display_info->tile_height;
+}
+
+/*============================================*/
+
+/* all sprites must be set with u8g2_SetSprite() before, dirty must have U8G2_LAYER_DIRTY_SIZE() bytes */
+void u8g2_InitLayer(u8g2_t *u8g2, u8g2_layer_t *layer, const uint8_t *background, u8g2_sprite_t *sprite_list, uint8_t sprite_cnt, uint8_t *dirty)
+{
+  layer->background = background;
+  layer->sprite_list = sprite_list;
+  layer->sprite_cnt = sprite_cnt;
+  layer->dirty = dirty;
+  layer->sent_tiles = 0;
+  memset(dirty, 255, u8g2_layer_get_dirty_size(u8g2));
+}
+
+void u8g2_SetSprite(u8g2_sprite_t *sprite, u8g2_uint_t w, u8g2_uint_t h, const uint8_t *bitmap)
+{
+  sprite->bitmap = bitmap;
+  sprite->w = w;
+  sprite->h = h;
+  sprite->x = 0;
+  sprite->y = 0;
+  sprite->is_visible = 1;
+  sprite->is_transparent = 0;
+}
+
+/* mark all tiles of the area as dirty, e.g. after a change of the background */
+void u8g2_MarkLayerArea(u8g2_t *u8g2, u8g2_layer_t *layer, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t w, u8g2_uint_t h)
+{
+  uint16_t tx0, tx1, ty0, ty1, tx, pos;
+  uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  uint8_t tile_height = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  
+  if ( w == 0 || h == 0 )
+    return;
+  tx0 = x >> 3;
+  ty0 = y >> 3;
+  tx1 = ((uint16_t)x + w - 1) >> 3;
+  ty1 = ((uint16_t)y + h - 1) >> 3;
+  if ( tx1 >= tile_width )
+    tx1 = tile_width - 1;
+  if ( ty1 >= tile_height )
+    ty1 = tile_height - 1;
+  
+  for( ; ty0 <= ty1; ty0++ )
+  {
+    for( tx = tx0; tx <= tx1; tx++ )
+    {
+      pos = ty0 * tile_width + tx;
+      layer->dirty[pos >> 3] |= 1 << (pos & 7);
+    }
+  }
+}
+
+void u8g2_MoveSprite(u8g2_t *u8g2, u8g2_layer_t *layer, u8g2_sprite_t *sprite, u8g2_uint_t x, u8g2_uint_t y)
+{
+  if ( sprite->x == x && sprite->y == y )
+    return;
+  if ( sprite->is_visible )
+    u8g2_MarkLayerArea(u8g2, layer, sprite->x, sprite->y, sprite->w, sprite->h);
+  sprite->x = x;
+  sprite->y = y;
+  if ( sprite->is_visible )
+    u8g2_MarkLayerArea(u8g2, layer, sprite->x, sprite->y, sprite->w, sprite->h);
+}
+
+void u8g2_ShowSprite(u8g2_t *u8g2, u8g2_layer_t *layer, u8g2_sprite_t *sprite, uint8_t is_visible)
+{
+  if ( sprite->is_visible == is_visible )
+    return;
+  sprite->is_visible = is_visible;
+  u8g2_MarkLayerArea(u8g2, layer, sprite->x, sprite->y, sprite->w, sprite->h);
+}
+
+/* compose and send all dirty tiles */
+void u8g2_UpdateLayer(u8g2_t *u8g2, u8g2_layer_t *layer)
+{
+  uint8_t tile_width = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+  uint8_t tile_height = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+  uint8_t tile_size = u8g2_GetBufferTileSize(u8g2);
+  uint8_t draw_color = u8g2->draw_color;
+  uint8_t tx0, tx, ty, i;
+  uint8_t *ptr;
+  
+  layer->sent_tiles = 0;
+  if ( u8g2->tile_buf_height < tile_height )
+  {
+    u8g2_layer_update_pages(u8g2, layer);
+  }
+  else
+  {
+    for( ty = 0; ty < tile_height; ty++ )
+    {
+      tx = 0;
+      while( tx < tile_width )
+      {
+	if ( u8g2_layer_is_dirty(u8g2, layer, tx, ty) == 0 )
+	{
+	  tx++;
+	  continue;
+	}
+	tx0 = tx;
+	while( tx < tile_width && u8g2_layer_is_dirty(u8g2, layer, tx, ty) != 0 )
+	  tx++;
+	if ( u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb )
+	{
+	  tx0 = 0;
+	  tx = tile_width;
+	}
+	
+	u8g2_layer_copy_background(u8g2, layer, tx0, tx, ty);
+	for( i = 0; i < layer->sprite_cnt; i++ )
+	  if ( layer->sprite_list[i].is_visible )
+	    u8g2_draw_sprite_clipped(u8g2, layer->sprite_list+i, tx0*8, ty*8, tx*8, ty*8+8);
+	
+	ptr = u8g2->tile_buf_ptr;
+	ptr += (uint16_t)ty * tile_width * tile_size;
+	ptr += tx0 * tile_size;
+	if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_gray4 )
+	  u8x8_DrawGrayTile(u8g2_GetU8x8(u8g2), tx0, ty, tx - tx0, ptr);
+	else
+	  u8x8_DrawTile(u8g2_GetU8x8(u8g2), tx0, ty, tx - tx0, ptr);
+	layer->sent_tiles += tx - tx0;
+      }
+    }
+  }
+  memset(layer->dirty, 0, u8g2_layer_get_dirty_size(u8g2));
+  u8g2->draw_color = draw_color;
+}
@@ -73,6 +73,8 @@
     U8X8_MSG_BYTE_END_TRANSFER
     U8X8_MSG_BYTE_SET_I2C_ADR (obsolete)
     U8X8_MSG_BYTE_SET_DEVICE (obsolete)
+    U8X8_MSG_BYTE_XFER_SUBMIT (optional, scatter-gather list)
+    U8X8_MSG_BYTE_XFER_POLL (optional)
 
   GPIO and Delay
     U8X8_MSG_GPIO_INIT
@@ -95,6 +97,44 @@
 /* 26 May 2016: Obsolete */
 //#define U8X8_WITH_SET_FLIP_MODE
 
+/* Define this to add a user pointer to the u8x8 structure (u8x8_SetUserPtr/u8x8_GetUserPtr). */
+/* Host display procedures (stdio, tga) store their per display canvas there, so that */
+/* several u8x8/u8g2 objects can be rendered in parallel threads */
+//#define U8X8_WITH_USER_PTR
+
+/* Define this to add scatter-gather transfers with a completion callback (u8x8_xfer.c). */
+/* The byte procedure may send them with DMA while the next page is rendered. */
+//#define U8X8_WITH_XFER
+
+/* Define this to add software I2C and SPI with direct port access and calibrated delays (u8x8_byte_fast.c) */
+//#define U8X8_WITH_FAST_BUS
+
+/* Define this to share the bus of the display with other prioritized clients, e.g. sensors (u8x8_bus.c) */
+//#define U8X8_WITH_BUS
+
+/* Define this for partial and non-blocking refresh of the SSD1606/SSD1607 e-paper displays (u8x8_epd.c) */
+//#define U8X8_WITH_EPD
+
+/* Define this to send the same content to several identical displays (u8x8_fanout.c) */
+//#define U8X8_WITH_FANOUT
+
+/* Define this for the frame rate limit, dimming and power save policy (u8x8_governor.c) */
+//#define U8X8_WITH_GOVERNOR
+
+/* Define this for menu events from interrupts instead of polling the menu pins (u8x8_event.c) */
+//#define U8X8_WITH_EVENT
+
+/* 
+  Max number of bytes (after the address) of one i2c transfer of u8x8_cad_ssd13xx_i2c.
+  The default (24 data bytes and one control byte) is required by the 32 byte 
+  buffer of the Arduino Wire library. Platforms without such a limit (e.g. WICED
+  wiced_i2c_write) should use 255, so that a complete tile row is sent with one transfer.
+  Range: 4..255
+*/
+#ifndef U8X8_I2C_MAX_TRANSFER
+#define U8X8_I2C_MAX_TRANSFER 25
+#endif
+
 /* Select 0 or 1 for the default flip mode. This is not affected by U8X8_WITH_FLIP_MODE */
 /* Note: Not all display types support a mirror functon for the frame buffer */
 /* 26 May 2016: Obsolete */
@@ -181,6 +221,16 @@ uint8_t u8x8_pgm_read_esp(const uint8_t * addr);   /* u8x8_8x8.c */
 typedef struct u8x8_struct u8x8_t;
 typedef struct u8x8_display_info_struct u8x8_display_info_t;
 typedef struct u8x8_tile_struct u8x8_tile_t;
+typedef struct u8x8_xfer_struct u8x8_xfer_t;
+typedef struct u8x8_fast_bus_struct u8x8_fast_bus_t;
+typedef struct u8x8_bus_struct u8x8_bus_t;
+typedef struct u8x8_bus_client_struct u8x8_bus_client_t;
+typedef struct u8x8_epd_struct u8x8_epd_t;
+typedef struct u8x8_fanout_struct u8x8_fanout_t;
+typedef struct u8x8_fanout_target_struct u8x8_fanout_target_t;
+typedef struct u8x8_governor_struct u8x8_governor_t;
+typedef struct u8x8_event_struct u8x8_event_t;
+typedef struct u8x8_event_queue_struct u8x8_event_queue_t;
 
 typedef uint8_t (*u8x8_msg_cb)(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 typedef uint16_t (*u8x8_char_cb)(u8x8_t *u8x8, uint8_t b);
@@ -266,8 +316,19 @@ struct u8x8_display_info_struct
  /* pixel_height <= tile_height*8 */
   uint16_t pixel_width;
   uint16_t pixel_height;
+  
+  /* == optional features == */
+  /* U8X8_DISPLAY_FLAG_xxx, omitted (0) in most display info structures */
+  uint8_t flags;
 };
 
+/* the display procedure supports U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK */
+#define U8X8_DISPLAY_FLAG_TILE_BLOCK 1
+/* the display procedure supports U8X8_MSG_DISPLAY_SET_START_LINE */
+#define U8X8_DISPLAY_FLAG_START_LINE 2
+/* the display procedure supports U8X8_MSG_DISPLAY_POLL_REFRESH */
+#define U8X8_DISPLAY_FLAG_POLL_REFRESH 4
+
 
 
 /* list of U8x8 pins */
@@ -304,8 +365,11 @@ struct u8x8_display_info_struct
 
 #define U8X8_PIN_INPUT_CNT 6
 
+/* display status input (e-paper), not part of the menu input pins */
+#define U8X8_PIN_BUSY 22
+
 #ifdef U8X8_USE_PINS 
-#define U8X8_PIN_CNT (U8X8_PIN_OUTPUT_CNT+U8X8_PIN_INPUT_CNT)
+#define U8X8_PIN_CNT (U8X8_PIN_OUTPUT_CNT+U8X8_PIN_INPUT_CNT+1)
 #define U8X8_PIN_NONE 255
 #endif
 
@@ -325,6 +389,9 @@ struct u8x8_struct
 					/* i2c_address is the address for writing data to the display */
 					/* usually, the lowest bit must be zero for a valid address */
   uint8_t i2c_started;	/* for i2c interface */
+  uint8_t cad_is_transfer;	/* 1 between U8X8_MSG_CAD_START_TRANSFER and U8X8_MSG_CAD_END_TRANSFER */
+  uint8_t cad_i2c_state;	/* u8x8_cad_ssd13xx_i2c: 0: no i2c transfer, 1: commands, 2: data */
+  uint8_t cad_i2c_cnt;		/* u8x8_cad_ssd13xx_i2c: bytes of the current i2c transfer */
   uint8_t device_address;	/* this is the device address, replacement for U8X8_MSG_CAD_SET_DEVICE */
   uint8_t utf8_state;		/* number of chars which are still to scan */
   uint8_t gpio_result;	/* return value from the gpio call (only for MENU keys at the moment) */ 
@@ -335,6 +402,30 @@ struct u8x8_struct
 #ifdef U8X8_USE_PINS 
   uint8_t pins[U8X8_PIN_CNT];	/* defines a pinlist: Mainly a list of pins for the Arduino Envionment, use U8X8_PIN_xxx to access */
 #endif
+#ifdef U8X8_WITH_USER_PTR
+  void *user_ptr;		/* owned by the application or the display procedure, NULL after setup */
+#endif
+#ifdef U8X8_WITH_XFER
+  u8x8_xfer_t *xfer;		/* see u8x8_SetXfer(), NULL after setup */
+#endif
+#ifdef U8X8_WITH_FAST_BUS
+  u8x8_fast_bus_t *fast_bus;	/* see u8x8_SetFastBus(), NULL after setup */
+#endif
+#ifdef U8X8_WITH_BUS
+  u8x8_bus_client_t *bus_client;	/* see u8x8_SetBusClient(), NULL after setup */
+#endif
+#ifdef U8X8_WITH_EPD
+  u8x8_epd_t *epd;		/* see u8x8_SetEpd(), NULL after setup */
+#endif
+#ifdef U8X8_WITH_FANOUT
+  u8x8_fanout_t *fanout;	/* see u8x8_SetFanout(), NULL after setup */
+#endif
+#ifdef U8X8_WITH_GOVERNOR
+  u8x8_governor_t *governor;	/* see u8x8_SetGovernor(), NULL after setup */
+#endif
+#ifdef U8X8_WITH_EVENT
+  u8x8_event_queue_t *event_queue;	/* see u8x8_SetEventQueue(), NULL after setup */
+#endif
 };
 
 #define u8x8_GetCols(u8x8) ((u8x8)->display_info->tile_width)
@@ -342,6 +433,11 @@ struct u8x8_struct
 #define u8x8_GetI2CAddress(u8x8) ((u8x8)->i2c_address)
 #define u8x8_SetI2CAddress(u8x8, address) ((u8x8)->i2c_address = (address))
 
+#ifdef U8X8_WITH_USER_PTR
+#define u8x8_GetUserPtr(u8x8) ((u8x8)->user_ptr)
+#define u8x8_SetUserPtr(u8x8, p) ((u8x8)->user_ptr = (p))
+#endif
+
 #define u8x8_SetGPIOResult(u8x8, val) ((u8x8)->gpio_result = (val))
 #define u8x8_GetSPIClockPhase(u8x8) ((u8x8)->display_info->spi_mode & 0x01)  /* 0 means rising edge */
 #define u8x8_GetSPIClockPolarity(u8x8) (((u8x8)->display_info->spi_mode & 0x02) >> 1)
@@ -356,6 +452,7 @@ struct u8x8_struct
 #define u8x8_SetMenuHomePin(u8x8, val) u8x8_SetPin((u8x8),U8X8_PIN_MENU_HOME,(val))
 #define u8x8_SetMenuUpPin(u8x8, val) u8x8_SetPin((u8x8),U8X8_PIN_MENU_UP,(val))
 #define u8x8_SetMenuDownPin(u8x8, val) u8x8_SetPin((u8x8),U8X8_PIN_MENU_DOWN,(val))
+#define u8x8_SetBusyPin(u8x8, val) u8x8_SetPin((u8x8),U8X8_PIN_BUSY,(val))
 #endif
 
 
@@ -364,6 +461,8 @@ struct u8x8_struct
 /* helper functions */
 void u8x8_d_helper_display_setup_memory(u8x8_t *u8x8, const u8x8_display_info_t *display_info);
 void u8x8_d_helper_display_init(u8x8_t *u8g2);
+/* U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK for the SSD1306 (horizontal addressing mode), u8x8_d_ssd1306_128x64_noname.c */
+uint8_t u8x8_d_ssd1306_draw_tile_block(u8x8_t *u8x8, uint8_t rows, u8x8_tile_t *tile);
 
 /* Display Interface */
 
@@ -462,6 +561,87 @@ void u8x8_d_helper_display_init(u8x8_t *u8g2);
 */
 #define U8X8_MSG_DISPLAY_REFRESH 16
 
+/*
+  Name: 	U8X8_MSG_DISPLAY_SET_START_LINE
+  Args:	
+    arg_int: pixel row of the display memory, which is shown at the top of the display
+    arg_ptr: -
+  
+  Hardware scrolling: Controllers like the SSD1306 show the display memory
+  starting at an arbitrary pixel row. The display memory is used as ring buffer.
+  The DRAW_TILE message must not change the start line.
+  The message is only sent if the display info contains 
+  U8X8_DISPLAY_FLAG_START_LINE. The display handler must still return 0 
+  if this message is not supported.
+  Use
+    uint8_t u8x8_SetDisplayStartLine(u8x8_t *u8x8, uint8_t line)
+  to send the message to the display handler.
+*/
+#define U8X8_MSG_DISPLAY_SET_START_LINE 17
+
+/*
+  Name: 	U8X8_MSG_DISPLAY_DRAW_GRAY_TILE
+  Args:	
+    arg_int: How often to repeat this tile pattern
+    arg_ptr: pointer to u8x8_tile_t, same as U8X8_MSG_DISPLAY_DRAW_TILE
+  Tasks:
+    Same as U8X8_MSG_DISPLAY_DRAW_TILE, but with 4 bit per pixel (16 gray levels).
+    One tile has 32 bytes. The memory area at "tile_ptr" contains 8 pixel 
+    lines, each line has 4*cnt bytes. The upper nibble of a byte is the 
+    left pixel. This is the memory layout of u8g2_ll_hvline_horizontal_gray4.
+    Used by the SSD1322, SSD1325 and SSD1327, which can write the
+    data directly into the display memory.
+    The display handler must return 0 if this message is not supported.
+  Use
+    uint8_t u8x8_DrawGrayTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *tile_ptr)
+  to send the message to the display handler.
+*/
+#define U8X8_MSG_DISPLAY_DRAW_GRAY_TILE 18
+
+/*
+  Name: 	U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK
+  Args:	
+    arg_int: number of tile rows
+    arg_ptr: pointer to u8x8_tile_t
+        uint8_t *tile_ptr;	arg_int*cnt tiles, the tile rows follow each other
+	uint8_t cnt;		number of tiles in one row
+	uint8_t x_pos;		first tile x position
+	uint8_t y_pos;		first tile y position 
+  Tasks:
+    Same as one DRAW_TILE message for each of the rows y_pos ... y_pos+arg_int-1,
+    but the address window is sent only once and all tiles are sent with
+    one data burst. Controllers which increment the address over the end of 
+    a page (SSD1306 horizontal addressing mode) can receive the complete 
+    frame (1024 bytes for 128x64) this way.
+    The message is only sent if the display info contains 
+    U8X8_DISPLAY_FLAG_TILE_BLOCK. The display handler must still return 0 
+    if it can not handle the message (for example a wrapper procedure).
+  Use
+    uint8_t u8x8_DrawTileBlock(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *tile_ptr)
+  to send the message to the display handler.
+*/
+#define U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK 19
+
+/*
+  Name: 	U8X8_MSG_DISPLAY_POLL_REFRESH
+  Args:	
+    arg_int: -
+    arg_ptr: -
+  Tasks:
+    Check the progress of a non-blocking U8X8_MSG_DISPLAY_REFRESH (e-paper
+    displays with U8X8_WITH_EPD) and send the next command of the refresh,
+    if the display is ready. Must not block.
+    Returns 1 while the refresh is still in progress. Displays with a 
+    blocking or without a refresh return 0.
+    The message is only sent if the display info contains 
+    U8X8_DISPLAY_FLAG_POLL_REFRESH.
+  Use
+    uint8_t u8x8_IsRefreshBusy(u8x8_t *u8x8)
+    void u8x8_WaitRefresh(u8x8_t *u8x8)
+  to send the message to the display handler.
+*/
+#define U8X8_MSG_DISPLAY_POLL_REFRESH 20
+
 /*==========================================*/
 /* u8x8_setup.c */
 
@@ -478,6 +658,10 @@ void u8x8_Setup(u8x8_t *u8x8, u8x8_msg_cb display_cb, u8x8_msg_cb cad_cb, u8x8_m
 /*==========================================*/
 /* u8x8_display.c */
 uint8_t u8x8_DrawTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *tile_ptr);
+/* tile_ptr points to 32*cnt bytes, returns 0 if the display does not support 4 bit gray tiles */
+uint8_t u8x8_DrawGrayTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *tile_ptr);
+/* tile_ptr points to rows*cnt tiles, returns 0 if the display does not support tile blocks */
+uint8_t u8x8_DrawTileBlock(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *tile_ptr);
 
 /* 
   After a call to u8x8_SetupDefaults, 
@@ -502,6 +686,10 @@ void u8x8_ClearDisplayWithTile(u8x8_t *u8x8, const uint8_t *buf)  U8X8_NOINLINE;
 void u8x8_ClearDisplay(u8x8_t *u8x8);	// this does not work for u8g2 in some cases
 void u8x8_FillDisplay(u8x8_t *u8x8);
 void u8x8_RefreshDisplay(u8x8_t *u8x8);	// make RAM content visible on the display (Dec 16: SSD1606 only)
+uint8_t u8x8_IsRefreshBusy(u8x8_t *u8x8);	// 1 while a non-blocking refresh is in progress
+void u8x8_WaitRefresh(u8x8_t *u8x8);
+/* returns 0 if the display does not support hardware scrolling */
+uint8_t u8x8_SetDisplayStartLine(u8x8_t *u8x8, uint8_t line);
 
 
 
@@ -611,6 +799,423 @@ uint8_t u8x8_byte_ssd13xx_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, voi
 uint8_t u8x8_byte_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 
 
+/*==========================================*/
+/* Scatter-Gather Transfer (u8x8_xfer.c) */
+
+/*
+  U8X8_MSG_BYTE_XFER_SUBMIT
+    arg_ptr: u8x8_xfer_t, send all segments of the seg_list
+    Start the transfer (e.g. with DMA) and return 1 without waiting. 
+    u8x8_xfer_Done() must be called once all segments are sent, also 
+    from an interrupt. 
+    Return 0 if the byte procedure does not support this message: The 
+    segments are then sent with the other byte messages.
+  U8X8_MSG_BYTE_XFER_POLL
+    arg_ptr: u8x8_xfer_t
+    Called in a loop until u8x8_xfer_Done() has been called, e.g. to check the 
+    DMA status, to wait for a semaphore or to advance a simulated bus.
+*/
+#define U8X8_MSG_BYTE_XFER_SUBMIT 33
+#define U8X8_MSG_BYTE_XFER_POLL 34
+
+#ifdef U8X8_WITH_XFER
+
+#define U8X8_XFER_SEG_START 1	/* start transfer (chip select, i2c start and address) before this segment */
+#define U8X8_XFER_SEG_END 2	/* end transfer after this segment */
+#define U8X8_XFER_SEG_DC 4	/* level of the D/C line for this segment */
+
+struct u8x8_xfer_seg_struct
+{
+  const uint8_t *data;
+  uint16_t cnt;		/* may be 0, e.g. for a transfer without data */
+  uint8_t flags;		/* U8X8_XFER_SEG_xxx */
+};
+typedef struct u8x8_xfer_seg_struct u8x8_xfer_seg_t;
+
+typedef void (*u8x8_xfer_done_cb)(u8x8_t *u8x8, u8x8_xfer_t *xfer);
+
+struct u8x8_xfer_struct
+{
+  u8x8_xfer_seg_t *seg_list;
+  uint8_t *pool;			/* recorded bytes, the segments point into this memory */
+  u8x8_msg_cb byte_cb;		/* byte procedure of the hardware */
+  u8x8_xfer_done_cb done_cb;	/* called by u8x8_xfer_Done() */
+  uint16_t pool_size;
+  uint16_t pool_cnt;
+  uint8_t seg_max;
+  uint8_t seg_cnt;
+  uint8_t dc;			/* last U8X8_MSG_BYTE_SET_DC */
+  uint8_t is_start;		/* U8X8_MSG_BYTE_START_TRANSFER without data */
+  uint8_t is_recording;
+  volatile uint8_t is_busy;	/* 1 between submit and u8x8_xfer_Done() */
+};
+
+/* 
+  Redirect the byte procedure of the u8x8 object to u8x8_byte_xfer(). 
+  Byte messages between u8x8_BeginXfer() and u8x8_EndXfer() are recorded, 
+  all other messages wait for the pending transfer and are passed to the 
+  original byte procedure. pool_size should be the size of one page (u8g2 
+  tile buffer) plus the commands. xfer = NULL restores the original byte
+  procedure.
+*/
+void u8x8_SetXfer(u8x8_t *u8x8, u8x8_xfer_t *xfer, u8x8_xfer_seg_t *seg_list, uint8_t seg_max, uint8_t *pool, uint16_t pool_size);
+void u8x8_BeginXfer(u8x8_t *u8x8);
+/* submit the recorded segments, done_cb may be NULL */
+void u8x8_EndXfer(u8x8_t *u8x8, u8x8_xfer_done_cb done_cb);
+void u8x8_WaitXfer(u8x8_t *u8x8);
+#define u8x8_IsXferBusy(u8x8) ((u8x8)->xfer != NULL && (u8x8)->xfer->is_busy != 0)
+/* called by the byte procedure after the last segment of a submitted transfer */
+void u8x8_xfer_Done(u8x8_t *u8x8, u8x8_xfer_t *xfer);
+/* send the segments with the blocking byte messages */
+void u8x8_xfer_Replay(u8x8_t *u8x8, u8x8_xfer_t *xfer, u8x8_msg_cb byte_cb);
+uint8_t u8x8_byte_xfer(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+#endif /* U8X8_WITH_XFER */
+
+
+/*==========================================*/
+/* Software I2C and SPI with direct port access (u8x8_byte_fast.c) */
+
+#ifdef U8X8_WITH_FAST_BUS
+
+/* 
+  The port access can be replaced, e.g. for set/clear registers:
+    #define U8X8_FAST_PORT_SET(port, mask) ((port)[1] = (mask))
+  I2C: clock and data port must be open drain outputs.
+*/
+#ifndef U8X8_FAST_PORT_T
+#define U8X8_FAST_PORT_T uint32_t
+#endif
+#ifndef U8X8_FAST_PORT_SET
+#define U8X8_FAST_PORT_SET(port, mask) (*(port) |= (mask))
+#endif
+#ifndef U8X8_FAST_PORT_CLR
+#define U8X8_FAST_PORT_CLR(port, mask) (*(port) &= ~(mask))
+#endif
+
+struct u8x8_fast_bus_struct
+{
+  volatile U8X8_FAST_PORT_T *clock_port;	/* I2C clock or SPI clock */
+  volatile U8X8_FAST_PORT_T *data_port;		/* I2C data or SPI data */
+  U8X8_FAST_PORT_T clock_mask;
+  U8X8_FAST_PORT_T data_mask;
+  
+  /* measured by u8x8_CalibrateFastBus() or assigned by the application */
+  uint32_t loop_ps;		/* duration of one delay loop in pico seconds */
+  uint16_t port_ns;		/* duration of one port access */
+  
+  /* delay table in delay loops, calculated by u8x8_SetFastBus() */
+  uint16_t dly_low;		/* I2C: clock low time, SPI: data setup time before the takeover edge */
+  uint16_t dly_high;		/* I2C: clock high time, SPI: clock pulse width after the takeover edge */
+};
+
+/* 
+  u8x8_SetFastBus() must be called after u8x8_Setup() and after the calibration. 
+  The delay table is calculated from i2c_bus_clock_100kHz (I2C) or from
+  sck_pulse_width_ns and sda_setup_time_ns (SPI) of the display. 
+*/
+void u8x8_SetFastBus(u8x8_t *u8x8, u8x8_fast_bus_t *bus);
+/* get_us: free running micro second counter, the clock line is toggled, the data line is not changed */
+void u8x8_CalibrateFastBus(u8x8_fast_bus_t *bus, uint32_t (*get_us)(void));
+uint8_t u8x8_byte_fast_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+uint8_t u8x8_byte_fast_4wire_sw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+#endif /* U8X8_WITH_FAST_BUS */
+
+
+/*==========================================*/
+/* Shared bus with prioritized clients (u8x8_bus.c) */
+
+/*
+  bus_cb messages. The bus_cb connects the arbitration to the environment.
+
+  U8X8_MSG_BUS_LOCK, U8X8_MSG_BUS_UNLOCK
+    Enter and leave a critical section for the bus and client state,
+    e.g. disable interrupts or lock a mutex. client is the calling client.
+
+  U8X8_MSG_BUS_WAIT
+    Called in a loop by u8x8_bus_Acquire() until the client owns the bus,
+    e.g. take a semaphore of the client (client->user_ptr).
+
+  U8X8_MSG_BUS_GRANT
+    A pending client has become the owner of the bus. Sent after the 
+    previous owner has released the bus and outside of the critical 
+    section. Either wake up the waiting thread (give the semaphore) or 
+    run the transaction of the client and release the bus (interrupt 
+    requests without threads).
+*/
+#define U8X8_MSG_BUS_LOCK 1
+#define U8X8_MSG_BUS_UNLOCK 2
+#define U8X8_MSG_BUS_WAIT 3
+#define U8X8_MSG_BUS_GRANT 4
+
+#ifdef U8X8_WITH_BUS
+
+typedef uint8_t (*u8x8_bus_cb)(u8x8_bus_t *bus, uint8_t msg, u8x8_bus_client_t *client);
+
+struct u8x8_bus_client_struct
+{
+  u8x8_bus_t *bus;
+  u8x8_bus_client_t *next;		/* next pending client */
+  u8x8_bus_client_t *next_client;	/* list of all clients of the bus */
+  void *user_ptr;			/* owned by the bus_cb, e.g. a semaphore */
+  u8x8_msg_cb byte_cb;			/* u8x8_byte_bus(): byte procedure of the hardware */
+  uint32_t request_ticks;
+  uint32_t grant_ticks;
+  
+  /* accounting, cleared by u8x8_bus_ClearStats() */
+  uint32_t busy_ticks;			/* sum of the bus ownership */
+  uint32_t wait_ticks;			/* sum of the time between request and grant */
+  uint32_t max_wait_ticks;
+  uint16_t grant_cnt;
+  uint16_t wait_cnt;			/* number of requests, which had to wait */
+  uint16_t yield_cnt;			/* number of releases, which granted the bus to a pending client */
+  
+  uint8_t priority;			/* the pending client with the highest priority gets the bus */
+  uint8_t is_pending;
+};
+
+struct u8x8_bus_struct
+{
+  u8x8_bus_cb bus_cb;
+  uint32_t (*get_ticks)(void);		/* free running counter for the accounting, may be NULL */
+  u8x8_bus_client_t * volatile owner;	/* changed by other threads or interrupts */
+  u8x8_bus_client_t *pending;		/* sorted by priority, FIFO for equal priority */
+  u8x8_bus_client_t *client_list;
+};
+
+void u8x8_bus_Init(u8x8_bus_t *bus, u8x8_bus_cb bus_cb, uint32_t (*get_ticks)(void));
+void u8x8_bus_InitClient(u8x8_bus_t *bus, u8x8_bus_client_t *client, uint8_t priority);
+/* returns 1 if the client owns the bus, otherwise U8X8_MSG_BUS_GRANT follows, can be called from interrupts */
+uint8_t u8x8_bus_Request(u8x8_bus_client_t *client);
+/* request and wait for the bus */
+void u8x8_bus_Acquire(u8x8_bus_client_t *client);
+void u8x8_bus_Release(u8x8_bus_client_t *client);
+void u8x8_bus_ClearStats(u8x8_bus_t *bus);
+#define u8x8_bus_IsOwner(client) ((client)->bus->owner == (client))
+
+/* 
+  Redirect the byte procedure of the u8x8 object to u8x8_byte_bus(). The bus 
+  is acquired for each transfer (U8X8_MSG_BYTE_START_TRANSFER) and released 
+  at the end of the transfer, so that pending clients with higher priority 
+  are served between two transfers. The transfers of u8x8_cad_ssd13xx_i2c 
+  are limited by U8X8_I2C_MAX_TRANSFER. client = NULL restores the original 
+  byte procedure.
+*/
+void u8x8_SetBusClient(u8x8_t *u8x8, u8x8_bus_client_t *client);
+uint8_t u8x8_byte_bus(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+#endif /* U8X8_WITH_BUS */
+
+
+/*==========================================*/
+/* Partial and non-blocking refresh of e-paper displays (u8x8_epd.c) */
+
+#ifdef U8X8_WITH_EPD
+
+#define U8X8_EPD_IDLE 0
+#define U8X8_EPD_REFRESH 1
+#define U8X8_EPD_POWER_DOWN 2
+
+#define U8X8_EPD_LUT_FULL 0
+#define U8X8_EPD_LUT_PARTIAL 1
+#define U8X8_EPD_LUT_UNKNOWN 255
+
+struct u8x8_epd_struct
+{
+  uint8_t full_interval;	/* number of partial refreshes between two full refreshes, 0: full refresh only */
+  uint8_t partial_cnt;		/* partial refreshes since the last full refresh */
+  uint8_t state;		/* U8X8_EPD_IDLE, U8X8_EPD_REFRESH, U8X8_EPD_POWER_DOWN */
+  uint8_t lut;			/* LUT in the controller: U8X8_EPD_LUT_xxx */
+  uint8_t is_dirty;		/* display memory has been written since the last refresh */
+  
+  /* statistics */
+  uint16_t full_refresh_cnt;
+  uint16_t partial_refresh_cnt;
+  uint16_t skipped_refresh_cnt;	/* refresh without new content */
+};
+
+/*
+  Enable the partial and non-blocking refresh. The BUSY output of the 
+  display must be available with U8X8_MSG_GPIO_BUSY (u8x8->gpio_result,
+  1: busy). The first refresh is a full refresh. epd = NULL restores the 
+  blocking full refresh.
+*/
+void u8x8_SetEpd(u8x8_t *u8x8, u8x8_epd_t *epd, uint8_t full_interval);
+/* force a full refresh with the next u8x8_RefreshDisplay(), e.g. to remove ghosting */
+void u8x8_RequestFullRefresh(u8x8_t *u8x8);
+
+/* used by the display procedures */
+u8x8_epd_t *u8x8_epd_BeginInit(u8x8_t *u8x8);
+void u8x8_epd_EndInit(u8x8_t *u8x8, u8x8_epd_t *epd);
+void u8x8_epd_BeforeDrawTile(u8x8_t *u8x8);
+uint8_t u8x8_epd_Refresh(u8x8_t *u8x8, const uint8_t *lut_full_seq, const uint8_t *lut_partial_seq);
+uint8_t u8x8_epd_Poll(u8x8_t *u8x8);
+
+#endif /* U8X8_WITH_EPD */
+
+
+/*==========================================*/
+/* Same content on several identical displays (u8x8_fanout.c) */
+
+#ifdef U8X8_WITH_FANOUT
+
+struct u8x8_fanout_target_struct
+{
+  u8x8_t *u8x8;			/* setup by the application: display procedure, bus, i2c address, pins */
+  uint32_t dirty_rows;		/* bit n: tile row n must be sent completely, bit 31 is used for all rows >= 31 */
+  uint32_t tile_cnt;		/* number of tiles sent to this display */
+  uint8_t is_attached;
+};
+
+struct u8x8_fanout_struct
+{
+  u8x8_fanout_target_t *target_list;
+  uint8_t *shadow;		/* copy of the display memory, NULL: all tiles are sent to all displays */
+  u8x8_msg_cb display_cb;	/* original display procedure (display info only) */
+  uint8_t target_cnt;
+  
+  /* applied to displays, which are attached later */
+  uint8_t power_save;
+  uint8_t flip_mode;
+  uint8_t contrast;
+  uint8_t is_contrast;
+};
+
+/*
+  Replace the display procedure of the u8x8 (or u8g2) object by
+  u8x8_d_fanout(). The u8x8 object must be setup for the same display
+  type as the targets, its byte procedure is not used. Rendering is
+  done once, DRAW_TILE messages are sent to all attached targets.
+  With the shadow buffer (tile_width*tile_height*8 bytes), only changed 
+  tiles are sent, except for tile rows which are dirty for a target.
+  All targets are detached after this call.
+*/
+void u8x8_SetFanout(u8x8_t *u8x8, u8x8_fanout_t *fanout, u8x8_fanout_target_t *target_list, uint8_t target_cnt, uint8_t *shadow);
+/* init the display of the target, all tile rows of the target are dirty until the next frame has been sent */
+void u8x8_AttachFanoutTarget(u8x8_t *u8x8, uint8_t idx);
+void u8x8_DetachFanoutTarget(u8x8_t *u8x8, uint8_t idx);
+/* send the dirty rows of all attached targets from the shadow buffer, nothing is done without shadow buffer */
+void u8x8_UpdateFanoutTargets(u8x8_t *u8x8);
+uint8_t u8x8_d_fanout(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+#endif /* U8X8_WITH_FANOUT */
+
+
+/*==========================================*/
+/* Frame rate limit, dimming and power save policy (u8x8_governor.c) */
+
+#ifdef U8X8_WITH_GOVERNOR
+
+#define U8X8_GOVERNOR_ACTIVE 0
+#define U8X8_GOVERNOR_DIM 1
+#define U8X8_GOVERNOR_POWER_SAVE 2
+
+struct u8x8_governor_struct
+{
+  /* all times in milliseconds, the time base is given by the application */
+  uint32_t last_frame_ms;	/* start of the last frame */
+  uint32_t last_activity_ms;	/* last user input or presence */
+  uint32_t last_presence_ms;	/* last time with presence */
+  
+  uint32_t min_frame_ms;	/* min. time between two frames */
+  uint32_t dim_ms;		/* time without activity until the contrast is reduced, 0: never */
+  uint32_t power_save_ms;	/* time without presence until power save, 0: never */
+  
+  uint8_t contrast;		/* contrast in U8X8_GOVERNOR_ACTIVE state */
+  uint8_t dim_contrast;
+  uint8_t state;		/* U8X8_GOVERNOR_ACTIVE, U8X8_GOVERNOR_DIM, U8X8_GOVERNOR_POWER_SAVE */
+  uint8_t is_redraw;		/* redraw has been requested */
+  uint8_t is_present;		/* last value of u8x8_SetPresence() */
+  
+  /* statistics */
+  uint32_t request_cnt;		/* calls to u8x8_RequestRedraw() */
+  uint32_t frame_cnt;		/* frames granted by u8x8_PollGovernor() */
+  uint32_t dim_cnt;
+  uint32_t power_save_cnt;
+};
+
+/*
+  The application calls u8x8_RequestRedraw() for each change of the 
+  content, but renders a frame only if u8x8_PollGovernor() returns 1:
+  Requests within min_frame_ms after the start of the last frame are 
+  combined into one frame. No frames are granted in power save mode, a 
+  pending request is granted after wake up.
+  
+  The governor changes the contrast (dim) and the power save mode of the 
+  display, the application should not call u8x8_SetContrast() or 
+  u8x8_SetPowerSave() directly.
+*/
+void u8x8_SetGovernor(u8x8_t *u8x8, u8x8_governor_t *governor, uint32_t min_frame_ms, uint32_t dim_ms, uint32_t power_save_ms, uint32_t now_ms);
+void u8x8_SetGovernorContrast(u8x8_t *u8x8, uint8_t contrast, uint8_t dim_contrast);
+void u8x8_RequestRedraw(u8x8_t *u8x8);
+/* user input: restore contrast, leave power save */
+void u8x8_NotifyActivity(u8x8_t *u8x8, uint32_t now_ms);
+/* presence sensor, e.g. BVAL_PROX_MASK of the shield button register */
+void u8x8_SetPresence(u8x8_t *u8x8, uint8_t is_present, uint32_t now_ms);
+/* returns 1 if a frame should be rendered now, call this in the main loop */
+uint8_t u8x8_PollGovernor(u8x8_t *u8x8, uint32_t now_ms);
+#define u8x8_GetGovernorState(u8x8) ((u8x8)->governor->state)
+
+#endif /* U8X8_WITH_GOVERNOR */
+
+
+/*==========================================*/
+/* Menu events from interrupts (u8x8_event.c) */
+
+#ifdef U8X8_WITH_EVENT
+
+struct u8x8_event_struct
+{
+  uint32_t time;		/* time of the event, unit is defined by the application (e.g. ms) */
+  uint8_t msg;			/* U8X8_MSG_GPIO_MENU_xxx */
+};
+
+/* 
+  Ring buffer without lock: Only one producer (interrupt or task) and 
+  one consumer (u8x8_GetMenuEvent()). With more than one interrupt, all 
+  producers must have the same priority (they must not interrupt each other).
+*/
+struct u8x8_event_queue_struct
+{
+  u8x8_event_t *event_list;	/* size elements */
+  volatile uint8_t head;	/* next free element, written by the producer */
+  volatile uint8_t tail;	/* next event, written by the consumer */
+  uint8_t mask;			/* size-1, size must be a power of two */
+  uint8_t pressed_pins;		/* bit n: pin U8X8_PIN_OUTPUT_CNT+n is pressed, u8x8_event_PushPin() */
+  uint16_t debounce_time;
+  uint32_t pin_time[U8X8_PIN_INPUT_CNT];	/* time of the last accepted change of the pin */
+  uint32_t overflow_cnt;	/* lost events */
+};
+
+/* size: 2, 4, 8, ..., 128 */
+void u8x8_event_InitQueue(u8x8_event_queue_t *queue, u8x8_event_t *event_list, uint8_t size, uint16_t debounce_time);
+/* returns 0 if the queue is full, can be called from an interrupt */
+uint8_t u8x8_event_Push(u8x8_event_queue_t *queue, uint8_t msg, uint32_t time);
+/* 
+  input pin changed (GPIO interrupt), pin is U8X8_PIN_MENU_xxx, level 0 is pressed.
+  Changes within debounce_time after the last accepted change of the pin are ignored.
+  An event is created when the pin is pressed. Can be called from an interrupt.
+*/
+void u8x8_event_PushPin(u8x8_event_queue_t *queue, uint8_t pin, uint8_t level, uint32_t time);
+/* returns 0 if the queue is empty */
+uint8_t u8x8_event_Pop(u8x8_event_queue_t *queue, u8x8_event_t *event);
+/* returns 1 if there is no event, use this with disabled interrupts before WFI (U8X8_MSG_DELAY_EVENT) */
+#define u8x8_event_IsEmpty(queue) ((queue)->head == (queue)->tail)
+
+/* u8x8_GetMenuEvent() reads the queue instead of the menu pins, NULL: poll the menu pins */
+void u8x8_SetEventQueue(u8x8_t *u8x8, u8x8_event_queue_t *queue);
+
+/*
+  Wait for the next menu event. Sends U8X8_MSG_DELAY_EVENT to the gpio
+  procedure while the queue is empty.
+  Without queue, this is u8x8_GetMenuEvent(): It might return 0.
+*/
+uint8_t u8x8_WaitMenuEvent(u8x8_t *u8x8);
+
+#endif /* U8X8_WITH_EVENT */
+
+
 /*==========================================*/
 /* GPIO Interface */
 
@@ -634,6 +1239,21 @@ uint8_t u8x8_byte_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_p
 /* delay of one i2c unit, should be 5us for 100K, and 1.25us for 400K */
 #define U8X8_MSG_DELAY_I2C		45
 
+/* 
+  wait until an interrupt has happened (WFI, RTOS semaphore), only sent with U8X8_WITH_EVENT
+  arg_ptr: u8x8_event_queue_t
+  The procedure may return earlier, the caller checks the event queue and sends the message again.
+  An event might be pushed after the caller has found the queue empty: Check the queue
+  again with disabled interrupts, otherwise the procedure sleeps until the next interrupt
+  with the event in the queue. On a Cortex-M, WFI also wakes up with disabled interrupts:
+    __disable_irq();
+    if ( u8x8_event_IsEmpty((u8x8_event_queue_t *)arg_ptr) )
+      __WFI();
+    __enable_irq();
+  With a semaphore, which is given by the interrupt after u8x8_event_Push(), no check is required.
+*/
+#define U8X8_MSG_DELAY_EVENT		46
+
 #define U8X8_MSG_GPIO(x) (64+(x))
 #ifdef U8X8_USE_PINS 
 #define u8x8_GetPinIndex(u8x8, msg) ((msg)&0x3f)
@@ -669,6 +1289,7 @@ uint8_t u8x8_byte_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_p
 #define U8X8_MSG_GPIO_MENU_HOME	U8X8_MSG_GPIO(U8X8_PIN_MENU_HOME)
 #define U8X8_MSG_GPIO_MENU_UP		U8X8_MSG_GPIO(U8X8_PIN_MENU_UP)
 #define U8X8_MSG_GPIO_MENU_DOWN	U8X8_MSG_GPIO(U8X8_PIN_MENU_DOWN)
+#define U8X8_MSG_GPIO_BUSY		U8X8_MSG_GPIO(U8X8_PIN_BUSY)
 
 
 #define u8x8_gpio_Init(u8x8) ((u8x8)->gpio_and_delay_cb((u8x8), U8X8_MSG_GPIO_AND_DELAY_INIT, 0, NULL ))
@@ -698,9 +1319,13 @@ void u8x8_gpio_call(u8x8_t *u8x8, uint8_t msg, uint8_t arg) U8X8_NOINLINE;
 /* u8x8_debounce.c */
 /* return U8X8_MSG_GPIO_MENU_xxxxx messages */
 uint8_t u8x8_GetMenuEvent(u8x8_t *u8x8);
+#ifndef U8X8_WITH_EVENT
+#define u8x8_WaitMenuEvent(u8x8) u8x8_GetMenuEvent(u8x8)
+#endif
 
 /*==========================================*/
 /* u8x8_d_stdio.c */
+/* with U8X8_WITH_USER_PTR, the user_ptr may point to a 128 byte bitmap for this display */
 void u8x8_SetupStdio(u8x8_t *u8x8);
 
 /*==========================================*/
@@ -800,8 +1425,13 @@ uint8_t u8x8_GetUTF8Len(u8x8_t *u8x8, const char *s);
 
 /*==========================================*/
 /* itoa procedures */
+/* u8x8_u8toa and u8x8_u16toa return a static buffer, use the "p" variants from several threads */
+const char *u8x8_u8toap(char * dest, uint8_t v);	/* dest must have 4 bytes, always writes 3 digits */
+const char *u8x8_u16toap(char * dest, uint16_t v);	/* dest must have 6 bytes, always writes 5 digits */
 const char *u8x8_u8toa(uint8_t v, uint8_t d);
 const char *u8x8_u16toa(uint16_t v, uint8_t d);
+/* fixed point: v/10^decimals, right aligned in width chars, dest must have width+1 bytes */
+const char *u8x8_fixtoap(char *dest, int32_t v, uint8_t width, uint8_t decimals);
 
 
 /*==========================================*/
@@ -817,6 +1447,58 @@ uint8_t u8x8_DrawUTF8Lines(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t w, const
 
 /*==========================================*/
 
+/* u8x8_console.c */
+/* 
+  Text console with 8x8 glyphs. New lines are added at the bottom.
+  Uses hardware scrolling (u8x8_SetDisplayStartLine) if supported by the display.
+*/
+struct _u8x8_console_struct
+{
+  char *buf;		/* cols*rows chars, the rows are stored in the order of the display memory */
+  uint8_t cols;
+  uint8_t rows;
+  uint8_t cursor_x;
+  uint8_t cursor_y;	/* visible row, 0 is the top row */
+  uint8_t top_row;	/* tile row of the display memory, which is shown at the top */
+  uint8_t is_hw_scroll;	/* 0: scroll the buffer and redraw all rows */
+};
+typedef struct _u8x8_console_struct u8x8_console_t;
+
+/* buf must have tile_width*tile_height bytes, the font must be assigned before */
+void u8x8_ConsoleInit(u8x8_t *u8x8, u8x8_console_t *con, char *buf);
+/* write ASCII text, handles \n and \r */
+void u8x8_ConsoleWrite(u8x8_t *u8x8, u8x8_console_t *con, const char *s);
+/* for tests: is_enable = 0 will always redraw all rows */
+#define u8x8_ConsoleSetHardwareScroll(con, is_enable) ((con)->is_hw_scroll &= (is_enable))
+
+/*==========================================*/
+
+/* u8x8_num_field.c */
+/* 
+  Numeric field for values which are updated often (e.g. sensor readouts).
+  Only the glyphs which have changed are sent to the display.
+*/
+#define U8X8_NUM_FIELD_MAX_WIDTH 12
+struct _u8x8_num_field_struct
+{
+  const uint8_t *font;
+  uint8_t x;		/* tile position of the first glyph */
+  uint8_t y;
+  uint8_t width;		/* number of glyphs: sign, digits and decimal point */
+  uint8_t decimals;	/* digits after the decimal point */
+  uint8_t scale;		/* 1: 8x8 glyphs, 2: 16x16 glyphs (u8x8_Draw2x2Glyph) */
+  char shown[U8X8_NUM_FIELD_MAX_WIDTH+1];	/* chars on the display, '\0': unknown */
+};
+typedef struct _u8x8_num_field_struct u8x8_num_field_t;
+
+void u8x8_InitNumField(u8x8_num_field_t *field, const uint8_t *font, uint8_t x, uint8_t y, uint8_t width, uint8_t decimals, uint8_t scale);
+/* call this after the display has been cleared */
+void u8x8_InvalidateNumField(u8x8_num_field_t *field);
+/* shows v/10^decimals, returns the number of sent tiles */
+uint8_t u8x8_UpdateNumField(u8x8_t *u8x8, u8x8_num_field_t *field, int32_t v);
+
+/*==========================================*/
+
 /* u8x8_selection_list.c */
 struct _u8sl_struct
 {
@@ -0,0 +1,229 @@
+/* 
+
+  u8x8_bus.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  
+  Shared bus with prioritized clients: Each client (display, sensor) 
+  requests the bus before a transaction and releases it afterwards. 
+  The bus is handed over to the pending client with the highest priority.
+  A display (u8x8_byte_bus) releases the bus after each transfer, so
+  that a sensor has to wait for one transfer, not for a complete frame.
+  
+  All environment dependent actions (critical section, waiting, wake up)
+  are done by the bus_cb. Bus time and waiting time are accounted for each
+  client, if a tick counter is available.
+  
+  Only available with U8X8_WITH_BUS.
+  
+*/
+
+#include "u8x8.h"
+
+#ifdef U8X8_WITH_BUS
+
+static uint32_t u8x8_bus_ticks(u8x8_bus_t *bus)
+{
+  if ( bus->get_ticks == NULL )
+    return 0;
+  return bus->get_ticks();
+}
+
+/* called inside the critical section */
+static void u8x8_bus_grant(u8x8_bus_client_t *client, uint32_t now)
+{
+  uint32_t wait = now - client->request_ticks;
+  client->grant_ticks = now;
+  client->wait_ticks += wait;
+  if ( client->max_wait_ticks < wait )
+    client->max_wait_ticks = wait;
+  client->grant_cnt++;
+}
+
+static void u8x8_bus_clear_stats(u8x8_bus_client_t *client)
+{
+  client->busy_ticks = 0;
+  client->wait_ticks = 0;
+  client->max_wait_ticks = 0;
+  client->grant_cnt = 0;
+  client->wait_cnt = 0;
+  client->yield_cnt = 0;
+}
+
+void u8x8_bus_Init(u8x8_bus_t *bus, u8x8_bus_cb bus_cb, uint32_t (*get_ticks)(void))
+{
+  bus->bus_cb = bus_cb;
+  bus->get_ticks = get_ticks;
+  bus->owner = NULL;
+  bus->pending = NULL;
+  bus->client_list = NULL;
+}
+
+void u8x8_bus_InitClient(u8x8_bus_t *bus, u8x8_bus_client_t *client, uint8_t priority)
+{
+  client->bus = bus;
+  client->next = NULL;
+  client->user_ptr = NULL;
+  client->byte_cb = NULL;
+  client->request_ticks = 0;
+  client->grant_ticks = 0;
+  client->priority = priority;
+  client->is_pending = 0;
+  client->next_client = bus->client_list;
+  bus->client_list = client;
+  u8x8_bus_clear_stats(client);
+}
+
+void u8x8_bus_ClearStats(u8x8_bus_t *bus)
+{
+  u8x8_bus_client_t *client;
+  for( client = bus->client_list; client != NULL; client = client->next_client )
+    u8x8_bus_clear_stats(client);
+}
+
+/*
+  A repeated request of a pending client is ignored, e.g. from a timer 
+  interrupt, which has been triggered again before the grant.
+*/
+uint8_t u8x8_bus_Request(u8x8_bus_client_t *client)
+{
+  u8x8_bus_t *bus = client->bus;
+  u8x8_bus_client_t **p;
+  uint32_t now = u8x8_bus_ticks(bus);
+  uint8_t is_owner = 1;
+  
+  bus->bus_cb(bus, U8X8_MSG_BUS_LOCK, client);
+  if ( bus->owner == NULL )
+  {
+    /* no owner: there is also no pending client */
+    client->request_ticks = now;
+    bus->owner = client;
+    u8x8_bus_grant(client, now);
+  }
+  else if ( client->is_pending != 0 )
+  {
+    is_owner = 0;
+  }
+  else if ( bus->owner != client )
+  {
+    client->is_pending = 1;
+    client->request_ticks = now;
+    p = &(bus->pending);
+    while( *p != NULL && (*p)->priority >= client->priority )
+      p = &((*p)->next);
+    client->next = *p;
+    *p = client;
+    client->wait_cnt++;
+    is_owner = 0;
+  }
+  bus->bus_cb(bus, U8X8_MSG_BUS_UNLOCK, client);
+  return is_owner;
+}
+
+void u8x8_bus_Acquire(u8x8_bus_client_t *client)
+{
+  u8x8_bus_t *bus = client->bus;
+  if ( u8x8_bus_Request(client) != 0 )
+    return;
+  while( bus->owner != client )
+    bus->bus_cb(bus, U8X8_MSG_BUS_WAIT, client);
+}
+
+void u8x8_bus_Release(u8x8_bus_client_t *client)
+{
+  u8x8_bus_t *bus = client->bus;
+  u8x8_bus_client_t *next;
+  uint32_t now = u8x8_bus_ticks(bus);
+  
+  bus->bus_cb(bus, U8X8_MSG_BUS_LOCK, client);
+  if ( bus->owner != client )
+  {
+    bus->bus_cb(bus, U8X8_MSG_BUS_UNLOCK, client);
+    return;
+  }
+  client->busy_ticks += now - client->grant_ticks;
+  next = bus->pending;
+  if ( next != NULL )
+  {
+    bus->pending = next->next;
+    next->next = NULL;
+    next->is_pending = 0;
+    u8x8_bus_grant(next, now);
+    client->yield_cnt++;
+  }
+  bus->owner = next;
+  bus->bus_cb(bus, U8X8_MSG_BUS_UNLOCK, client);
+  
+  /* the next client may run its complete transaction inside the bus_cb */
+  if ( next != NULL )
+    bus->bus_cb(bus, U8X8_MSG_BUS_GRANT, next);
+}
+
+/*=========================================*/
+
+void u8x8_SetBusClient(u8x8_t *u8x8, u8x8_bus_client_t *client)
+{
+  if ( u8x8->bus_client != NULL )
+  {
+    u8x8->byte_cb = u8x8->bus_client->byte_cb;
+    u8x8->bus_client = NULL;
+  }
+  if ( client == NULL )
+    return;
+  client->byte_cb = u8x8->byte_cb;
+  u8x8->byte_cb = u8x8_byte_bus;
+  u8x8->bus_client = client;
+}
+
+uint8_t u8x8_byte_bus(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_bus_client_t *client = u8x8->bus_client;
+  uint8_t r;
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_INIT:
+      /* the setup of the bus hardware may disturb other clients */
+      u8x8_bus_Acquire(client);
+      r = client->byte_cb(u8x8, msg, arg_int, arg_ptr);
+      u8x8_bus_Release(client);
+      return r;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      u8x8_bus_Acquire(client);
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      r = client->byte_cb(u8x8, msg, arg_int, arg_ptr);
+      u8x8_bus_Release(client);
+      return r;
+  }
+  return client->byte_cb(u8x8, msg, arg_int, arg_ptr);
+}
+
+#endif /* U8X8_WITH_BUS */
@@ -0,0 +1,336 @@
+/* 
+
+  u8x8_byte_fast.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  
+  Software I2C and 4-wire SPI with direct port access: The clock and data
+  lines are written without the gpio_and_delay_cb, the byte loops are unrolled 
+  and the delays are busy loops from a table, which is calculated once 
+  from the display timing (u8x8_SetFastBus). Chip select, D/C and reset are
+  still set with the gpio_and_delay_cb (once per transfer).
+  
+  Only available with U8X8_WITH_FAST_BUS.
+  
+*/
+
+#include "u8x8.h"
+
+#ifdef U8X8_WITH_FAST_BUS
+
+#ifndef U8X8_FAST_DELAY
+#define U8X8_FAST_DELAY(loops) u8x8_fast_delay(loops)
+static void u8x8_fast_delay(uint16_t loops) U8X8_NOINLINE;
+static void u8x8_fast_delay(uint16_t loops)
+{
+  volatile uint16_t i = loops;
+  while( i > 0 )
+    i--;
+}
+#endif
+
+#define U8X8_FAST_DLY(loops) if ( (loops) != 0 ) U8X8_FAST_DELAY(loops)
+
+/* number of delay loops for t_ns, reduced by port_cnt port accesses, rounded up */
+static uint16_t u8x8_fast_loops(u8x8_fast_bus_t *bus, uint16_t t_ns, uint8_t port_cnt)
+{
+  uint32_t t_ps;
+  uint32_t overhead_ps = (uint32_t)bus->port_ns * port_cnt * 1000UL;
+  
+  t_ps = (uint32_t)t_ns * 1000UL;
+  if ( t_ps <= overhead_ps || bus->loop_ps == 0 )
+    return 0;
+  t_ps -= overhead_ps;
+  t_ps += bus->loop_ps - 1;
+  t_ps /= bus->loop_ps;
+  if ( t_ps > 0xffff )
+    return 0xffff;
+  return t_ps;
+}
+
+void u8x8_CalibrateFastBus(u8x8_fast_bus_t *bus, uint32_t (*get_us)(void))
+{
+  uint32_t t;
+  uint16_t i;
+  
+  t = get_us();
+  U8X8_FAST_DELAY(20000);
+  t = get_us() - t;
+  bus->loop_ps = t * 50;	/* t*1000000ps/20000 */
+  
+  /* the clock line is released at the end (I2C idle) */
+  t = get_us();
+  for( i = 0; i < 1000; i++ )
+  {
+    U8X8_FAST_PORT_CLR(bus->clock_port, bus->clock_mask);
+    U8X8_FAST_PORT_SET(bus->clock_port, bus->clock_mask);
+  }
+  t = get_us() - t;
+  bus->port_ns = t / 2;		/* t*1000ns/2000 */
+}
+
+/*
+  I2C: The clock low time is 52% of the period, which is 1.3us at 400 kHz 
+  (minimum for fast mode). The low phase of a bit includes two port 
+  accesses (clock low and data), but dly_low is also used for the bus 
+  free time after the stop condition, which has only one port access.
+  The high phase includes one port access.
+  SPI: The clock phase before the takeover edge includes one port access 
+  (the data is set before), the phase after the takeover edge includes 
+  two port accesses (clock and data of the next bit).
+*/
+void u8x8_SetFastBus(u8x8_t *u8x8, u8x8_fast_bus_t *bus)
+{
+  uint16_t period_ns;
+  uint16_t low_ns;
+  uint16_t setup_ns;
+  uint8_t clk = u8x8->display_info->i2c_bus_clock_100kHz;
+  
+  u8x8->fast_bus = bus;
+  if ( bus == NULL )
+    return;
+  if ( u8x8->byte_cb == u8x8_byte_fast_sw_i2c )
+  {
+    if ( clk == 0 )
+      clk = 1;
+    period_ns = 10000 / clk;
+    low_ns = (uint16_t)(((uint32_t)period_ns * 13 + 24) / 25);
+    bus->dly_low = u8x8_fast_loops(bus, low_ns, 1);
+    bus->dly_high = u8x8_fast_loops(bus, period_ns - low_ns, 1);
+  }
+  else
+  {
+    setup_ns = u8x8->display_info->sda_setup_time_ns;
+    if ( setup_ns < u8x8->display_info->sck_pulse_width_ns )
+      setup_ns = u8x8->display_info->sck_pulse_width_ns;
+    bus->dly_low = u8x8_fast_loops(bus, setup_ns, 1);
+    bus->dly_high = u8x8_fast_loops(bus, u8x8->display_info->sck_pulse_width_ns, 2);
+  }
+}
+
+/*=========================================*/
+/* I2C */
+
+#define I2C_SCL_LOW() U8X8_FAST_PORT_CLR(bus->clock_port, bus->clock_mask)
+#define I2C_SCL_HIGH() U8X8_FAST_PORT_SET(bus->clock_port, bus->clock_mask)
+#define I2C_SDA_LOW() U8X8_FAST_PORT_CLR(bus->data_port, bus->data_mask)
+#define I2C_SDA_HIGH() U8X8_FAST_PORT_SET(bus->data_port, bus->data_mask)
+
+/* clock is low before and after each bit */
+#define I2C_BIT(b, m) \
+  if ( (b) & (m) ) I2C_SDA_HIGH(); else I2C_SDA_LOW(); \
+  U8X8_FAST_DLY(dly_low); \
+  I2C_SCL_HIGH(); \
+  U8X8_FAST_DLY(dly_high); \
+  I2C_SCL_LOW()
+
+static void u8x8_fast_i2c_write(u8x8_fast_bus_t *bus, uint8_t cnt, const uint8_t *data)
+{
+  uint16_t dly_low = bus->dly_low;
+  uint16_t dly_high = bus->dly_high;
+  uint8_t b;
+  
+  while( cnt > 0 )
+  {
+    b = *data++;
+    I2C_BIT(b, 128);
+    I2C_BIT(b, 64);
+    I2C_BIT(b, 32);
+    I2C_BIT(b, 16);
+    I2C_BIT(b, 8);
+    I2C_BIT(b, 4);
+    I2C_BIT(b, 2);
+    I2C_BIT(b, 1);
+    /* ack is ignored: release the data line for one clock */
+    I2C_BIT(1, 1);
+    cnt--;
+  }
+}
+
+static void u8x8_fast_i2c_start(u8x8_t *u8x8, u8x8_fast_bus_t *bus)
+{
+  if ( u8x8->i2c_started != 0 )
+  {
+    /* repeated start */
+    I2C_SDA_HIGH();
+    U8X8_FAST_DLY(bus->dly_low);
+    I2C_SCL_HIGH();
+    U8X8_FAST_DLY(bus->dly_low);
+  }
+  /* data goes from 1 to 0 while the clock is high */
+  I2C_SDA_LOW();
+  U8X8_FAST_DLY(bus->dly_high);
+  I2C_SCL_LOW();
+  u8x8->i2c_started = 1;
+}
+
+static void u8x8_fast_i2c_stop(u8x8_t *u8x8, u8x8_fast_bus_t *bus)
+{
+  I2C_SDA_LOW();
+  U8X8_FAST_DLY(bus->dly_low);
+  I2C_SCL_HIGH();
+  U8X8_FAST_DLY(bus->dly_high);
+  /* data goes from 0 to 1 while the clock is high, followed by the bus free time */
+  I2C_SDA_HIGH();
+  U8X8_FAST_DLY(bus->dly_low);
+  u8x8->i2c_started = 0;
+}
+
+/* same as u8x8_byte_sw_i2c, but requires u8x8_SetFastBus() */
+uint8_t u8x8_byte_fast_sw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_fast_bus_t *bus = u8x8->fast_bus;
+  uint8_t adr;
+  
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      u8x8_fast_i2c_write(bus, arg_int, (const uint8_t *)arg_ptr);
+      break;
+    case U8X8_MSG_BYTE_INIT:
+      I2C_SCL_HIGH();
+      I2C_SDA_HIGH();
+      U8X8_FAST_DLY(bus->dly_low);
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      u8x8_fast_i2c_start(u8x8, bus);
+      adr = u8x8_GetI2CAddress(u8x8);
+      u8x8_fast_i2c_write(bus, 1, &adr);
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      u8x8_fast_i2c_stop(u8x8, bus);
+      break;
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+/*=========================================*/
+/* SPI */
+
+#define SPI_DATA(b, m) \
+  if ( (b) & (m) ) U8X8_FAST_PORT_SET(bus->data_port, bus->data_mask); \
+  else U8X8_FAST_PORT_CLR(bus->data_port, bus->data_mask)
+
+/* takeover on the rising edge of the clock */
+#define SPI_BIT_RISING(b, m) \
+  SPI_DATA(b, m); \
+  U8X8_FAST_PORT_CLR(bus->clock_port, bus->clock_mask); \
+  U8X8_FAST_DLY(dly_low); \
+  U8X8_FAST_PORT_SET(bus->clock_port, bus->clock_mask); \
+  U8X8_FAST_DLY(dly_high)
+
+#define SPI_BIT_FALLING(b, m) \
+  SPI_DATA(b, m); \
+  U8X8_FAST_PORT_SET(bus->clock_port, bus->clock_mask); \
+  U8X8_FAST_DLY(dly_low); \
+  U8X8_FAST_PORT_CLR(bus->clock_port, bus->clock_mask); \
+  U8X8_FAST_DLY(dly_high)
+
+static void u8x8_fast_spi_write(u8x8_fast_bus_t *bus, uint8_t takeover_edge, uint8_t cnt, const uint8_t *data)
+{
+  uint16_t dly_low = bus->dly_low;
+  uint16_t dly_high = bus->dly_high;
+  uint8_t b;
+  
+  if ( takeover_edge != 0 )
+  {
+    while( cnt > 0 )
+    {
+      b = *data++;
+      SPI_BIT_RISING(b, 128);
+      SPI_BIT_RISING(b, 64);
+      SPI_BIT_RISING(b, 32);
+      SPI_BIT_RISING(b, 16);
+      SPI_BIT_RISING(b, 8);
+      SPI_BIT_RISING(b, 4);
+      SPI_BIT_RISING(b, 2);
+      SPI_BIT_RISING(b, 1);
+      cnt--;
+    }
+  }
+  else
+  {
+    while( cnt > 0 )
+    {
+      b = *data++;
+      SPI_BIT_FALLING(b, 128);
+      SPI_BIT_FALLING(b, 64);
+      SPI_BIT_FALLING(b, 32);
+      SPI_BIT_FALLING(b, 16);
+      SPI_BIT_FALLING(b, 8);
+      SPI_BIT_FALLING(b, 4);
+      SPI_BIT_FALLING(b, 2);
+      SPI_BIT_FALLING(b, 1);
+      cnt--;
+    }
+  }
+}
+
+/* same as u8x8_byte_4wire_sw_spi, but requires u8x8_SetFastBus() */
+uint8_t u8x8_byte_fast_4wire_sw_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_fast_bus_t *bus = u8x8->fast_bus;
+  
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      /* u8x8_GetSPIClockPhase() is the level after the takeover edge (see u8x8_byte_4wire_sw_spi) */
+      u8x8_fast_spi_write(bus, u8x8_GetSPIClockPhase(u8x8), arg_int, (const uint8_t *)arg_ptr);
+      break;
+    case U8X8_MSG_BYTE_INIT:
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+      if ( u8x8_GetSPIClockPhase(u8x8) )
+	U8X8_FAST_PORT_SET(bus->clock_port, bus->clock_mask);
+      else
+	U8X8_FAST_PORT_CLR(bus->clock_port, bus->clock_mask);
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      u8x8_gpio_SetDC(u8x8, arg_int);
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_enable_level);  
+      u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->post_chip_enable_wait_ns, NULL);
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_NANO, u8x8->display_info->pre_chip_disable_wait_ns, NULL);
+      u8x8_gpio_SetCS(u8x8, u8x8->display_info->chip_disable_level);
+      break;
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+#endif /* U8X8_WITH_FAST_BUS */
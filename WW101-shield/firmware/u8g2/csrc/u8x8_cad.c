@@ -316,7 +316,7 @@ uint8_t u8x8_cad_st7920_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
   uint8_t *data;
   uint8_t b;
   uint8_t i;
-  static uint8_t buf[16];
+  uint8_t buf[16];
   uint8_t *ptr;
   
   switch(msg)
@@ -386,59 +386,102 @@ uint8_t u8x8_cad_st7920_spi(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *ar
 /* this procedure is also used by the ST7588 */
 /* u8x8_byte_SetDC is not used */
 /* U8X8_MSG_BYTE_START_TRANSFER starts i2c transfer, U8X8_MSG_BYTE_END_TRANSFER stops transfer */
-/* After transfer start, a full byte indicates command or data mode */
+/* After transfer start, a control byte (Co, D/C) indicates command or data mode */
+/*
+  Commands and data between U8X8_MSG_CAD_START_TRANSFER and U8X8_MSG_CAD_END_TRANSFER
+  are combined into one i2c transfer:
+    0x80 cmd 0x80 arg ... 0x40 data data data ...
+  Co=1 (0x80): one command byte follows, then the next control byte.
+  Co=0, D/C=1 (0x40): all remaining bytes of the transfer are data bytes.
+  A new i2c transfer is started for commands after data or if the transfer
+  would exceed U8X8_I2C_MAX_TRANSFER bytes. Outside of START/END_TRANSFER, 
+  each message is sent with its own i2c transfer.
+*/
 
-static void u8x8_i2c_data_transfer(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr) U8X8_NOINLINE;
-static void u8x8_i2c_data_transfer(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr)
+static void u8x8_i2c_end(u8x8_t *u8x8)
 {
-    u8x8_byte_StartTransfer(u8x8);    
-    u8x8_byte_SendByte(u8x8, 0x040);
-    u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, arg_int, arg_ptr);
+  if ( u8x8->cad_i2c_state != 0 )
+  {
     u8x8_byte_EndTransfer(u8x8);
+    u8x8->cad_i2c_state = 0;
+  }
+}
+
+/* make sure that an i2c transfer in command mode with space for n bytes is open */
+static void u8x8_i2c_cmd_space(u8x8_t *u8x8, uint8_t n) U8X8_NOINLINE;
+static void u8x8_i2c_cmd_space(u8x8_t *u8x8, uint8_t n)
+{
+  if ( u8x8->cad_i2c_state == 2 || (uint16_t)u8x8->cad_i2c_cnt + n > U8X8_I2C_MAX_TRANSFER )
+    u8x8_i2c_end(u8x8);
+  if ( u8x8->cad_i2c_state == 0 )
+  {
+    u8x8_byte_StartTransfer(u8x8);
+    u8x8->cad_i2c_state = 1;
+    u8x8->cad_i2c_cnt = 0;
+  }
+}
+
+static void u8x8_i2c_cmd(u8x8_t *u8x8, uint8_t cmd)
+{
+  uint8_t buf[2];
+  u8x8_i2c_cmd_space(u8x8, 2);
+  buf[0] = 0x080;
+  buf[1] = cmd;
+  u8x8_byte_SendBytes(u8x8, 2, buf);
+  u8x8->cad_i2c_cnt += 2;
+}
+
+static void u8x8_i2c_data(u8x8_t *u8x8, uint8_t arg_int, uint8_t *p)
+{
+  uint8_t cnt;
+  while( arg_int > 0 )
+  {
+    if ( u8x8->cad_i2c_state != 2 || u8x8->cad_i2c_cnt >= U8X8_I2C_MAX_TRANSFER )
+    {
+      /* switch to data mode, at least one data byte must fit into the transfer */
+      u8x8_i2c_cmd_space(u8x8, 2);
+      u8x8_byte_SendByte(u8x8, 0x040);
+      u8x8->cad_i2c_cnt++;
+      u8x8->cad_i2c_state = 2;
+    }
+    cnt = U8X8_I2C_MAX_TRANSFER - u8x8->cad_i2c_cnt;
+    if ( cnt > arg_int )
+      cnt = arg_int;
+    u8x8_byte_SendBytes(u8x8, cnt, p);
+    u8x8->cad_i2c_cnt += cnt;
+    p += cnt;
+    arg_int -= cnt;
+  }
 }
 
 uint8_t u8x8_cad_ssd13xx_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  uint8_t *p;
   switch(msg)
   {
     case U8X8_MSG_CAD_SEND_CMD:
     case U8X8_MSG_CAD_SEND_ARG:
-      /* 7 Nov 2016: Can this be improved?  */
-      //u8x8_byte_SetDC(u8x8, 0);
-      u8x8_byte_StartTransfer(u8x8);
-      //u8x8_byte_SendByte(u8x8, u8x8_GetI2CAddress(u8x8));
-      u8x8_byte_SendByte(u8x8, 0x000);
-      u8x8_byte_SendByte(u8x8, arg_int);
-      u8x8_byte_EndTransfer(u8x8);      
+      u8x8_i2c_cmd(u8x8, arg_int);
+      if ( u8x8->cad_is_transfer == 0 )
+	u8x8_i2c_end(u8x8);
       break;
     case U8X8_MSG_CAD_SEND_DATA:
-      //u8x8_byte_SetDC(u8x8, 1);
-    
-      /* the FeatherWing OLED with the 32u4 transfer of long byte */
-      /* streams was not possible. This is broken down to */
-      /* smaller streams, 32 seems to be the limit... */
-      /* I guess this is related to the size of the Wire buffers in Arduino */
-      /* Unfortunately, this can not be handled in the byte level drivers, */
-      /* so this is done here. Even further, only 24 bytes will be sent, */
-      /* because there will be another byte (DC) required during the transfer */
-      p = arg_ptr;
-       while( arg_int > 24 )
-      {
-	u8x8_i2c_data_transfer(u8x8, 24, p);
-	arg_int-=24;
-	p+=24;
-      }
-      u8x8_i2c_data_transfer(u8x8, arg_int, p);
+      u8x8_i2c_data(u8x8, arg_int, (uint8_t *)arg_ptr);
+      if ( u8x8->cad_is_transfer == 0 )
+	u8x8_i2c_end(u8x8);
       break;
     case U8X8_MSG_CAD_INIT:
       /* apply default i2c adr if required so that the start transfer msg can use this */
       if ( u8x8->i2c_address == 255 )
 	u8x8->i2c_address = 0x078;
+      u8x8->cad_is_transfer = 0;
+      u8x8->cad_i2c_state = 0;
       return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
     case U8X8_MSG_CAD_START_TRANSFER:
+      u8x8->cad_is_transfer = 1;
+      break;
     case U8X8_MSG_CAD_END_TRANSFER:
-      /* cad transfer commands are ignored */
+      u8x8_i2c_end(u8x8);
+      u8x8->cad_is_transfer = 0;
       break;
     default:
       return 0;
@@ -0,0 +1,147 @@
+/* 
+
+  u8x8_console.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  Text console: Characters are written at the cursor position. If the cursor
+  is in the bottom row and the row is full or a \n is received, all rows
+  move up by one row.
+  
+  Hardware scroll: The display memory is used as ring buffer. Only the
+  display start line (U8X8_MSG_DISPLAY_SET_START_LINE) is changed and the
+  new bottom row is cleared. 
+  Without hardware scroll support, all rows are drawn again.
+  
+*/
+
+#include "u8x8.h"
+#include <string.h>
+
+/* tile row in the display memory for the visible row */
+static uint8_t u8x8_console_get_mem_row(u8x8_console_t *con, uint8_t row)
+{
+  row += con->top_row;
+  if ( row >= con->rows )
+    row -= con->rows;
+  return row;
+}
+
+static void u8x8_console_draw_row(u8x8_t *u8x8, u8x8_console_t *con, uint8_t mem_row)
+{
+  char *s = con->buf + (uint16_t)mem_row*con->cols;
+  uint8_t x;
+  for( x = 0; x < con->cols; x++ )
+    u8x8_DrawGlyph(u8x8, x, mem_row, (uint8_t)s[x]);
+}
+
+static void u8x8_console_clear_row(u8x8_t *u8x8, u8x8_console_t *con, uint8_t mem_row)
+{
+  uint8_t buf[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  u8x8_tile_t tile;
+  
+  memset(con->buf + (uint16_t)mem_row*con->cols, ' ', con->cols);
+  tile.x_pos = 0;
+  tile.y_pos = mem_row;
+  tile.cnt = 1;
+  tile.tile_ptr = buf;
+  u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_TILE, con->cols, (void *)&tile);
+}
+
+static void u8x8_console_scroll(u8x8_t *u8x8, u8x8_console_t *con)
+{
+  uint8_t row;
+  
+  if ( con->is_hw_scroll )
+  {
+    /* the old top row becomes the new bottom row: clear it before it is */
+    /* moved to the bottom, so that the old text is never visible there */
+    row = con->top_row;
+    con->top_row = u8x8_console_get_mem_row(con, 1);
+    u8x8_console_clear_row(u8x8, con, row);
+    u8x8_SetDisplayStartLine(u8x8, con->top_row*8);
+  }
+  else
+  {
+    memmove(con->buf, con->buf + con->cols, (uint16_t)(con->rows-1)*con->cols);
+    for( row = 0; row < con->rows-1; row++ )
+      u8x8_console_draw_row(u8x8, con, row);
+    u8x8_console_clear_row(u8x8, con, con->rows-1);
+  }
+}
+
+static void u8x8_console_new_line(u8x8_t *u8x8, u8x8_console_t *con)
+{
+  con->cursor_x = 0;
+  if ( con->cursor_y+1 < con->rows )
+    con->cursor_y++;
+  else
+    u8x8_console_scroll(u8x8, con);
+}
+
+void u8x8_ConsoleInit(u8x8_t *u8x8, u8x8_console_t *con, char *buf)
+{
+  con->buf = buf;
+  con->cols = u8x8->display_info->tile_width;
+  con->rows = u8x8->display_info->tile_height;
+  con->cursor_x = 0;
+  con->cursor_y = 0;
+  con->top_row = 0;
+  con->is_hw_scroll = u8x8_SetDisplayStartLine(u8x8, 0);
+  memset(buf, ' ', (uint16_t)con->rows*con->cols);
+  u8x8_ClearDisplay(u8x8);
+}
+
+void u8x8_ConsoleWrite(u8x8_t *u8x8, u8x8_console_t *con, const char *s)
+{
+  uint8_t mem_row;
+  
+  while( *s != '\0' )
+  {
+    if ( *s == '\n' )
+    {
+      u8x8_console_new_line(u8x8, con);
+    }
+    else if ( *s == '\r' )
+    {
+      con->cursor_x = 0;
+    }
+    else
+    {
+      if ( con->cursor_x >= con->cols )
+	u8x8_console_new_line(u8x8, con);
+      mem_row = u8x8_console_get_mem_row(con, con->cursor_y);
+      con->buf[(uint16_t)mem_row*con->cols + con->cursor_x] = *s;
+      u8x8_DrawGlyph(u8x8, con->cursor_x, mem_row, (uint8_t)*s);
+      con->cursor_x++;
+    }
+    s++;
+  }
+}
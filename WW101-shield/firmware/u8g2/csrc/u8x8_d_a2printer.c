@@ -159,7 +159,8 @@ static const u8x8_display_info_t u8x8_a2printer_384x240_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 384,
-  /* pixel_height = */ 240
+  /* pixel_height = */ 240,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_a2printer_384x240(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -92,7 +92,8 @@ static const u8x8_display_info_t u8x8_ist3020_erc19264_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 64,
   /* pixel_width = */ 192,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 static const uint8_t u8x8_d_ist3020_erc19264_init_seq[] = {
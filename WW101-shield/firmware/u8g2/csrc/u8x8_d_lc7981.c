@@ -210,7 +210,8 @@ static const u8x8_display_info_t u8x8_lc7981_160x80_display_info =
   /* default_x_offset = */ 0,	
   /* flipmode_x_offset = */ 0,	
   /* pixel_width = */ 160,
-  /* pixel_height = */ 80
+  /* pixel_height = */ 80,
+  /* flags = */ 0
 };
 
 static const uint8_t u8x8_d_lc7981_160x80_init_seq[] = {
@@ -285,7 +286,8 @@ static const u8x8_display_info_t u8x8_lc7981_240x128_display_info =
   /* default_x_offset = */ 0,	
   /* flipmode_x_offset = */ 0,	
   /* pixel_width = */ 240,
-  /* pixel_height = */ 128
+  /* pixel_height = */ 128,
+  /* flags = */ 0
 };
 
 static const uint8_t u8x8_d_lc7981_240x128_init_seq[] = {
@@ -191,7 +191,8 @@ static const u8x8_display_info_t u8x8_ld7032_60x32_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 60,
-  /* pixel_height = */ 32
+  /* pixel_height = */ 32,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_ld7032_60x32(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
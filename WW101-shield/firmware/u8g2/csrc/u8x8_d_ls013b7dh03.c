@@ -64,7 +64,8 @@ static const u8x8_display_info_t u8x8_ls013b7dh03_128x128_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 128
+  /* pixel_height = */ 128,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_ls013b7dh03_128x128(u8x8_t *u8x8, uint8_t msg, U8X8_UNUSED uint8_t arg_int, void *arg_ptr)
@@ -95,7 +95,8 @@ static const u8x8_display_info_t u8x8_pcd8544_84x48_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 84,
-  /* pixel_height = */ 48
+  /* pixel_height = */ 48,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_pcd8544_84x48(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -177,7 +177,8 @@ static const u8x8_display_info_t u8x8_pcf8812_96x65_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 96,
-  /* pixel_height = */ 65
+  /* pixel_height = */ 65,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_pcf8812_96x65(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -145,7 +145,8 @@ static const u8x8_display_info_t u8x8_sed1330_240x128_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 240,
-  /* pixel_height = */ 128
+  /* pixel_height = */ 128,
+  /* flags = */ 0
 };
 
 /* 240x128 Seiko G242C */
@@ -152,7 +152,8 @@ static const u8x8_display_info_t u8x8_ssd1305_128x32_noname_display_info =
   /* default_x_offset = */ 2,
   /* flipmode_x_offset = */ 2,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 32
+  /* pixel_height = */ 32,
+  /* flags = */ 0
 };
 
 
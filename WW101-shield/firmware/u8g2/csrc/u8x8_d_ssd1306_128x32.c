@@ -50,7 +50,7 @@ static const uint8_t u8x8_d_ssd1306_128x32_univision_init_seq[] = {
   U8X8_CA(0x0d3, 0x000),		/* display offset */
   U8X8_C(0x040),		                /* set display start line to 0 */
   U8X8_CA(0x08d, 0x014),		/* [2] charge pump setting (p62): 0x014 enable, 0x010 disable */
-  U8X8_CA(0x020, 0x000),		/* page addressing mode */
+  U8X8_CA(0x020, 0x000),		/* horizontal addressing mode */
   
   U8X8_C(0x0a1),				/* segment remap a0/a1*/
   U8X8_C(0x0c8),				/* c0: scan dir normal, c8: reverse */
@@ -143,6 +143,8 @@ static uint8_t u8x8_d_ssd1306_128x32_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
       u8x8_cad_EndTransfer(u8x8);
       break;
 #endif
+    case U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK:
+      return u8x8_d_ssd1306_draw_tile_block(u8x8, arg_int, (u8x8_tile_t *)arg_ptr);
     case U8X8_MSG_DISPLAY_DRAW_TILE:
       u8x8_cad_StartTransfer(u8x8);
       x = ((u8x8_tile_t *)arg_ptr)->x_pos;    
@@ -198,7 +200,8 @@ static const u8x8_display_info_t u8x8_ssd1306_128x32_univision_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 32
+  /* pixel_height = */ 32,
+  /* flags = */ U8X8_DISPLAY_FLAG_TILE_BLOCK
 };
 
 uint8_t u8x8_d_ssd1306_128x32_univision(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -50,7 +50,7 @@ static const uint8_t u8x8_d_ssd1306_128x64_noname_init_seq[] = {
   U8X8_CA(0x0d3, 0x000),		/* display offset */
   U8X8_C(0x040),		                /* set display start line to 0 */
   U8X8_CA(0x08d, 0x014),		/* [2] charge pump setting (p62): 0x014 enable, 0x010 disable */
-  U8X8_CA(0x020, 0x000),		/* page addressing mode */
+  U8X8_CA(0x020, 0x000),		/* horizontal addressing mode */
   
   U8X8_C(0x0a1),				/* segment remap a0/a1*/
   U8X8_C(0x0c8),				/* c0: scan dir normal, c8: reverse */
@@ -87,7 +87,7 @@ static const uint8_t u8x8_d_ssd1306_128x64_vcomh0_init_seq[] = {
   U8X8_CA(0x0d3, 0x000),		/* display offset */
   U8X8_C(0x040),		                /* set display start line to 0 */
   U8X8_CA(0x08d, 0x014),		/* [2] charge pump setting (p62): 0x014 enable, 0x010 disable */
-  U8X8_CA(0x020, 0x000),		/* page addressing mode */
+  U8X8_CA(0x020, 0x000),		/* horizontal addressing mode */
   
   U8X8_C(0x0a1),				/* segment remap a0/a1*/
   U8X8_C(0x0c8),				/* c0: scan dir normal, c8: reverse */
@@ -140,6 +140,61 @@ static const uint8_t u8x8_d_ssd1306_128x64_noname_flip1_seq[] = {
 };
 
 
+/*
+  U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK for the SSD1306 (not for the SH1106):
+  The init sequence selects the horizontal addressing mode (0x20, 0x00), so
+  the address is incremented to the next page at the end of the column window.
+  The window is set once (0x21, 0x22) and all tiles are sent as one data 
+  burst. Afterwards both windows are restored to the complete display 
+  memory (columns 0..127, pages 0..7), which is expected by DRAW_TILE.
+*/
+uint8_t u8x8_d_ssd1306_draw_tile_block(u8x8_t *u8x8, uint8_t rows, u8x8_tile_t *tile)
+{
+  uint16_t cnt;
+  uint8_t x, w, c, y_end;
+  uint8_t *ptr;
+  
+  if ( tile->y_pos >= u8x8->display_info->tile_height )
+    return 1;
+  y_end = tile->y_pos + rows - 1;
+  if ( y_end >= u8x8->display_info->tile_height )
+    y_end = u8x8->display_info->tile_height - 1;
+  
+  x = tile->x_pos;
+  x *= 8;
+  x += u8x8->x_offset;
+  w = tile->cnt;
+  w *= 8;
+  cnt = w;
+  cnt *= y_end - tile->y_pos + 1;	/* rows below the display are not sent */
+  
+  u8x8_cad_StartTransfer(u8x8);
+  u8x8_cad_SendCmd(u8x8, 0x021 );
+  u8x8_cad_SendArg(u8x8, x);
+  u8x8_cad_SendArg(u8x8, x + w - 1);
+  u8x8_cad_SendCmd(u8x8, 0x022 );
+  u8x8_cad_SendArg(u8x8, tile->y_pos);
+  u8x8_cad_SendArg(u8x8, y_end);
+  
+  ptr = tile->tile_ptr;
+  while( cnt > 0 )
+  {
+    c = cnt > 248 ? 248 : cnt;		/* SendData can not handle more than 255 bytes */
+    u8x8_cad_SendData(u8x8, c, ptr);
+    ptr += c;
+    cnt -= c;
+  }
+  
+  u8x8_cad_SendCmd(u8x8, 0x021 );
+  u8x8_cad_SendArg(u8x8, 0);
+  u8x8_cad_SendArg(u8x8, 127);
+  u8x8_cad_SendCmd(u8x8, 0x022 );
+  u8x8_cad_SendArg(u8x8, 0);
+  u8x8_cad_SendArg(u8x8, 7);
+  u8x8_cad_EndTransfer(u8x8);
+  return 1;
+}
+
 static uint8_t u8x8_d_ssd1306_sh1106_generic(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
   uint8_t x, c;
@@ -183,13 +238,18 @@ static uint8_t u8x8_d_ssd1306_sh1106_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
       u8x8_cad_EndTransfer(u8x8);
       break;
 #endif
+    case U8X8_MSG_DISPLAY_SET_START_LINE:
+      u8x8_cad_StartTransfer(u8x8);
+      u8x8_cad_SendCmd(u8x8, 0x040 | (arg_int & 63) );
+      u8x8_cad_EndTransfer(u8x8);
+      break;
     case U8X8_MSG_DISPLAY_DRAW_TILE:
       u8x8_cad_StartTransfer(u8x8);
       x = ((u8x8_tile_t *)arg_ptr)->x_pos;    
       x *= 8;
       x += u8x8->x_offset;
     
-      u8x8_cad_SendCmd(u8x8, 0x040 );	/* set line offset to 0 */
+      /* the display start line is not changed here, see U8X8_MSG_DISPLAY_SET_START_LINE */
     
       u8x8_cad_SendCmd(u8x8, 0x010 | (x>>4) );
       u8x8_cad_SendArg(u8x8, 0x000 | ((x&15)));					/* probably wrong, should be SendCmd */
@@ -242,7 +302,8 @@ static const u8x8_display_info_t u8x8_ssd1306_128x64_noname_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ U8X8_DISPLAY_FLAG_TILE_BLOCK | U8X8_DISPLAY_FLAG_START_LINE
 };
 
 uint8_t u8x8_d_ssd1306_128x64_noname(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -260,6 +321,8 @@ uint8_t u8x8_d_ssd1306_128x64_noname(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
     case U8X8_MSG_DISPLAY_SETUP_MEMORY:
       u8x8_d_helper_display_setup_memory(u8x8, &u8x8_ssd1306_128x64_noname_display_info);
       break;
+    case U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK:
+      return u8x8_d_ssd1306_draw_tile_block(u8x8, arg_int, (u8x8_tile_t *)arg_ptr);
     default:
       return 0;
   }
@@ -281,6 +344,8 @@ uint8_t u8x8_d_ssd1306_128x64_vcomh0(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int,
     case U8X8_MSG_DISPLAY_SETUP_MEMORY:
       u8x8_d_helper_display_setup_memory(u8x8, &u8x8_ssd1306_128x64_noname_display_info);
       break;
+    case U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK:
+      return u8x8_d_ssd1306_draw_tile_block(u8x8, arg_int, (u8x8_tile_t *)arg_ptr);
     default:
       return 0;
   }
@@ -309,7 +374,8 @@ static const u8x8_display_info_t u8x8_sh1106_128x64_noname_display_info =
   /* default_x_offset = */ 2,
   /* flipmode_x_offset = */ 2,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ U8X8_DISPLAY_FLAG_START_LINE
 };
 
 uint8_t u8x8_d_sh1106_128x64_noname(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -148,7 +148,8 @@ static const u8x8_display_info_t u8x8_ssd1309_128x64_noname_display_info =
   /* default_x_offset = */ 2,
   /* flipmode_x_offset = */ 2,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 
@@ -110,8 +110,8 @@ static const uint8_t u8x8_d_ssd1322_256x64_flip1_seq[] = {
 /* 4 Jan 2017: I think this procedure not required any more. Delete? */
 uint8_t u8x8_write_byte_to_16gr_device(u8x8_t *u8x8, uint8_t b)
 {
-  static uint8_t buf[4];
-  static uint8_t map[4] = { 0, 0x00f, 0x0f0, 0x0ff };
+  uint8_t buf[4];
+  static const uint8_t map[4] = { 0, 0x00f, 0x0f0, 0x0ff };
   buf [3] = map[b & 3];
   b>>=2;
   buf [2] = map[b & 3];
@@ -130,9 +130,7 @@ uint8_t u8x8_write_byte_to_16gr_device(u8x8_t *u8x8, uint8_t b)
     Tile for SSD1325 (32 Bytes)
 */
 
-static uint8_t u8x8_ssd1322_8to32_dest_buf[32];
-
-static uint8_t *u8x8_ssd1322_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
+static uint8_t *u8x8_ssd1322_8to32(uint8_t *dest_buf, uint8_t *ptr)
 {
   uint8_t v;
   uint8_t a,b;
@@ -141,7 +139,7 @@ static uint8_t *u8x8_ssd1322_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
   
   for( j = 0; j < 4; j++ )
   {
-    dest = u8x8_ssd1322_8to32_dest_buf;
+    dest = dest_buf;
     dest += j;
     a =*ptr;
     ptr++;
@@ -159,15 +157,16 @@ static uint8_t *u8x8_ssd1322_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
     }
   }
   
-  return u8x8_ssd1322_8to32_dest_buf;
+  return dest_buf;
 }
 
 
 uint8_t u8x8_d_ssd1322_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
   uint8_t x; 
-  uint8_t y, c;
+  uint8_t y, c, i;
   uint8_t *ptr;
+  uint8_t buf[32];
   switch(msg)
   {
     /* U8X8_MSG_DISPLAY_SETUP_MEMORY is handled by the calling function */
@@ -232,7 +231,7 @@ uint8_t u8x8_d_ssd1322_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *
 	  
 	  u8x8_cad_SendCmd(u8x8, 0x05c );	/* write to ram */
 	  
-	  u8x8_cad_SendData(u8x8, 32, u8x8_ssd1322_8to32(u8x8, ptr));
+	  u8x8_cad_SendData(u8x8, 32, u8x8_ssd1322_8to32(buf, ptr));
 	  
 	  ptr += 8;
 	  x += 2;
@@ -243,6 +242,42 @@ uint8_t u8x8_d_ssd1322_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *
 	arg_int--;
       } while( arg_int > 0 );
       
+      u8x8_cad_EndTransfer(u8x8);
+      break;
+    case U8X8_MSG_DISPLAY_DRAW_GRAY_TILE:
+      /* the data is already in the display memory format: one address window for all tiles */
+      u8x8_cad_StartTransfer(u8x8);
+      x = ((u8x8_tile_t *)arg_ptr)->x_pos;    
+      x *= 2;		// only every 4th col can be addressed
+      x += u8x8->x_offset;		
+    
+      y = (((u8x8_tile_t *)arg_ptr)->y_pos);
+      y *= 8;
+      
+      c = ((u8x8_tile_t *)arg_ptr)->cnt;
+      do
+      {
+	u8x8_cad_SendCmd(u8x8, 0x015 );	/* set column address */
+	u8x8_cad_SendArg(u8x8, x );	/* start */
+	u8x8_cad_SendArg(u8x8, x+c*2-1 );	/* end */
+
+	u8x8_cad_SendCmd(u8x8, 0x075 );	/* set row address */
+	u8x8_cad_SendArg(u8x8, y);
+	u8x8_cad_SendArg(u8x8, y+7);
+	
+	u8x8_cad_SendCmd(u8x8, 0x05c );	/* write to ram */
+	
+	ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
+	for( i = 0; i < 8; i++ )
+	{
+	  u8x8_cad_SendData(u8x8, c*4, ptr);	/* one pixel line, c must not exceed 63 */
+	  ptr += c*4;
+	}
+	
+	x += c*2;
+	arg_int--;
+      } while( arg_int > 0 );
+      
       u8x8_cad_EndTransfer(u8x8);
       break;
     default:
@@ -272,7 +307,8 @@ static const u8x8_display_info_t u8x8_ssd1322_256x64_display_info =
   /* default_x_offset = */ 0x01c,	/* this is the byte offset (there are two pixel per byte with 4 bit per pixel) */
   /* flipmode_x_offset = */ 0x01c,
   /* pixel_width = */ 256,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 
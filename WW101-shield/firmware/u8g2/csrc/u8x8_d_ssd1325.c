@@ -114,9 +114,7 @@ static const uint8_t u8x8_d_ssd1325_128x64_nhd_flip1_seq[] = {
     Tile for SSD1325 (32 Bytes)
 */
 
-static uint8_t u8x8_ssd1325_8to32_dest_buf[32];
-
-static uint8_t *u8x8_ssd1325_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
+static uint8_t *u8x8_ssd1325_8to32(uint8_t *dest_buf, uint8_t *ptr)
 {
   uint8_t v;
   uint8_t a,b;
@@ -125,7 +123,7 @@ static uint8_t *u8x8_ssd1325_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
   
   for( j = 0; j < 4; j++ )
   {
-    dest = u8x8_ssd1325_8to32_dest_buf;
+    dest = dest_buf;
     dest += j;
     a =*ptr;
     ptr++;
@@ -143,7 +141,7 @@ static uint8_t *u8x8_ssd1325_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
     }
   }
   
-  return u8x8_ssd1325_8to32_dest_buf;
+  return dest_buf;
 }
 
 
@@ -151,8 +149,9 @@ static uint8_t *u8x8_ssd1325_8to32(U8X8_UNUSED u8x8_t *u8x8, uint8_t *ptr)
 
 static uint8_t u8x8_d_ssd1325_128x64_generic(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-  uint8_t x, y, c;
+  uint8_t x, y, c, i;
   uint8_t *ptr;
+  uint8_t buf[32];
   switch(msg)
   {
     /* handled by the calling function
@@ -219,7 +218,7 @@ static uint8_t u8x8_d_ssd1325_128x64_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
 	    u8x8_cad_SendArg(u8x8, y+7);
 	    
 	    
-	    u8x8_cad_SendData(u8x8, 32, u8x8_ssd1325_8to32(u8x8, ptr));
+	    u8x8_cad_SendData(u8x8, 32, u8x8_ssd1325_8to32(buf, ptr));
 	  }
 	  else
 	  {
@@ -240,6 +239,40 @@ static uint8_t u8x8_d_ssd1325_128x64_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
 	arg_int--;
       } while( arg_int > 0 );
       
+      u8x8_cad_EndTransfer(u8x8);
+      break;
+    case U8X8_MSG_DISPLAY_DRAW_GRAY_TILE:
+      /* the data is already in the display memory format: one address window for all tiles */
+      u8x8_cad_StartTransfer(u8x8);
+      x = ((u8x8_tile_t *)arg_ptr)->x_pos;    
+      x *= 4;
+    
+      y = (((u8x8_tile_t *)arg_ptr)->y_pos);
+      y *= 8;
+      y += u8x8->x_offset;		/* x_offset is used as y offset for the SSD1325 */
+      
+      c = ((u8x8_tile_t *)arg_ptr)->cnt;
+      do
+      {
+	u8x8_cad_SendCmd(u8x8, 0x015 );	/* set column address */
+	u8x8_cad_SendArg(u8x8, x );	/* start */
+	u8x8_cad_SendArg(u8x8, x+c*4-1 );	/* end */
+
+	u8x8_cad_SendCmd(u8x8, 0x075 );	/* set row address */
+	u8x8_cad_SendArg(u8x8, y);
+	u8x8_cad_SendArg(u8x8, y+7);
+	
+	ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
+	for( i = 0; i < 8; i++ )
+	{
+	  u8x8_cad_SendData(u8x8, c*4, ptr);	/* one pixel line, c must not exceed 63 */
+	  ptr += c*4;
+	}
+	
+	x += c*4;
+	arg_int--;
+      } while( arg_int > 0 );
+      
       u8x8_cad_EndTransfer(u8x8);
       break;
     default:
@@ -270,7 +303,8 @@ static const u8x8_display_info_t u8x8_nhd_ssd1325_128x64_display_info =
   /* default_x_offset = */ 0,		/* x_offset is used as y offset for the SSD1325 */
   /* flipmode_x_offset = */ 8,		/* x_offset is used as y offset for the SSD1325 */
   /* pixel_width = */ 128,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_ssd1325_nhd_128x64(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
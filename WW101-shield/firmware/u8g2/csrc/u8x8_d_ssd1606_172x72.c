@@ -80,6 +80,19 @@ static const uint8_t u8x8_d_ssd1606_172x72_gde021a1_init_seq[] = {
   U8X8_CA(0xf0, 0x1f),	/* set booster feedback to internal */
   U8X8_CA(0x22, 0xc0),	/* display update seq. option: enable clk, enable CP, .... todo: this is never activated */
   
+  U8X8_CA(0x2c, 0xa0),	/* write vcom value*/
+  U8X8_CA(0x3c, 0x63),	/* select boarder waveform */
+  U8X8_CA(0x22, 0xc4),	/* display update seq. option: clk -> CP -> LUT -> initial display -> pattern display */
+    /* 0x0c4 is mentioned in chapter 9.2 of the GDE021A1 data sheet */
+  
+  U8X8_END_TRANSFER(),             	/* disable chip */
+  U8X8_END()             			/* end of sequence */
+};
+
+/* full refresh LUT, part of the init sequence */
+static const uint8_t u8x8_d_ssd1606_172x72_lut_full_seq[] = {
+  U8X8_START_TRANSFER(),             	/* enable chip, delay is part of the transfer start */
+  
   U8X8_C(0x32),	/* write LUT register*/
 
 #ifdef ORIGINAL_LUT
@@ -141,14 +154,50 @@ static const uint8_t u8x8_d_ssd1606_172x72_gde021a1_init_seq[] = {
 
 #endif
   
-  U8X8_CA(0x2c, 0xa0),	/* write vcom value*/
-  U8X8_CA(0x3c, 0x63),	/* select boarder waveform */
-  U8X8_CA(0x22, 0xc4),	/* display update seq. option: clk -> CP -> LUT -> initial display -> pattern display */
-    /* 0x0c4 is mentioned in chapter 9.2 of the GDE021A1 data sheet */
+  U8X8_END_TRANSFER(),             	/* disable chip */
+  U8X8_END()             			/* end of sequence */
+};
+
+#ifdef U8X8_WITH_EPD
+/* 
+  partial refresh LUT (U8X8_WITH_EPD): same as the LUT above, but without 
+  steps 0 to 2, which drive the pixels to the light gray levels first, 
+  same values are not changed 
+*/
+static const uint8_t u8x8_d_ssd1606_172x72_lut_partial_seq[] = {
+  U8X8_START_TRANSFER(),             	/* enable chip, delay is part of the transfer start */
+  U8X8_C(0x32),	/* write LUT register*/
+  
+  /* 03 02 01 00	13 12 11 10 	23 22 21 20	33 32 31 30 */
+  U8X8_A4(0x00,0x00,0x00,0x00),		/* step 0 */
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(L(2, 2, 2, 0), 	L(2, 2, 0, 2), 	L(2, 0, 2, 2), 	L(0, 2, 2, 2)),		// step 3
+  U8X8_A4(L(0, 1, 1, 0), 	L(0, 1, 0, 1), 	L(0, 0, 1, 1), 	L(0, 1, 1, 1)),		// step 4
+  U8X8_A4(L(0, 0, 1, 0), 	L(0, 0, 0, 1), 	L(0, 0, 1, 1), 	L(0, 0, 1, 1)),		// step 5
+  U8X8_A4(L(0, 0, 0, 0), 	L(0, 0, 0, 1), 	L(0, 0, 0, 1), 	L(0, 0, 0, 1)),		// step 6
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),
+  U8X8_A4(0x00,0x00,0x00,0x00),	/* step 19 */
+  
+  /* timing part of the LUT, no time for step 0 and 1 */
+  U8X8_A8(0x00,0xFB,0x22,0x1B,0x00,0x00,0x00,0x00),
+  U8X8_A(0x00),U8X8_A(0x00),
   
   U8X8_END_TRANSFER(),             	/* disable chip */
   U8X8_END()             			/* end of sequence */
 };
+#endif
 
 static const uint8_t u8x8_d_ssd1606_to_display_seq[] = {
   U8X8_START_TRANSFER(),             	/* enable chip, delay is part of the transfer start */
@@ -199,11 +248,10 @@ static const uint8_t u8x8_d_ssd1606_172x72_flip1_seq[] = {
 };
 
 
-static uint8_t *u8x8_convert_tile_for_ssd1606(uint8_t *t)
+static uint8_t *u8x8_convert_tile_for_ssd1606(uint8_t *buf, uint8_t *t)
 {
   uint8_t i;
   uint16_t r;
-  static uint8_t buf[16];
   uint8_t *pbuf = buf;
 
   for( i = 0; i < 8; i++ )
@@ -219,6 +267,7 @@ static void u8x8_d_ssd1606_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_pt
 static void u8x8_d_ssd1606_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr)
 {
   uint8_t x, c, page;
+  uint8_t buf[16];
   uint8_t *ptr;
   u8x8_cad_StartTransfer(u8x8);
 
@@ -260,7 +309,7 @@ static void u8x8_d_ssd1606_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_pt
     ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
     do
     {
-      u8x8_cad_SendData(u8x8, 16, u8x8_convert_tile_for_ssd1606(ptr));
+      u8x8_cad_SendData(u8x8, 16, u8x8_convert_tile_for_ssd1606(buf, ptr));
       ptr += 8;
       x += 8;
       c--;
@@ -275,6 +324,9 @@ static void u8x8_d_ssd1606_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_pt
 
 static uint8_t u8x8_d_ssd1606_172x72_generic(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+#ifdef U8X8_WITH_EPD
+  u8x8_epd_t *epd;
+#endif
   switch(msg)
   {
     /* handled by the calling function
@@ -284,8 +336,12 @@ static uint8_t u8x8_d_ssd1606_172x72_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
     */
     case U8X8_MSG_DISPLAY_INIT:
 
+#ifdef U8X8_WITH_EPD
+      epd = u8x8_epd_BeginInit(u8x8);
+#endif
       u8x8_d_helper_display_init(u8x8);
       u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1606_172x72_gde021a1_init_seq);    
+      u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1606_172x72_lut_full_seq);    
     
       /* special code for the SSD1606... */
       /* ensure that the initial buffer is clear and all eInk is set to white */
@@ -307,6 +363,9 @@ static uint8_t u8x8_d_ssd1606_172x72_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
       /* write content to the display */
       u8x8_RefreshDisplay(u8x8);
     
+#ifdef U8X8_WITH_EPD
+      u8x8_epd_EndInit(u8x8, epd);
+#endif
       break;
     case U8X8_MSG_DISPLAY_SET_POWER_SAVE:
 /*
@@ -339,11 +398,22 @@ static uint8_t u8x8_d_ssd1606_172x72_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
       break;
 #endif
     case U8X8_MSG_DISPLAY_DRAW_TILE:
+#ifdef U8X8_WITH_EPD
+      u8x8_epd_BeforeDrawTile(u8x8);
+#endif
       u8x8_d_ssd1606_draw_tile(u8x8, arg_int, arg_ptr);
       break;
     case U8X8_MSG_DISPLAY_REFRESH:
+#ifdef U8X8_WITH_EPD
+      if ( u8x8_epd_Refresh(u8x8, u8x8_d_ssd1606_172x72_lut_full_seq, u8x8_d_ssd1606_172x72_lut_partial_seq) )
+	break;
+#endif
       u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1606_to_display_seq);    
       break;
+#ifdef U8X8_WITH_EPD
+    case U8X8_MSG_DISPLAY_POLL_REFRESH:
+      return u8x8_epd_Poll(u8x8);
+#endif
     default:
       return 0;
   }
@@ -372,7 +442,8 @@ static const u8x8_display_info_t u8x8_ssd1606_172x72_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 172,
-  /* pixel_height = */ 72		
+  /* pixel_height = */ 72,		
+  /* flags = */ U8X8_DISPLAY_FLAG_POLL_REFRESH
 };
 
 uint8_t u8x8_d_ssd1606_172x72(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
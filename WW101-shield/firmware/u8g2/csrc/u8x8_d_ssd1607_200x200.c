@@ -90,6 +90,20 @@ static const uint8_t u8x8_d_ssd1607_200x200_init_seq[] = {
   U8X8_CA(0xf0, 0x1f),	/* set booster feedback to internal */
   U8X8_CA(0x22, 0xc0),	/* display update seq. option: enable clk, enable CP, .... todo: this is never activated */
   
+  U8X8_CA(0x2c, 0xa8),	/* write vcom value*/
+  U8X8_CA(0x3a, 0x1a),	/* dummy lines */
+  U8X8_CA(0x3b, 0x08),	/* gate time */
+  U8X8_CA(0x3c, 0x33),	/* select boarder waveform */
+  U8X8_CA(0x22, 0xc4),	/* display update seq. option: clk -> CP -> LUT -> initial display -> pattern display */
+  
+  U8X8_END_TRANSFER(),             	/* disable chip */
+  U8X8_END()             			/* end of sequence */
+};
+
+/* full refresh LUT, part of the init sequence */
+static const uint8_t u8x8_d_ssd1607_200x200_lut_full_seq[] = {
+  U8X8_START_TRANSFER(),             	/* enable chip, delay is part of the transfer start */
+  
   U8X8_C(0x32),	/* write LUT register*/
 
   
@@ -189,17 +203,44 @@ static const uint8_t u8x8_d_ssd1607_200x200_init_seq[] = {
   U8X8_A(0x01),
   U8X8_A(0x00),
   
-  
+  U8X8_END_TRANSFER(),             	/* disable chip */
+  U8X8_END()             			/* end of sequence */
+};
 
-  U8X8_CA(0x2c, 0xa8),	/* write vcom value*/
-  U8X8_CA(0x3a, 0x1a),	/* dummy lines */
-  U8X8_CA(0x3b, 0x08),	/* gate time */
-  U8X8_CA(0x3c, 0x33),	/* select boarder waveform */
-  U8X8_CA(0x22, 0xc4),	/* display update seq. option: clk -> CP -> LUT -> initial display -> pattern display */
+#ifdef U8X8_WITH_EPD
+/* 
+  partial refresh LUT (U8X8_WITH_EPD): no voltage for the 0-0 and 1-1 transitions, 
+  so only changed pixels are driven, four short phases 
+*/
+static const uint8_t u8x8_d_ssd1607_200x200_lut_partial_seq[] = {
+  U8X8_START_TRANSFER(),             	/* enable chip, delay is part of the transfer start */
+  U8X8_C(0x32),	/* write LUT register*/
+  
+  /* Waveform part of the LUT (20 bytes) */
+  U8X8_A(L(0,1,0,0)), // 0x10
+  U8X8_A(L(0,1,2,0)), // 0x18
+  U8X8_A(L(0,1,2,0)), // 0x18
+  U8X8_A(L(0,0,2,0)), // 0x08
+  U8X8_A(L(0,1,2,0)), // 0x18
+  U8X8_A(L(0,1,2,0)), // 0x18
+  U8X8_A(L(0,0,2,0)), // 0x08
+  U8X8_A(L(0,0,0,0)), U8X8_A(L(0,0,0,0)), U8X8_A(L(0,0,0,0)), 
+  U8X8_A(L(0,0,0,0)), U8X8_A(L(0,0,0,0)), U8X8_A(L(0,0,0,0)), 
+  U8X8_A(L(0,0,0,0)), U8X8_A(L(0,0,0,0)), U8X8_A(L(0,0,0,0)), 
+  U8X8_A(L(0,0,0,0)), U8X8_A(L(0,0,0,0)), U8X8_A(L(0,0,0,0)), 
+  U8X8_A(L(0,0,0,0)),
+  
+  /* Timing part of the LUT, 20 Phases with 4 bit each: 10 bytes */
+  U8X8_A(0x13),
+  U8X8_A(0x14),
+  U8X8_A(0x44),
+  U8X8_A(0x12),
+  U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00), U8X8_A(0x00),
   
   U8X8_END_TRANSFER(),             	/* disable chip */
   U8X8_END()             			/* end of sequence */
 };
+#endif
 
 static const uint8_t u8x8_d_ssd1607_to_display_seq[] = {
   U8X8_START_TRANSFER(),             	/* enable chip, delay is part of the transfer start */
@@ -248,10 +289,9 @@ static const uint8_t u8x8_d_ssd1607_200x200_flip1_seq[] = {
 };
 
 
-static uint8_t *u8x8_convert_tile_for_ssd1607(uint8_t *t)
+static uint8_t *u8x8_convert_tile_for_ssd1607(uint8_t *buf, uint8_t *t)
 {
   uint8_t i;
-  static uint8_t buf[8];
   uint8_t *pbuf = buf;
 
   for( i = 0; i < 8; i++ )
@@ -266,6 +306,7 @@ static void u8x8_d_ssd1607_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_pt
 {
   uint16_t x;
   uint8_t c, page;
+  uint8_t buf[8];
   uint8_t *ptr;
   u8x8_cad_StartTransfer(u8x8);
 
@@ -312,7 +353,7 @@ static void u8x8_d_ssd1607_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_pt
     ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
     do
     {
-      u8x8_cad_SendData(u8x8, 8, u8x8_convert_tile_for_ssd1607(ptr));
+      u8x8_cad_SendData(u8x8, 8, u8x8_convert_tile_for_ssd1607(buf, ptr));
       ptr += 8;
       x += 8;
       c--;
@@ -327,6 +368,9 @@ static void u8x8_d_ssd1607_draw_tile(u8x8_t *u8x8, uint8_t arg_int, void *arg_pt
 
 static uint8_t u8x8_d_ssd1607_200x200_generic(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+#ifdef U8X8_WITH_EPD
+  u8x8_epd_t *epd;
+#endif
   switch(msg)
   {
     /* handled by the calling function
@@ -336,8 +380,12 @@ static uint8_t u8x8_d_ssd1607_200x200_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
     */
     case U8X8_MSG_DISPLAY_INIT:
 
+#ifdef U8X8_WITH_EPD
+      epd = u8x8_epd_BeginInit(u8x8);
+#endif
       u8x8_d_helper_display_init(u8x8);
       u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1607_200x200_init_seq);    
+      u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1607_200x200_lut_full_seq);    
     
 #ifdef NOT_USED
       /* STRATEGY FOR SSD1606 */
@@ -362,6 +410,9 @@ static uint8_t u8x8_d_ssd1607_200x200_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
       /* write content to the display */
       u8x8_RefreshDisplay(u8x8);
     
+#ifdef U8X8_WITH_EPD
+      u8x8_epd_EndInit(u8x8, epd);
+#endif
       break;
     case U8X8_MSG_DISPLAY_SET_POWER_SAVE:
 /*
@@ -394,11 +445,22 @@ static uint8_t u8x8_d_ssd1607_200x200_generic(u8x8_t *u8x8, uint8_t msg, uint8_t
       break;
 #endif
     case U8X8_MSG_DISPLAY_DRAW_TILE:
+#ifdef U8X8_WITH_EPD
+      u8x8_epd_BeforeDrawTile(u8x8);
+#endif
       u8x8_d_ssd1607_draw_tile(u8x8, arg_int, arg_ptr);
       break;
     case U8X8_MSG_DISPLAY_REFRESH:
+#ifdef U8X8_WITH_EPD
+      if ( u8x8_epd_Refresh(u8x8, u8x8_d_ssd1607_200x200_lut_full_seq, u8x8_d_ssd1607_200x200_lut_partial_seq) )
+	break;
+#endif
       u8x8_cad_SendSequence(u8x8, u8x8_d_ssd1607_to_display_seq);    
       break;
+#ifdef U8X8_WITH_EPD
+    case U8X8_MSG_DISPLAY_POLL_REFRESH:
+      return u8x8_epd_Poll(u8x8);
+#endif
     default:
       return 0;
   }
@@ -428,7 +490,8 @@ static const u8x8_display_info_t u8x8_ssd1607_200x200_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 200,
-  /* pixel_height = */ 200		
+  /* pixel_height = */ 200,		
+  /* flags = */ U8X8_DISPLAY_FLAG_POLL_REFRESH
 };
 
 uint8_t u8x8_d_ssd1607_200x200(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -168,7 +168,8 @@ static const u8x8_display_info_t u8x8_st75256_256x128_display_info =
   /* default_x_offset = */ 0,	/* must be 0, because this is checked also for normal mode */
   /* flipmode_x_offset = */ 0,		
   /* pixel_width = */ 256,
-  /* pixel_height = */ 128
+  /* pixel_height = */ 128,
+  /* flags = */ 0
 };
 
 
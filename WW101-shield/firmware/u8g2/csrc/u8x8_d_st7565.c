@@ -109,7 +109,8 @@ static const u8x8_display_info_t u8x8_st7565_128x64_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 4,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_st7565_common(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -334,7 +335,8 @@ static const u8x8_display_info_t u8x8_st7565_128x32_display_info =
   /* default_x_offset = */ 4,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 32
+  /* pixel_height = */ 32,
+  /* flags = */ 0
 };
 
 
@@ -424,7 +426,8 @@ static const u8x8_display_info_t u8x8_st7565_nhd_c12864_display_info =
   /* default_x_offset = */ 4,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 
@@ -544,7 +547,8 @@ static const u8x8_display_info_t u8x8_st7565_lm6059_display_info =
   /* default_x_offset = */ 1,	/* not sure... */
   /* flipmode_x_offset = */ 3,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_st7565_lm6059(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -636,7 +640,8 @@ static const u8x8_display_info_t u8x8_st7565_erc12864_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 4,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_st7565_erc12864(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
@@ -770,7 +775,8 @@ static const u8x8_display_info_t u8x8_st7565_dogm132_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 132,
-  /* pixel_height = */ 32
+  /* pixel_height = */ 32,
+  /* flags = */ 0
 };
 
 
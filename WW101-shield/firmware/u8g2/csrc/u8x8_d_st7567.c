@@ -92,7 +92,8 @@ static const u8x8_display_info_t u8x8_st7567_132x64_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 132,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 static const uint8_t u8x8_d_st7567_132x64_init_seq[] = {
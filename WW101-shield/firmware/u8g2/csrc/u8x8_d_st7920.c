@@ -170,7 +170,8 @@ static const u8x8_display_info_t u8x8_st7920_192x32_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 192,
-  /* pixel_height = */ 32
+  /* pixel_height = */ 32,
+  /* flags = */ 0
 };
 
 static const u8x8_display_info_t u8x8_st7920_128x64_display_info =
@@ -196,7 +197,8 @@ static const u8x8_display_info_t u8x8_st7920_128x64_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_st7920_192x32(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
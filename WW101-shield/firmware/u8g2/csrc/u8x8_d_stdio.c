@@ -40,16 +40,26 @@
 #define W 8
 #define H 2
 
-uint8_t bitmap[W*H*8];
+/* default bitmap, used if there is no user_ptr */
+static uint8_t u8x8_stdio_bitmap[W*H*8];
 
-void bitmap_place_tile(uint8_t x, uint8_t y, uint8_t *tile)
+static uint8_t *bitmap_get(U8X8_UNUSED u8x8_t *u8x8)
+{
+#ifdef U8X8_WITH_USER_PTR
+  if ( u8x8->user_ptr != NULL )
+    return (uint8_t *)u8x8->user_ptr;
+#endif
+  return u8x8_stdio_bitmap;
+}
+
+static void bitmap_place_tile(uint8_t *bitmap, uint8_t x, uint8_t y, uint8_t *tile)
 {
   uint8_t i;
   for(i = 0; i < 8; i++ )
     bitmap[x*8+y*W*8+i] = tile[i];
 }
 
-void bitmap_show(void)
+static void bitmap_show(uint8_t *bitmap)
 {
   int x, y;
   for( y = 0; y < H*8; y++ )
@@ -70,7 +80,7 @@ void bitmap_show(void)
 }
 
 
-uint8_t u8x8_d_stdio(U8X8_UNUSED u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+uint8_t u8x8_d_stdio(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
   switch(msg)
   {
@@ -78,12 +88,12 @@ uint8_t u8x8_d_stdio(U8X8_UNUSED u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, voi
       break;
     case U8X8_MSG_DISPLAY_SET_POWER_SAVE:
       if ( arg_int == 0 )
-	bitmap_show();
+	bitmap_show(bitmap_get(u8x8));
       break;
     case U8X8_MSG_DISPLAY_SET_CONTRAST:
       break;
     case U8X8_MSG_DISPLAY_DRAW_TILE:      
-      bitmap_place_tile(((u8x8_tile_t *)arg_ptr)->x_pos, ((u8x8_tile_t *)arg_ptr)->y_pos, ((u8x8_tile_t *)arg_ptr)->tile_ptr);
+      bitmap_place_tile(bitmap_get(u8x8), ((u8x8_tile_t *)arg_ptr)->x_pos, ((u8x8_tile_t *)arg_ptr)->y_pos, ((u8x8_tile_t *)arg_ptr)->tile_ptr);
       break;
     default:
       break;
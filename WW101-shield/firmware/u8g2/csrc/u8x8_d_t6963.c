@@ -144,7 +144,8 @@ static const u8x8_display_info_t u8x8_t6963_240x128_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 240,
-  /* pixel_height = */ 128
+  /* pixel_height = */ 128,
+  /* flags = */ 0
 };
 
 /* 240x128 */
@@ -228,7 +229,8 @@ static const u8x8_display_info_t u8x8_t6963_240x64_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 240,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 
@@ -315,7 +317,8 @@ static const u8x8_display_info_t u8x8_t6963_256x64_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 256,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 /* 256x64 */
@@ -398,7 +401,8 @@ static const u8x8_display_info_t u8x8_t6963_128x64_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 /* 128x64 */
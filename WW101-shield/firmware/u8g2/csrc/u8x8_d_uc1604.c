@@ -176,7 +176,8 @@ static const u8x8_display_info_t u8x8_uc1604_192x64_display_info =
   /* default_x_offset = */ 0,	/* reused as y page offset */
   /* flipmode_x_offset = */ 0,	/* reused as y page offset */
   /* pixel_width = */ 192,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 static const uint8_t u8x8_d_uc1604_jlx19264_init_seq[] = {
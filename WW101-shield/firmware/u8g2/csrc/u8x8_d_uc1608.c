@@ -169,7 +169,8 @@ static const u8x8_display_info_t u8x8_uc1608_240x64_display_info =
   /* default_x_offset = */ 0,	/* reused as y page offset */
   /* flipmode_x_offset = */ 4,	/* reused as y page offset */
   /* pixel_width = */ 240,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 static const uint8_t u8x8_d_uc1608_erc24064_init_seq[] = {
@@ -250,7 +251,8 @@ static const u8x8_display_info_t u8x8_uc1608_240x128_display_info =
   /* default_x_offset = */ 0,	/* reused as y page offset */
   /* flipmode_x_offset = */ 0,	/* reused as y page offset */
   /* pixel_width = */ 240,
-  /* pixel_height = */ 128
+  /* pixel_height = */ 128,
+  /* flags = */ 0
 };
 
 static const uint8_t u8x8_d_uc1608_240x128_init_seq[] = {
@@ -173,7 +173,8 @@ static const u8x8_display_info_t u8x8_uc1611_240x64_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 240,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 static const uint8_t u8x8_d_uc1611_ea_dogm240_init_seq[] = {
@@ -272,7 +273,8 @@ static const u8x8_display_info_t u8x8_uc1611_240x128_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 240,
-  /* pixel_height = */ 128
+  /* pixel_height = */ 128,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_uc1611_ea_dogxl240(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
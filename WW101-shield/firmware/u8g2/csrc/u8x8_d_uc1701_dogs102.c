@@ -121,7 +121,8 @@ static const u8x8_display_info_t u8x8_uc1701_display_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 30,
   /* pixel_width = */ 102,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 uint8_t u8x8_d_uc1701_ea_dogs102(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
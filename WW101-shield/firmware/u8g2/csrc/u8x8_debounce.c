@@ -141,6 +141,16 @@ uint8_t u8x8_GetMenuEvent(u8x8_t *u8x8)
   uint8_t pin_state;
   uint8_t result_msg = 0;	/* invalid message */
   
+#ifdef U8X8_WITH_EVENT
+  if ( u8x8->event_queue != NULL )
+  {
+    u8x8_event_t event;
+    if ( u8x8_event_Pop(u8x8->event_queue, &event) == 0 )
+      return 0;
+    return event.msg;
+  }
+#endif
+  
   pin_state = u8x8_read_pin_state(u8x8);
   
   /* States A, B, C & D are encoded in the upper 4 bit*/
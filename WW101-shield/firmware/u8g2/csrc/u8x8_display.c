@@ -89,6 +89,33 @@ uint8_t u8x8_DrawTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *
   return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_TILE, 1, (void *)&tile);
 }
 
+uint8_t u8x8_DrawGrayTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *tile_ptr)
+{
+  u8x8_tile_t tile;
+  tile.x_pos = x;
+  tile.y_pos = y;
+  tile.cnt = cnt;
+  tile.tile_ptr = tile_ptr;
+  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_GRAY_TILE, 1, (void *)&tile);
+}
+
+/*
+  Only sent if the display info has U8X8_DISPLAY_FLAG_TILE_BLOCK, because 
+  many display procedures return 1 for unknown messages.
+  Returns 0 if the display does not support tile blocks.
+*/
+uint8_t u8x8_DrawTileBlock(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t rows, uint8_t *tile_ptr)
+{
+  u8x8_tile_t tile;
+  if ( (u8x8->display_info->flags & U8X8_DISPLAY_FLAG_TILE_BLOCK) == 0 )
+    return 0;
+  tile.x_pos = x;
+  tile.y_pos = y;
+  tile.cnt = cnt;
+  tile.tile_ptr = tile_ptr;
+  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK, rows, (void *)&tile);
+}
+
 /* should be implemented as macro */
 void u8x8_SetupMemory(u8x8_t *u8x8)
 {
@@ -120,6 +147,35 @@ void u8x8_RefreshDisplay(u8x8_t *u8x8)
   u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_REFRESH, 0, NULL);  
 }
 
+/*
+  Only sent if the display info has U8X8_DISPLAY_FLAG_POLL_REFRESH,
+  otherwise u8x8_WaitRefresh() would not return for display procedures, 
+  which return 1 for unknown messages.
+*/
+uint8_t u8x8_IsRefreshBusy(u8x8_t *u8x8)
+{
+  if ( (u8x8->display_info->flags & U8X8_DISPLAY_FLAG_POLL_REFRESH) == 0 )
+    return 0;
+  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_POLL_REFRESH, 0, NULL);  
+}
+
+void u8x8_WaitRefresh(u8x8_t *u8x8)
+{
+  while( u8x8_IsRefreshBusy(u8x8) )
+    u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_MILLI, 1);
+}
+
+/*
+  Only sent if the display info has U8X8_DISPLAY_FLAG_START_LINE.
+  Returns 0 if the display does not support hardware scrolling.
+*/
+uint8_t u8x8_SetDisplayStartLine(u8x8_t *u8x8, uint8_t line)
+{
+  if ( (u8x8->display_info->flags & U8X8_DISPLAY_FLAG_START_LINE) == 0 )
+    return 0;
+  return u8x8->display_cb(u8x8, U8X8_MSG_DISPLAY_SET_START_LINE, line, NULL);  
+}
+
 void u8x8_ClearDisplayWithTile(u8x8_t *u8x8, const uint8_t *buf)
 {
   u8x8_tile_t tile;
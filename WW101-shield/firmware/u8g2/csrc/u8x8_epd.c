@@ -0,0 +1,212 @@
+/* 
+
+  u8x8_epd.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  
+  Partial and non-blocking refresh for the SSD1606 and SSD1607 e-paper 
+  controllers.
+  
+  u8x8_RefreshDisplay() starts the update of the panel and returns. The
+  BUSY output of the display is checked with u8x8_IsRefreshBusy(), which
+  also sends the power down command after the update. DRAW_TILE waits for 
+  the end of the refresh, so the next frame can be rendered while the
+  panel is updated.
+  
+  Partial refresh: The partial LUT drives only pixels which change their 
+  color, so the panel does not flash and the update is much faster. The
+  controllers always update the complete panel, unchanged areas are not
+  touched by the partial LUT. A refresh without new content is skipped.
+  After full_interval partial refreshes, the full LUT is used again to
+  remove the ghosting. 
+  
+  The controllers compare the new with the previous image. The complete 
+  frame (or at least the area of the previous update) must be written 
+  before each refresh, which is done by u8g2_SendBuffer() and the page loop.
+  
+  Only available with U8X8_WITH_EPD.
+  
+*/
+
+#include "u8x8.h"
+
+#ifdef U8X8_WITH_EPD
+
+static const uint8_t u8x8_epd_start_seq[] = {
+  U8X8_START_TRANSFER(),             	/* enable chip, delay is part of the transfer start */
+  U8X8_CA(0x22, 0xc4),	/* display update seq. option: clk -> CP -> LUT -> initial display -> pattern display */
+  U8X8_C(0x20),	/* execute sequence */
+  U8X8_END_TRANSFER(),             	/* disable chip */
+  U8X8_DLY(1),	/* BUSY is set after the command */
+  U8X8_END()             			/* end of sequence */
+};
+
+static const uint8_t u8x8_epd_power_down_seq[] = {
+  U8X8_START_TRANSFER(),             	/* enable chip, delay is part of the transfer start */
+  U8X8_CA(0x22, 0x03),	/* disable clock and charge pump */
+  U8X8_C(0x20),	/* execute sequence */
+  U8X8_END_TRANSFER(),             	/* disable chip */
+  U8X8_DLY(1),	/* BUSY is set after the command */
+  U8X8_END()             			/* end of sequence */
+};
+
+static uint8_t u8x8_epd_is_busy(u8x8_t *u8x8)
+{
+  /* not busy, if the gpio procedure does not know the BUSY pin */
+  u8x8_SetGPIOResult(u8x8, 0);
+  u8x8_gpio_call(u8x8, U8X8_MSG_GPIO_BUSY, 0);
+  return u8x8->gpio_result;
+}
+
+static void u8x8_epd_wait(u8x8_t *u8x8)
+{
+  while( u8x8_epd_Poll(u8x8) )
+    u8x8_gpio_Delay(u8x8, U8X8_MSG_DELAY_MILLI, 1);
+}
+
+void u8x8_SetEpd(u8x8_t *u8x8, u8x8_epd_t *epd, uint8_t full_interval)
+{
+  if ( u8x8->epd != NULL )
+    u8x8_epd_wait(u8x8);
+  u8x8->epd = epd;
+  if ( epd == NULL )
+    return;
+  epd->full_interval = full_interval;
+  epd->partial_cnt = full_interval;	/* start with a full refresh */
+  epd->state = U8X8_EPD_IDLE;
+  epd->lut = U8X8_EPD_LUT_UNKNOWN;
+  epd->is_dirty = 1;
+  epd->full_refresh_cnt = 0;
+  epd->partial_refresh_cnt = 0;
+  epd->skipped_refresh_cnt = 0;
+}
+
+void u8x8_RequestFullRefresh(u8x8_t *u8x8)
+{
+  if ( u8x8->epd == NULL )
+    return;
+  u8x8->epd->partial_cnt = u8x8->epd->full_interval;
+  u8x8->epd->is_dirty = 1;
+}
+
+/* 
+  The init sequence of the display procedure uses the blocking full refresh:
+  epd = u8x8_epd_BeginInit(u8x8); ... u8x8_epd_EndInit(u8x8, epd); 
+*/
+u8x8_epd_t *u8x8_epd_BeginInit(u8x8_t *u8x8)
+{
+  u8x8_epd_t *epd = u8x8->epd;
+  if ( epd == NULL )
+    return NULL;
+  u8x8_epd_wait(u8x8);
+  u8x8->epd = NULL;
+  return epd;
+}
+
+/* the init sequence has loaded the full LUT and has refreshed the display */
+void u8x8_epd_EndInit(u8x8_t *u8x8, u8x8_epd_t *epd)
+{
+  if ( epd == NULL )
+    return;
+  epd->lut = U8X8_EPD_LUT_FULL;
+  epd->partial_cnt = 0;
+  epd->is_dirty = 0;
+  u8x8->epd = epd;
+}
+
+/* the controller does not accept data during the refresh */
+void u8x8_epd_BeforeDrawTile(u8x8_t *u8x8)
+{
+  if ( u8x8->epd == NULL )
+    return;
+  u8x8_epd_wait(u8x8);
+  u8x8->epd->is_dirty = 1;
+}
+
+/* returns 0 if the blocking refresh of the display procedure must be used */
+uint8_t u8x8_epd_Refresh(u8x8_t *u8x8, const uint8_t *lut_full_seq, const uint8_t *lut_partial_seq)
+{
+  u8x8_epd_t *epd = u8x8->epd;
+  uint8_t lut;
+  
+  if ( epd == NULL )
+    return 0;
+  u8x8_epd_wait(u8x8);
+  if ( epd->is_dirty == 0 )
+  {
+    epd->skipped_refresh_cnt++;
+    return 1;
+  }
+  
+  if ( epd->partial_cnt >= epd->full_interval )
+  {
+    lut = U8X8_EPD_LUT_FULL;
+    epd->partial_cnt = 0;
+    epd->full_refresh_cnt++;
+  }
+  else
+  {
+    lut = U8X8_EPD_LUT_PARTIAL;
+    epd->partial_cnt++;
+    epd->partial_refresh_cnt++;
+  }
+  if ( epd->lut != lut )
+  {
+    u8x8_cad_SendSequence(u8x8, lut == U8X8_EPD_LUT_FULL ? lut_full_seq : lut_partial_seq);
+    epd->lut = lut;
+  }
+  
+  u8x8_cad_SendSequence(u8x8, u8x8_epd_start_seq);
+  epd->state = U8X8_EPD_REFRESH;
+  epd->is_dirty = 0;
+  return 1;
+}
+
+/* U8X8_MSG_DISPLAY_POLL_REFRESH, does not block */
+uint8_t u8x8_epd_Poll(u8x8_t *u8x8)
+{
+  u8x8_epd_t *epd = u8x8->epd;
+  if ( epd == NULL || epd->state == U8X8_EPD_IDLE )
+    return 0;
+  if ( u8x8_epd_is_busy(u8x8) )
+    return 1;
+  if ( epd->state == U8X8_EPD_REFRESH )
+  {
+    /* charge pump and clock are only enabled during the update */
+    u8x8_cad_SendSequence(u8x8, u8x8_epd_power_down_seq);
+    epd->state = U8X8_EPD_POWER_DOWN;
+    return 1;
+  }
+  epd->state = U8X8_EPD_IDLE;
+  return 0;
+}
+
+#endif /* U8X8_WITH_EPD */
@@ -0,0 +1,144 @@
+/* 
+
+  u8x8_event.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  
+  Menu events from interrupts.
+  
+  GPIO interrupts (u8x8_event_PushPin()) or other event sources like 
+  the CapSense interrupt of the shield (u8x8_event_Push()) store the 
+  menu events with a time stamp in a ring buffer. Presses are not lost 
+  while the user interface draws the display.
+  
+  With u8x8_SetEventQueue(), u8x8_GetMenuEvent() takes the events from
+  the queue instead of polling the menu pins, so the existing user 
+  interface procedures work without change. u8x8_WaitMenuEvent() lets 
+  the gpio procedure sleep (U8X8_MSG_DELAY_EVENT) until the next event.
+  
+  Only available with U8X8_WITH_EVENT.
+  
+*/
+
+#include "u8x8.h"
+
+#ifdef U8X8_WITH_EVENT
+
+void u8x8_event_InitQueue(u8x8_event_queue_t *queue, u8x8_event_t *event_list, uint8_t size, uint16_t debounce_time)
+{
+  uint8_t i;
+  queue->event_list = event_list;
+  queue->head = 0;
+  queue->tail = 0;
+  queue->mask = size-1;
+  queue->pressed_pins = 0;
+  queue->debounce_time = debounce_time;
+  for( i = 0; i < U8X8_PIN_INPUT_CNT; i++ )
+    queue->pin_time[i] = 0;
+  queue->overflow_cnt = 0;
+}
+
+uint8_t u8x8_event_Push(u8x8_event_queue_t *queue, uint8_t msg, uint32_t time)
+{
+  uint8_t head = queue->head;
+  volatile u8x8_event_t *event;
+  
+  if ( ((head+1) & queue->mask) == queue->tail )
+  {
+    queue->overflow_cnt++;
+    return 0;
+  }
+  event = queue->event_list + head;
+  event->time = time;
+  event->msg = msg;
+  /* the event is visible for the consumer after this assignment */
+  queue->head = (head+1) & queue->mask;
+  return 1;
+}
+
+void u8x8_event_PushPin(u8x8_event_queue_t *queue, uint8_t pin, uint8_t level, uint32_t time)
+{
+  uint8_t idx = pin - U8X8_PIN_OUTPUT_CNT;
+  uint8_t mask = 1<<idx;
+  
+  if ( idx >= U8X8_PIN_INPUT_CNT )
+    return;
+  if ( level == 0 && (queue->pressed_pins & mask) != 0 )
+    return;		/* already pressed */
+  if ( level != 0 && (queue->pressed_pins & mask) == 0 )
+    return;		/* already released */
+  if ( (uint32_t)(time - queue->pin_time[idx]) < queue->debounce_time )
+    return;		/* bounce */
+  
+  queue->pin_time[idx] = time;
+  if ( level == 0 )
+  {
+    queue->pressed_pins |= mask;
+    u8x8_event_Push(queue, U8X8_MSG_GPIO(pin), time);
+  }
+  else
+  {
+    queue->pressed_pins &= ~mask;
+  }
+}
+
+uint8_t u8x8_event_Pop(u8x8_event_queue_t *queue, u8x8_event_t *event)
+{
+  uint8_t tail = queue->tail;
+  volatile u8x8_event_t *e;
+  
+  if ( tail == queue->head )
+    return 0;
+  e = queue->event_list + tail;
+  event->time = e->time;
+  event->msg = e->msg;
+  /* the element can be used by the producer after this assignment */
+  queue->tail = (tail+1) & queue->mask;
+  return 1;
+}
+
+void u8x8_SetEventQueue(u8x8_t *u8x8, u8x8_event_queue_t *queue)
+{
+  u8x8->event_queue = queue;
+}
+
+uint8_t u8x8_WaitMenuEvent(u8x8_t *u8x8)
+{
+  u8x8_event_t event;
+  
+  if ( u8x8->event_queue == NULL )
+    return u8x8_GetMenuEvent(u8x8);
+  while( u8x8_event_Pop(u8x8->event_queue, &event) == 0 )
+    u8x8->gpio_and_delay_cb(u8x8, U8X8_MSG_DELAY_EVENT, 0, u8x8->event_queue);
+  return event.msg;
+}
+
+#endif /* U8X8_WITH_EVENT */
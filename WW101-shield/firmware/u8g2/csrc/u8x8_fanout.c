@@ -0,0 +1,289 @@
+/* 
+
+  u8x8_fanout.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  
+  One render object, several identical displays.
+  
+  u8x8_SetFanout() replaces the display procedure of a u8x8 or u8g2 
+  object by u8x8_d_fanout(). Text and graphics are rendered once, 
+  the resulting tiles are forwarded to all attached targets. Each 
+  target is a u8x8 object with its own bus setup (i2c address, 
+  chip select), usually for the same display controller.
+  
+  Targets can be attached and detached at any time. An attached 
+  target is initialized and receives the power save, flip mode and 
+  contrast state of the render object. All tile rows of the new 
+  target are marked as dirty. A dirty row is sent completely with 
+  the next DRAW_TILE for this row.
+  
+  With a shadow buffer, the fan-out keeps a copy of the display memory: 
+  Unchanged tiles are not sent to the targets and the dirty rows of a 
+  target can be sent without new DRAW_TILE messages
+  (u8x8_UpdateFanoutTargets()). 
+  
+  DRAW_TILE_BLOCK is not supported, u8g2 falls back to DRAW_TILE.
+  
+  Only available with U8X8_WITH_FANOUT.
+  
+*/
+
+#include "u8x8.h"
+#include <string.h>
+
+#ifdef U8X8_WITH_FANOUT
+
+static uint32_t u8x8_fanout_row_mask(uint8_t y)
+{
+  if ( y >= 31 )
+    return ((uint32_t)1)<<31;
+  return ((uint32_t)1)<<y;
+}
+
+/* rows >= 31 share the last bit, it is cleared with the last row of the display */
+static void u8x8_fanout_clear_dirty(u8x8_t *u8x8, u8x8_fanout_target_t *target, uint8_t y)
+{
+  if ( y >= 31 && y+1 < u8x8->display_info->tile_height )
+    return;
+  target->dirty_rows &= ~u8x8_fanout_row_mask(y);
+}
+
+static void u8x8_fanout_draw(u8x8_fanout_target_t *target, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *tile_ptr)
+{
+  u8x8_tile_t tile;
+  tile.x_pos = x;
+  tile.y_pos = y;
+  tile.cnt = cnt;
+  tile.tile_ptr = tile_ptr;
+  target->u8x8->display_cb(target->u8x8, U8X8_MSG_DISPLAY_DRAW_TILE, 1, (void *)&tile);
+  target->tile_cnt += cnt;
+}
+
+static void u8x8_fanout_send(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int)
+{
+  u8x8_fanout_t *fanout = u8x8->fanout;
+  uint8_t i;
+  for( i = 0; i < fanout->target_cnt; i++ )
+    if ( fanout->target_list[i].is_attached )
+      fanout->target_list[i].u8x8->display_cb(fanout->target_list[i].u8x8, msg, arg_int, NULL);
+}
+
+/* send a complete tile row from the shadow buffer */
+static void u8x8_fanout_draw_row(u8x8_t *u8x8, u8x8_fanout_target_t *target, uint8_t y)
+{
+  uint8_t w = u8x8->display_info->tile_width;
+  u8x8_fanout_draw(target, 0, y, w, u8x8->fanout->shadow + (uint16_t)y*w*8);
+  u8x8_fanout_clear_dirty(u8x8, target, y);
+}
+
+/* send one DRAW_TILE (without repetition) to all attached targets */
+static void u8x8_fanout_draw_tile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t cnt, uint8_t *tile_ptr)
+{
+  u8x8_fanout_t *fanout = u8x8->fanout;
+  u8x8_fanout_target_t *target;
+  uint8_t w = u8x8->display_info->tile_width;
+  uint8_t *shadow;
+  uint8_t i, start, end;
+  
+  if ( fanout->shadow == NULL || y >= u8x8->display_info->tile_height || x >= w || cnt > w - x )
+  {
+    /* no shadow or outside of the display: send everything */
+    for( i = 0; i < fanout->target_cnt; i++ )
+    {
+      target = fanout->target_list+i;
+      if ( target->is_attached == 0 )
+	continue;
+      u8x8_fanout_draw(target, x, y, cnt, tile_ptr);
+      if ( x == 0 && cnt >= w )
+	u8x8_fanout_clear_dirty(u8x8, target, y);
+    }
+    return;
+  }
+  
+  shadow = fanout->shadow + ((uint16_t)y*w + x)*8;
+  
+  /* send the runs of changed tiles to the targets, which are not dirty for this row */
+  start = 0;
+  for(;;)
+  {
+    while( start < cnt && memcmp(shadow+start*8, tile_ptr+start*8, 8) == 0 )
+      start++;
+    if ( start >= cnt )
+      break;
+    end = start+1;
+    while( end < cnt && memcmp(shadow+end*8, tile_ptr+end*8, 8) != 0 )
+      end++;
+    for( i = 0; i < fanout->target_cnt; i++ )
+    {
+      target = fanout->target_list+i;
+      if ( target->is_attached && (target->dirty_rows & u8x8_fanout_row_mask(y)) == 0 )
+	u8x8_fanout_draw(target, x+start, y, end-start, tile_ptr+start*8);
+    }
+    start = end;
+  }
+  memcpy(shadow, tile_ptr, (uint16_t)cnt*8);
+  
+  /* dirty targets get the complete row */
+  for( i = 0; i < fanout->target_cnt; i++ )
+  {
+    target = fanout->target_list+i;
+    if ( target->is_attached && (target->dirty_rows & u8x8_fanout_row_mask(y)) != 0 )
+      u8x8_fanout_draw_row(u8x8, target, y);
+  }
+}
+
+uint8_t u8x8_d_fanout(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_fanout_t *fanout = u8x8->fanout;
+  u8x8_tile_t *tile;
+  uint8_t i, x;
+  
+  switch(msg)
+  {
+    case U8X8_MSG_DISPLAY_SETUP_MEMORY:
+      return fanout->display_cb(u8x8, msg, arg_int, arg_ptr);
+    case U8X8_MSG_DISPLAY_INIT:
+      /* same state as after the init of a single display */
+      fanout->power_save = 1;
+      fanout->flip_mode = 0;
+      fanout->is_contrast = 0;
+      for( i = 0; i < fanout->target_cnt; i++ )
+	if ( fanout->target_list[i].is_attached )
+	  u8x8_AttachFanoutTarget(u8x8, i);
+      break;
+    case U8X8_MSG_DISPLAY_SET_POWER_SAVE:
+      fanout->power_save = arg_int;
+      u8x8_fanout_send(u8x8, msg, arg_int);
+      break;
+#ifdef U8X8_WITH_SET_FLIP_MODE
+    case U8X8_MSG_DISPLAY_SET_FLIP_MODE:
+      fanout->flip_mode = arg_int;
+      u8x8_fanout_send(u8x8, msg, arg_int);
+      break;
+#endif
+#ifdef U8X8_WITH_SET_CONTRAST
+    case U8X8_MSG_DISPLAY_SET_CONTRAST:
+      fanout->contrast = arg_int;
+      fanout->is_contrast = 1;
+      u8x8_fanout_send(u8x8, msg, arg_int);
+      break;
+#endif
+    case U8X8_MSG_DISPLAY_REFRESH:
+      u8x8_fanout_send(u8x8, msg, arg_int);
+      break;
+    case U8X8_MSG_DISPLAY_DRAW_TILE:
+      tile = (u8x8_tile_t *)arg_ptr;
+      x = tile->x_pos;
+      /* arg_int is the repeat count, see u8x8_ClearDisplayWithTile() */
+      do
+      {
+	u8x8_fanout_draw_tile(u8x8, x, tile->y_pos, tile->cnt, tile->tile_ptr);
+	x += tile->cnt;
+	arg_int--;
+      } while( arg_int > 0 );
+      break;
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+void u8x8_SetFanout(u8x8_t *u8x8, u8x8_fanout_t *fanout, u8x8_fanout_target_t *target_list, uint8_t target_cnt, uint8_t *shadow)
+{
+  uint8_t i;
+  
+  fanout->target_list = target_list;
+  fanout->target_cnt = target_cnt;
+  fanout->shadow = shadow;
+  fanout->display_cb = u8x8->display_cb;
+  fanout->power_save = 1;		/* the display is in power save mode after init */
+  fanout->flip_mode = 0;
+  fanout->contrast = 0;
+  fanout->is_contrast = 0;
+  for( i = 0; i < target_cnt; i++ )
+  {
+    target_list[i].dirty_rows = 0xffffffff;
+    target_list[i].tile_cnt = 0;
+    target_list[i].is_attached = 0;
+  }
+  if ( shadow != NULL )
+    memset(shadow, 0, (uint16_t)u8x8->display_info->tile_width*u8x8->display_info->tile_height*8);
+  
+  u8x8->fanout = fanout;
+  u8x8->display_cb = u8x8_d_fanout;
+}
+
+void u8x8_AttachFanoutTarget(u8x8_t *u8x8, uint8_t idx)
+{
+  u8x8_fanout_t *fanout = u8x8->fanout;
+  u8x8_fanout_target_t *target = fanout->target_list+idx;
+  
+  u8x8_InitDisplay(target->u8x8);
+#ifdef U8X8_WITH_SET_FLIP_MODE
+  if ( fanout->flip_mode != 0 )
+    u8x8_SetFlipMode(target->u8x8, fanout->flip_mode);
+#endif
+#ifdef U8X8_WITH_SET_CONTRAST
+  if ( fanout->is_contrast )
+    u8x8_SetContrast(target->u8x8, fanout->contrast);
+#endif
+  u8x8_SetPowerSave(target->u8x8, fanout->power_save);
+  target->dirty_rows = 0xffffffff;
+  target->is_attached = 1;
+}
+
+void u8x8_DetachFanoutTarget(u8x8_t *u8x8, uint8_t idx)
+{
+  u8x8->fanout->target_list[idx].is_attached = 0;
+}
+
+void u8x8_UpdateFanoutTargets(u8x8_t *u8x8)
+{
+  u8x8_fanout_t *fanout = u8x8->fanout;
+  u8x8_fanout_target_t *target;
+  uint8_t i, y, h;
+  
+  if ( fanout->shadow == NULL )
+    return;
+  h = u8x8->display_info->tile_height;
+  for( i = 0; i < fanout->target_cnt; i++ )
+  {
+    target = fanout->target_list+i;
+    if ( target->is_attached == 0 )
+      continue;
+    for( y = 0; y < h && target->dirty_rows != 0; y++ )
+      if ( target->dirty_rows & u8x8_fanout_row_mask(y) )
+	u8x8_fanout_draw_row(u8x8, target, y);
+  }
+}
+
+#endif /* U8X8_WITH_FANOUT */
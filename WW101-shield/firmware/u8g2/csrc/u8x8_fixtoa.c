@@ -0,0 +1,105 @@
+/* 
+
+  u8x8_fixtoa.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  Fixed point to ASCII, without printf and without division.
+  
+*/
+
+
+#include "u8x8.h"
+
+static const uint32_t u8x8_fixtoa_tab[10] = { 
+  1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 
+  10000UL, 1000UL, 100UL, 10UL, 1UL };
+
+/*
+  v = value, the printed number is v/10^decimals, e.g. v=-235, decimals=1: "-23.5"
+  width = number of chars (sign, digits and decimal point), the number is right aligned
+  dest must have width+1 bytes. If the number does not fit, all chars are '#'.
+*/
+const char *u8x8_fixtoap(char *dest, int32_t v, uint8_t width, uint8_t decimals)
+{
+  char digits[10];
+  uint32_t u;
+  uint32_t c;
+  uint8_t i, n, pos, d;
+  uint8_t is_neg = 0;
+  
+  if ( v < 0 )
+  {
+    is_neg = 1;
+    u = (uint32_t)0 - (uint32_t)v;
+  }
+  else
+  {
+    u = (uint32_t)v;
+  }
+  
+  for( i = 0; i < 10; i++ )
+  {
+    d = '0';
+    c = u8x8_fixtoa_tab[i];
+    while( u >= c )
+    {
+      u -= c;
+      d++;
+    }
+    digits[i] = d;
+  }
+  
+  /* remove leading zeros, but keep one digit before the decimal point */
+  n = 10;
+  while( n > decimals+1 && digits[10-n] == '0' )
+    n--;
+  
+  dest[width] = '\0';
+  if ( (uint8_t)(n + is_neg + (decimals != 0 ? 1 : 0)) > width )
+  {
+    for( pos = 0; pos < width; pos++ )
+      dest[pos] = '#';
+    return dest;
+  }
+  
+  pos = width;
+  for( i = 0; i < n; i++ )
+  {
+    if ( decimals != 0 && i == decimals )
+      dest[--pos] = '.';
+    dest[--pos] = digits[9-i];
+  }
+  if ( is_neg )
+    dest[--pos] = '-';
+  while( pos > 0 )
+    dest[--pos] = ' ';
+  return dest;
+}
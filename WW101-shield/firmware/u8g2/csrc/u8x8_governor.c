@@ -0,0 +1,178 @@
+/* 
+
+  u8x8_governor.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  
+  Policy layer for battery powered displays.
+  
+  Frame rate limit: Redraw requests are collected, u8x8_PollGovernor() 
+  grants one frame for all requests after min_frame_ms has passed since 
+  the start of the previous frame.
+  
+  Dimming: Without user input (u8x8_NotifyActivity()) or a new presence
+  for dim_ms, the contrast is reduced to dim_contrast.
+  
+  Power save: If the presence sensor (u8x8_SetPresence()) has not detected
+  anybody for power_save_ms, the display is switched off. Frames are not
+  granted in power save mode. User input or presence switches the display 
+  on again with full contrast.
+  
+  The time in milliseconds is provided by the caller, overflow of the
+  32 bit counter is allowed.
+  
+  Only available with U8X8_WITH_GOVERNOR.
+  
+*/
+
+#include "u8x8.h"
+
+#ifdef U8X8_WITH_GOVERNOR
+
+static void u8x8_governor_contrast(u8x8_t *u8x8, uint8_t contrast)
+{
+#ifdef U8X8_WITH_SET_CONTRAST
+  u8x8_SetContrast(u8x8, contrast);
+#else
+  (void)u8x8;
+  (void)contrast;
+#endif
+}
+
+/* back to U8X8_GOVERNOR_ACTIVE */
+static void u8x8_governor_wake(u8x8_t *u8x8, uint32_t now_ms)
+{
+  u8x8_governor_t *governor = u8x8->governor;
+  
+  governor->last_activity_ms = now_ms;
+  governor->last_presence_ms = now_ms;
+  if ( governor->state == U8X8_GOVERNOR_ACTIVE )
+    return;
+  if ( governor->state == U8X8_GOVERNOR_POWER_SAVE )
+    u8x8_SetPowerSave(u8x8, 0);
+  u8x8_governor_contrast(u8x8, governor->contrast);
+  governor->state = U8X8_GOVERNOR_ACTIVE;
+}
+
+/* the display is not accessed, call this after u8x8_InitDisplay() and u8x8_SetPowerSave(u8x8, 0) */
+void u8x8_SetGovernor(u8x8_t *u8x8, u8x8_governor_t *governor, uint32_t min_frame_ms, uint32_t dim_ms, uint32_t power_save_ms, uint32_t now_ms)
+{
+  u8x8->governor = governor;
+  if ( governor == NULL )
+    return;
+  governor->min_frame_ms = min_frame_ms;
+  governor->dim_ms = dim_ms;
+  governor->power_save_ms = power_save_ms;
+  governor->last_frame_ms = now_ms - min_frame_ms;	/* the first frame is granted immediately */
+  governor->last_activity_ms = now_ms;
+  governor->last_presence_ms = now_ms;
+  governor->contrast = 255;
+  governor->dim_contrast = 16;
+  governor->state = U8X8_GOVERNOR_ACTIVE;
+  governor->is_redraw = 1;
+  governor->is_present = 1;
+  governor->request_cnt = 0;
+  governor->frame_cnt = 0;
+  governor->dim_cnt = 0;
+  governor->power_save_cnt = 0;
+}
+
+void u8x8_SetGovernorContrast(u8x8_t *u8x8, uint8_t contrast, uint8_t dim_contrast)
+{
+  u8x8_governor_t *governor = u8x8->governor;
+  
+  governor->contrast = contrast;
+  governor->dim_contrast = dim_contrast;
+  if ( governor->state == U8X8_GOVERNOR_ACTIVE )
+    u8x8_governor_contrast(u8x8, contrast);
+  else if ( governor->state == U8X8_GOVERNOR_DIM )
+    u8x8_governor_contrast(u8x8, dim_contrast);
+}
+
+void u8x8_RequestRedraw(u8x8_t *u8x8)
+{
+  u8x8->governor->request_cnt++;
+  u8x8->governor->is_redraw = 1;
+}
+
+void u8x8_NotifyActivity(u8x8_t *u8x8, uint32_t now_ms)
+{
+  u8x8_governor_wake(u8x8, now_ms);
+}
+
+void u8x8_SetPresence(u8x8_t *u8x8, uint8_t is_present, uint32_t now_ms)
+{
+  u8x8_governor_t *governor = u8x8->governor;
+  
+  if ( is_present )
+  {
+    /* only a new presence counts as activity */
+    if ( governor->is_present == 0 || governor->state == U8X8_GOVERNOR_POWER_SAVE )
+      u8x8_governor_wake(u8x8, now_ms);
+    governor->last_presence_ms = now_ms;
+  }
+  governor->is_present = is_present;
+}
+
+uint8_t u8x8_PollGovernor(u8x8_t *u8x8, uint32_t now_ms)
+{
+  u8x8_governor_t *governor = u8x8->governor;
+  
+  if ( governor->state != U8X8_GOVERNOR_POWER_SAVE )
+  {
+    if ( governor->power_save_ms != 0 && governor->is_present == 0 
+	&& (uint32_t)(now_ms - governor->last_presence_ms) >= governor->power_save_ms )
+    {
+      u8x8_SetPowerSave(u8x8, 1);
+      governor->state = U8X8_GOVERNOR_POWER_SAVE;
+      governor->power_save_cnt++;
+      return 0;
+    }
+    if ( governor->state == U8X8_GOVERNOR_ACTIVE && governor->dim_ms != 0 
+	&& (uint32_t)(now_ms - governor->last_activity_ms) >= governor->dim_ms )
+    {
+      u8x8_governor_contrast(u8x8, governor->dim_contrast);
+      governor->state = U8X8_GOVERNOR_DIM;
+      governor->dim_cnt++;
+    }
+  }
+  
+  if ( governor->is_redraw == 0 || governor->state == U8X8_GOVERNOR_POWER_SAVE )
+    return 0;
+  if ( (uint32_t)(now_ms - governor->last_frame_ms) < governor->min_frame_ms )
+    return 0;
+  governor->last_frame_ms = now_ms;
+  governor->is_redraw = 0;
+  governor->frame_cnt++;
+  return 1;
+}
+
+#endif /* U8X8_WITH_GOVERNOR */
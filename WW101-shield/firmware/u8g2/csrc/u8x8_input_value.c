@@ -50,6 +50,7 @@ uint8_t u8x8_UserInterfaceInputValue(u8x8_t *u8x8, const char *title, const char
   uint8_t local_value = *value;
   uint8_t r;
   uint8_t event;
+  char buf[4];
 
   /* calculate overall height of the input value box */
   height = 1;	/* button line */
@@ -85,10 +86,10 @@ uint8_t u8x8_UserInterfaceInputValue(u8x8_t *u8x8, const char *title, const char
   u8x8_SetInverseFont(u8x8, 1);
   
   /* event loop */
-  u8x8_DrawUTF8(u8x8, x, y, u8x8_u8toa(local_value, digits));
+  u8x8_DrawUTF8(u8x8, x, y, u8x8_u8toap(buf, local_value)+3-digits);
   for(;;)
   {
-    event = u8x8_GetMenuEvent(u8x8);
+    event = u8x8_WaitMenuEvent(u8x8);
     if ( event == U8X8_MSG_GPIO_MENU_SELECT )
     {
       *value = local_value;
@@ -106,7 +107,7 @@ uint8_t u8x8_UserInterfaceInputValue(u8x8_t *u8x8, const char *title, const char
 	local_value = lo;
       else
 	local_value++;
-      u8x8_DrawUTF8(u8x8, x, y, u8x8_u8toa(local_value, digits));
+      u8x8_DrawUTF8(u8x8, x, y, u8x8_u8toap(buf, local_value)+3-digits);
     }
     else if ( event == U8X8_MSG_GPIO_MENU_PREV || event == U8X8_MSG_GPIO_MENU_DOWN )
     {
@@ -114,7 +115,7 @@ uint8_t u8x8_UserInterfaceInputValue(u8x8_t *u8x8, const char *title, const char
 	local_value = hi;
       else
 	local_value--;
-      u8x8_DrawUTF8(u8x8, x, y, u8x8_u8toa(local_value, digits));
+      u8x8_DrawUTF8(u8x8, x, y, u8x8_u8toap(buf, local_value)+3-digits);
     }        
   }
   
@@ -127,7 +127,7 @@ uint8_t u8x8_UserInterfaceMessage(u8x8_t *u8x8, const char *title1, const char *
   
   for(;;)
   {
-    event = u8x8_GetMenuEvent(u8x8);
+    event = u8x8_WaitMenuEvent(u8x8);
     if ( event == U8X8_MSG_GPIO_MENU_SELECT )
       return cursor+1;
     else if ( event == U8X8_MSG_GPIO_MENU_HOME )
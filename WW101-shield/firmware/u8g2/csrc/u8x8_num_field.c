@@ -0,0 +1,95 @@
+/* 
+
+  u8x8_num_field.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  Numeric field: a fixed number of glyphs at a fixed tile position.
+  The field remembers the chars on the display. A new value is
+  formatted with u8x8_fixtoap() and only the glyphs (tiles) which 
+  have changed are sent to the display.
+  
+*/
+
+#include "u8x8.h"
+
+void u8x8_InitNumField(u8x8_num_field_t *field, const uint8_t *font, uint8_t x, uint8_t y, uint8_t width, uint8_t decimals, uint8_t scale)
+{
+  if ( width > U8X8_NUM_FIELD_MAX_WIDTH )
+    width = U8X8_NUM_FIELD_MAX_WIDTH;
+  field->font = font;
+  field->x = x;
+  field->y = y;
+  field->width = width;
+  field->decimals = decimals;
+  field->scale = scale;
+  u8x8_InvalidateNumField(field);
+}
+
+/* the content of the display is unknown, the next update will draw all glyphs */
+void u8x8_InvalidateNumField(u8x8_num_field_t *field)
+{
+  uint8_t i;
+  for( i = 0; i <= U8X8_NUM_FIELD_MAX_WIDTH; i++ )
+    field->shown[i] = '\0';
+}
+
+/* v is a fixed point value: v/10^decimals is shown, returns the number of sent tiles */
+uint8_t u8x8_UpdateNumField(u8x8_t *u8x8, u8x8_num_field_t *field, int32_t v)
+{
+  char buf[U8X8_NUM_FIELD_MAX_WIDTH+1];
+  const uint8_t *font = u8x8->font;
+  uint8_t i, x;
+  uint8_t cnt = 0;
+  
+  u8x8_fixtoap(buf, v, field->width, field->decimals);
+  u8x8->font = field->font;
+  x = field->x;
+  for( i = 0; i < field->width; i++ )
+  {
+    if ( buf[i] != field->shown[i] )
+    {
+      if ( field->scale == 2 )
+      {
+	u8x8_Draw2x2Glyph(u8x8, x, field->y, (uint8_t)buf[i]);
+	cnt += 4;
+      }
+      else
+      {
+	u8x8_DrawGlyph(u8x8, x, field->y, (uint8_t)buf[i]);
+	cnt++;
+      }
+      field->shown[i] = buf[i];
+    }
+    x += field->scale;
+  }
+  u8x8->font = font;
+  return cnt;
+}
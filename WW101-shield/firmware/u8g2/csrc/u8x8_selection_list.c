@@ -153,7 +153,7 @@ uint8_t u8x8_UserInterfaceSelectionList(u8x8_t *u8x8, const char *title, uint8_t
 
   for(;;)
   {
-    event = u8x8_GetMenuEvent(u8x8);
+    event = u8x8_WaitMenuEvent(u8x8);
     if ( event == U8X8_MSG_GPIO_MENU_SELECT )
       return u8sl.current_pos+1;
     else if ( event == U8X8_MSG_GPIO_MENU_HOME )
@@ -60,7 +60,33 @@ void u8x8_SetupDefaults(u8x8_t *u8x8)
     u8x8->device_address = 0;
     u8x8->utf8_state = 0;		/* also reset by u8x8_utf8_init */
     u8x8->i2c_address = 255;
+    u8x8->cad_is_transfer = 0;
+    u8x8->cad_i2c_state = 0;
     u8x8->debounce_default_pin_state = 255;	/* assume all low active buttons */
+#ifdef U8X8_WITH_USER_PTR
+    u8x8->user_ptr = NULL;
+#endif
+#ifdef U8X8_WITH_XFER
+    u8x8->xfer = NULL;
+#endif
+#ifdef U8X8_WITH_FAST_BUS
+    u8x8->fast_bus = NULL;
+#endif
+#ifdef U8X8_WITH_BUS
+    u8x8->bus_client = NULL;
+#endif
+#ifdef U8X8_WITH_EPD
+    u8x8->epd = NULL;
+#endif
+#ifdef U8X8_WITH_FANOUT
+    u8x8->fanout = NULL;
+#endif
+#ifdef U8X8_WITH_GOVERNOR
+    u8x8->governor = NULL;
+#endif
+#ifdef U8X8_WITH_EVENT
+    u8x8->event_queue = NULL;
+#endif
   
 #ifdef U8X8_USE_PINS 
   {
@@ -0,0 +1,288 @@
+/* 
+
+  u8x8_xfer.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  
+  Scatter-gather transfers: The byte messages of one page are recorded into 
+  a segment list and sent with one U8X8_MSG_BYTE_XFER_SUBMIT message. The 
+  byte procedure can send the list with DMA and returns immediately, 
+  u8x8_xfer_Done() is called once the transfer has finished. 
+  
+  Byte procedures without U8X8_MSG_BYTE_XFER_SUBMIT will receive the 
+  usual (blocking) byte messages.
+  
+  Only available with U8X8_WITH_XFER.
+  
+*/
+
+#include "u8x8.h"
+#include <string.h>
+
+#ifdef U8X8_WITH_XFER
+
+void u8x8_xfer_Done(u8x8_t *u8x8, u8x8_xfer_t *xfer)
+{
+  u8x8_xfer_done_cb done_cb = xfer->done_cb;
+  xfer->done_cb = NULL;
+  xfer->is_busy = 0;
+  if ( done_cb != NULL )
+    done_cb(u8x8, xfer);
+}
+
+void u8x8_xfer_Replay(u8x8_t *u8x8, u8x8_xfer_t *xfer, u8x8_msg_cb byte_cb)
+{
+  u8x8_xfer_seg_t *seg = xfer->seg_list;
+  uint8_t i;
+  uint16_t cnt;
+  uint8_t *data;
+  uint8_t n;
+  
+  for( i = 0; i < xfer->seg_cnt; i++ )
+  {
+    if ( seg->flags & U8X8_XFER_SEG_START )
+      byte_cb(u8x8, U8X8_MSG_BYTE_START_TRANSFER, 0, NULL);
+    if ( seg->cnt > 0 )
+    {
+      byte_cb(u8x8, U8X8_MSG_BYTE_SET_DC, (seg->flags & U8X8_XFER_SEG_DC) ? 1 : 0, NULL);
+      cnt = seg->cnt;
+      data = (uint8_t *)seg->data;
+      while( cnt > 0 )
+      {
+	n = cnt > 255 ? 255 : cnt;
+	byte_cb(u8x8, U8X8_MSG_BYTE_SEND, n, data);
+	data += n;
+	cnt -= n;
+      }
+    }
+    if ( seg->flags & U8X8_XFER_SEG_END )
+      byte_cb(u8x8, U8X8_MSG_BYTE_END_TRANSFER, 0, NULL);
+    seg++;
+  }
+}
+
+static void u8x8_xfer_wait(u8x8_t *u8x8, u8x8_xfer_t *xfer)
+{
+  while( xfer->is_busy != 0 )
+    xfer->byte_cb(u8x8, U8X8_MSG_BYTE_XFER_POLL, 0, xfer);
+}
+
+static void u8x8_xfer_submit(u8x8_t *u8x8, u8x8_xfer_t *xfer)
+{
+  /* is_busy must be set before, because u8x8_xfer_Done() might be called during submit */
+  xfer->is_busy = 1;
+  if ( xfer->seg_cnt == 0 || xfer->byte_cb(u8x8, U8X8_MSG_BYTE_XFER_SUBMIT, 0, xfer) == 0 )
+  {
+    u8x8_xfer_Replay(u8x8, xfer, xfer->byte_cb);
+    u8x8_xfer_Done(u8x8, xfer);
+  }
+}
+
+/* 
+  seg_list or pool is full: send the recorded part and continue with an empty list.
+  If the last segment has no END flag, the byte procedure must keep the 
+  transfer open for the next list.
+*/
+static void u8x8_xfer_flush(u8x8_t *u8x8, u8x8_xfer_t *xfer)
+{
+  u8x8_xfer_done_cb done_cb = xfer->done_cb;
+  xfer->done_cb = NULL;
+  u8x8_xfer_submit(u8x8, xfer);
+  u8x8_xfer_wait(u8x8, xfer);
+  xfer->done_cb = done_cb;
+  xfer->seg_cnt = 0;
+  xfer->pool_cnt = 0;
+}
+
+static u8x8_xfer_seg_t *u8x8_xfer_new_seg(u8x8_t *u8x8, u8x8_xfer_t *xfer)
+{
+  u8x8_xfer_seg_t *seg;
+  if ( xfer->seg_cnt >= xfer->seg_max )
+    u8x8_xfer_flush(u8x8, xfer);
+  seg = xfer->seg_list + xfer->seg_cnt;
+  xfer->seg_cnt++;
+  seg->data = xfer->pool + xfer->pool_cnt;
+  seg->cnt = 0;
+  seg->flags = 0;
+  if ( xfer->dc != 0 )
+    seg->flags |= U8X8_XFER_SEG_DC;
+  if ( xfer->is_start != 0 )
+  {
+    seg->flags |= U8X8_XFER_SEG_START;
+    xfer->is_start = 0;
+  }
+  return seg;
+}
+
+/* the bytes are copied, so the caller can reuse its buffer (e.g. the u8g2 tile buffer) */
+static void u8x8_xfer_record(u8x8_t *u8x8, u8x8_xfer_t *xfer, uint8_t cnt, const uint8_t *data)
+{
+  u8x8_xfer_seg_t *seg = NULL;
+  uint16_t n;
+  
+  /* append to the last segment, if possible */
+  if ( xfer->seg_cnt > 0 && xfer->is_start == 0 )
+  {
+    seg = xfer->seg_list + xfer->seg_cnt - 1;
+    if ( (seg->flags & U8X8_XFER_SEG_END) != 0 
+	|| ((seg->flags & U8X8_XFER_SEG_DC) != 0) != (xfer->dc != 0) 
+	|| seg->data + seg->cnt != xfer->pool + xfer->pool_cnt )
+      seg = NULL;
+  }
+  
+  while( cnt > 0 )
+  {
+    if ( xfer->pool_cnt >= xfer->pool_size )
+    {
+      u8x8_xfer_flush(u8x8, xfer);
+      seg = NULL;
+    }
+    if ( seg == NULL )
+      seg = u8x8_xfer_new_seg(u8x8, xfer);
+    n = xfer->pool_size - xfer->pool_cnt;
+    if ( n > cnt )
+      n = cnt;
+    memcpy(xfer->pool + xfer->pool_cnt, data, n);
+    xfer->pool_cnt += n;
+    seg->cnt += n;
+    data += n;
+    cnt -= n;
+  }
+}
+
+/*
+  Installed by u8x8_SetXfer(). Records the byte messages between u8x8_BeginXfer()
+  and u8x8_EndXfer(), all other messages are sent after the pending transfer.
+*/
+uint8_t u8x8_byte_xfer(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_xfer_t *xfer = u8x8->xfer;
+  
+  if ( xfer->is_recording == 0 || msg == U8X8_MSG_BYTE_INIT )
+  {
+    u8x8_xfer_wait(u8x8, xfer);
+    if ( msg == U8X8_MSG_BYTE_SET_DC )
+      xfer->dc = arg_int;
+    return xfer->byte_cb(u8x8, msg, arg_int, arg_ptr);
+  }
+  
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      u8x8_xfer_record(u8x8, xfer, arg_int, (const uint8_t *)arg_ptr);
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      xfer->dc = arg_int;
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      xfer->is_start = 1;
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      if ( xfer->is_start != 0 || xfer->seg_cnt == 0 )
+	u8x8_xfer_new_seg(u8x8, xfer);
+      xfer->seg_list[xfer->seg_cnt-1].flags |= U8X8_XFER_SEG_END;
+      break;
+    default:
+      return xfer->byte_cb(u8x8, msg, arg_int, arg_ptr);
+  }
+  return 1;
+}
+
+/*
+  Must be called after u8x8_Setup(). seg_max should be at least 2 times the 
+  number of tile rows of a page.
+*/
+void u8x8_SetXfer(u8x8_t *u8x8, u8x8_xfer_t *xfer, u8x8_xfer_seg_t *seg_list, uint8_t seg_max, uint8_t *pool, uint16_t pool_size)
+{
+  if ( u8x8->xfer != NULL )
+  {
+    u8x8_xfer_wait(u8x8, u8x8->xfer);
+    u8x8->byte_cb = u8x8->xfer->byte_cb;
+    u8x8->xfer = NULL;
+  }
+  if ( xfer == NULL )
+    return;
+  
+  xfer->seg_list = seg_list;
+  xfer->seg_max = seg_max;
+  xfer->seg_cnt = 0;
+  xfer->pool = pool;
+  xfer->pool_size = pool_size;
+  xfer->pool_cnt = 0;
+  xfer->done_cb = NULL;
+  xfer->dc = 0;
+  xfer->is_start = 0;
+  xfer->is_recording = 0;
+  xfer->is_busy = 0;
+  xfer->byte_cb = u8x8->byte_cb;
+  u8x8->byte_cb = u8x8_byte_xfer;
+  u8x8->xfer = xfer;
+}
+
+/* calls to u8x8_BeginXfer() and u8x8_EndXfer() can be nested */
+void u8x8_BeginXfer(u8x8_t *u8x8)
+{
+  u8x8_xfer_t *xfer = u8x8->xfer;
+  if ( xfer == NULL )
+    return;
+  if ( xfer->is_recording == 0 )
+  {
+    /* the pool is reused: wait for the previous transfer */
+    u8x8_xfer_wait(u8x8, xfer);
+    xfer->seg_cnt = 0;
+    xfer->pool_cnt = 0;
+    xfer->is_start = 0;
+    xfer->done_cb = NULL;
+  }
+  xfer->is_recording++;
+}
+
+void u8x8_EndXfer(u8x8_t *u8x8, u8x8_xfer_done_cb done_cb)
+{
+  u8x8_xfer_t *xfer = u8x8->xfer;
+  if ( xfer == NULL || xfer->is_recording == 0 )
+    return;
+  xfer->is_recording--;
+  if ( xfer->is_recording != 0 )
+    return;
+  if ( xfer->is_start != 0 )
+    u8x8_xfer_new_seg(u8x8, xfer);
+  xfer->done_cb = done_cb;
+  u8x8_xfer_submit(u8x8, xfer);
+}
+
+void u8x8_WaitXfer(u8x8_t *u8x8)
+{
+  if ( u8x8->xfer != NULL )
+    u8x8_xfer_wait(u8x8, u8x8->xfer);
+}
+
+#endif /* U8X8_WITH_XFER */
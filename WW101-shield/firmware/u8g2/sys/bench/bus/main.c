@@ -0,0 +1,208 @@
+/*
+  Display and sensors on one I2C bus (WW101 shield: OLED 0x3C, PSoC 0x42).
+  
+  The bus (100 kHz) is simulated (../common/u8x8_byte_sim.c). Sensor 
+  requests arrive like interrupts during the display transfer and are
+  executed by U8X8_MSG_BUS_GRANT as soon as the bus is released.
+  
+  "frame lock": the display owns the bus for the complete frame (like the 
+    i2cMutex of the weather station)
+  "transfer lock": u8x8_SetBusClient(), the display releases the bus after 
+    each i2c transfer (U8X8_I2C_MAX_TRANSFER bytes)
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+
+#define RUN_MS 2000
+#define FRAME_GAP_MS 20
+
+/* ../common/u8x8_byte_sim.c */
+struct u8x8_sim_struct
+{
+  unsigned long long now_ns;
+  unsigned long long done_ns;
+  unsigned long long wait_ns;
+  unsigned long bit_ns;
+  unsigned long transfers;
+  unsigned long bytes;
+  unsigned long submits;
+  unsigned long checksum;
+  uint8_t is_i2c;
+  uint8_t is_async;
+  uint8_t dc;
+  void *pending;
+  u8x8_t *pending_u8x8;
+};
+extern struct u8x8_sim_struct u8x8_sim;
+extern void u8x8_sim_Init(uint8_t is_i2c, unsigned long clock_khz, uint8_t is_async);
+extern void u8x8_sim_Advance(unsigned long long ns);
+extern uint8_t u8x8_byte_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+/*=========================================*/
+
+struct sensor_struct
+{
+  u8x8_bus_client_t client;
+  const char *name;
+  unsigned long long period_ns;
+  unsigned long long due_ns;
+  uint8_t read_cnt;		/* bytes read after the register offset has been written */
+};
+
+static u8x8_bus_t bus;
+static u8x8_bus_client_t display_client;
+static struct sensor_struct sensor_list[2] = 
+{
+  { .name = "capsense", .period_ns = 10000000, .due_ns = 3300000, .read_cnt = 1 },
+  { .name = "weather", .period_ns = 50000000, .due_ns = 7700000, .read_cnt = 16 },
+};
+
+uint32_t get_us(void)
+{
+  return u8x8_sim.now_ns / 1000;
+}
+
+/* write offset, read data, both with start, address and stop */
+static void sensor_transaction(struct sensor_struct *s)
+{
+  u8x8_sim_Advance((unsigned long long)u8x8_sim.bit_ns * (10+9*1+1 + 10+9*s->read_cnt+1));
+  u8x8_bus_Release(&(s->client));
+}
+
+uint8_t bus_cb(u8x8_bus_t *bus, uint8_t msg, u8x8_bus_client_t *client)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_BUS_LOCK:
+    case U8X8_MSG_BUS_UNLOCK:
+      /* single thread, requests are not issued inside the bus procedures */
+      break;
+    case U8X8_MSG_BUS_WAIT:
+      /* only sensors have to wait and they never call u8x8_bus_Acquire() */
+      fprintf(stderr, "unexpected wait\n");
+      return 0;
+    case U8X8_MSG_BUS_GRANT:
+      sensor_transaction((struct sensor_struct *)client);
+      break;
+  }
+  return 1;
+}
+
+/* "interrupts" of the sensor timers */
+static void sensor_poll(void)
+{
+  static uint8_t is_active = 0;
+  int i;
+  if ( is_active )
+    return;
+  is_active = 1;
+  for( i = 0; i < 2; i++ )
+  {
+    while( u8x8_sim.now_ns >= sensor_list[i].due_ns )
+    {
+      sensor_list[i].due_ns += sensor_list[i].period_ns;
+      if ( u8x8_bus_Request(&(sensor_list[i].client)) )
+	sensor_transaction(sensor_list+i);
+    }
+  }
+  is_active = 0;
+}
+
+/* byte procedure of the display: the timers are checked after each byte */
+uint8_t u8x8_byte_sensor_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *p = (uint8_t *)arg_ptr;
+  if ( msg == U8X8_MSG_BYTE_SEND )
+  {
+    while( arg_int > 0 )
+    {
+      u8x8_byte_sim(u8x8, msg, 1, p);
+      sensor_poll();
+      p++;
+      arg_int--;
+    }
+    return 1;
+  }
+  u8x8_byte_sim(u8x8, msg, arg_int, arg_ptr);
+  sensor_poll();
+  return 1;
+}
+
+uint8_t u8x8_gpio_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static void idle(unsigned long long ns)
+{
+  unsigned long long end = u8x8_sim.now_ns + ns;
+  while( u8x8_sim.now_ns < end )
+  {
+    u8x8_sim_Advance(1000);
+    sensor_poll();
+  }
+}
+
+/*=========================================*/
+
+static u8g2_t u8g2;
+
+static void print_client(const char *name, u8x8_bus_client_t *c)
+{
+  printf("  %-10s %6u %8.1f %6.1f%% %10.1f %10lu\n", name, c->grant_cnt, c->busy_ticks/1000.0, 
+    c->busy_ticks/(RUN_MS*10.0), c->grant_cnt ? (double)c->wait_ticks/c->grant_cnt : 0.0, 
+    (unsigned long)c->max_wait_ticks);
+}
+
+static void run(const char *name, uint8_t is_transfer_lock)
+{
+  unsigned frames = 0;
+  int i;
+  
+  u8x8_sim_Init(1, 100, 0);
+  u8x8_bus_Init(&bus, bus_cb, get_us);
+  u8x8_bus_InitClient(&bus, &display_client, 0);
+  for( i = 0; i < 2; i++ )
+  {
+    u8x8_bus_InitClient(&bus, &(sensor_list[i].client), 2-i);
+    sensor_list[i].due_ns = sensor_list[i].period_ns/3 + i*1000000;
+  }
+  
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_sensor_sim, u8x8_gpio_null);
+  if ( is_transfer_lock )
+    u8x8_SetBusClient(u8g2_GetU8x8(&u8g2), &display_client);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  u8x8_bus_ClearStats(&bus);
+  u8x8_sim.now_ns = 0;
+  
+  while( u8x8_sim.now_ns < RUN_MS*1000000ULL )
+  {
+    u8g2_ClearBuffer(&u8g2);
+    u8g2_DrawFrame(&u8g2, 0, 0, 128, 64);
+    u8g2_DrawBox(&u8g2, frames % 100, 20, 20, 20);
+    if ( is_transfer_lock == 0 )
+      u8x8_bus_Acquire(&display_client);
+    u8g2_SendBuffer(&u8g2);
+    if ( is_transfer_lock == 0 )
+      u8x8_bus_Release(&display_client);
+    frames++;
+    idle(FRAME_GAP_MS*1000000ULL);
+  }
+  
+  printf("%s: %u frames, %.1f ms/frame incl. %d ms gap\n", name, frames, RUN_MS/(double)frames, FRAME_GAP_MS);
+  printf("  %-10s %6s %8s %7s %10s %10s\n", "client", "grants", "bus ms", "bus", "wait us", "max us");
+  print_client("display", &display_client);
+  for( i = 0; i < 2; i++ )
+    print_client(sensor_list[i].name, &(sensor_list[i].client));
+}
+
+int main(void)
+{
+  run("frame lock", 0);
+  run("transfer lock", 1);
+  return 0;
+}
@@ -0,0 +1,277 @@
+/*
+  Benchmark for circles, discs and ellipses (u8g2_circle.c).
+  The vertical lines of discs and filled ellipses are collected and
+  drawn with the span batch procedures (u8g2_span.c).
+  
+  Check: For all four rotations with page and full buffer, the discs and 
+  filled ellipses must have the same frame checksum as the reference 
+  procedures below, which draw each line with u8g2_DrawVLine().
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <time.h>
+
+#define FRAMES 500
+
+/* ../common/u8x8_byte_null.c */
+extern uint8_t u8x8_byte_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+void draw_circles(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t i;
+  for( i = 0; i < 8; i++ )
+    u8g2_DrawCircle(u8g2, 8+i*16, 32, 4+((frame+i)&31), U8G2_DRAW_ALL);
+}
+
+void draw_discs(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t i;
+  for( i = 0; i < 8; i++ )
+    u8g2_DrawDisc(u8g2, 8+i*16, 32, 4+((frame+i)&31), U8G2_DRAW_ALL);
+}
+
+void draw_ellipses(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t i;
+  for( i = 0; i < 8; i++ )
+    u8g2_DrawEllipse(u8g2, 8+i*16, 32, 30, 4+((frame+i)&15), U8G2_DRAW_ALL);
+}
+
+void draw_filled_ellipses(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t i;
+  for( i = 0; i < 8; i++ )
+    u8g2_DrawFilledEllipse(u8g2, 8+i*16, 32, 30, 4+((frame+i)&15), U8G2_DRAW_ALL);
+}
+
+/*===========================================*/
+/* reference: u8g2_DrawVLine() for each line (as before the span batch) */
+
+static void ref_draw_section(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t x0, u8g2_uint_t y0)
+{
+  u8g2_DrawVLine(u8g2, x0+x, y0-y, y+1);
+  u8g2_DrawVLine(u8g2, x0-x, y0-y, y+1);
+  u8g2_DrawVLine(u8g2, x0+x, y0, y+1);
+  u8g2_DrawVLine(u8g2, x0-x, y0, y+1);
+}
+
+static void ref_disc(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rad)
+{
+  u8g2_int_t f;
+  u8g2_int_t ddF_x;
+  u8g2_int_t ddF_y;
+  u8g2_uint_t x;
+  u8g2_uint_t y;
+
+  f = 1;
+  f -= rad;
+  ddF_x = 1;
+  ddF_y = 0;
+  ddF_y -= rad;
+  ddF_y *= 2;
+  x = 0;
+  y = rad;
+
+  ref_draw_section(u8g2, x, y, x0, y0);
+  ref_draw_section(u8g2, y, x, x0, y0);
+  while ( x < y )
+  {
+    if (f >= 0) 
+    {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    ref_draw_section(u8g2, x, y, x0, y0);
+    ref_draw_section(u8g2, y, x, x0, y0);
+  }
+}
+
+static void ref_filled_ellipse(u8g2_t *u8g2, u8g2_uint_t x0, u8g2_uint_t y0, u8g2_uint_t rx, u8g2_uint_t ry)
+{
+  u8g2_uint_t x, y;
+  u8g2_long_t xchg, ychg;
+  u8g2_long_t err;
+  u8g2_long_t rxrx2;
+  u8g2_long_t ryry2;
+  u8g2_long_t stopx, stopy;
+  
+  rxrx2 = rx;
+  rxrx2 *= rx;
+  rxrx2 *= 2;
+  ryry2 = ry;
+  ryry2 *= ry;
+  ryry2 *= 2;
+  
+  x = rx;
+  y = 0;
+  xchg = 1;
+  xchg -= rx;
+  xchg -= rx;
+  xchg *= ry;
+  xchg *= ry;
+  ychg = rx;
+  ychg *= rx;
+  err = 0;
+  stopx = ryry2;
+  stopx *= rx;
+  stopy = 0;
+  while( stopx >= stopy )
+  {
+    ref_draw_section(u8g2, x, y, x0, y0);
+    y++;
+    stopy += rxrx2;
+    err += ychg;
+    ychg += rxrx2;
+    if ( 2*err+xchg > 0 )
+    {
+      x--;
+      stopx -= ryry2;
+      err += xchg;
+      xchg += ryry2;      
+    }
+  }
+
+  x = 0;
+  y = ry;
+  xchg = ry;
+  xchg *= ry;
+  ychg = 1;
+  ychg -= ry;
+  ychg -= ry;
+  ychg *= rx;
+  ychg *= rx;
+  err = 0;
+  stopx = 0;
+  stopy = rxrx2;
+  stopy *= ry;
+  while( stopx <= stopy )
+  {
+    ref_draw_section(u8g2, x, y, x0, y0);
+    x++;
+    stopx += ryry2;
+    err += xchg;
+    xchg += ryry2;
+    if ( 2*err+ychg > 0 )
+    {
+      y--;
+      stopy -= rxrx2;
+      err += ychg;
+      ychg += rxrx2;
+    }
+  }
+}
+
+void draw_ref_discs(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t i;
+  for( i = 0; i < 8; i++ )
+    ref_disc(u8g2, 8+i*16, 32, 4+((frame+i)&31));
+}
+
+void draw_ref_filled_ellipses(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t i;
+  for( i = 0; i < 8; i++ )
+    ref_filled_ellipse(u8g2, 8+i*16, 32, 30, 4+((frame+i)&15));
+}
+
+/* checksum of all frames, the pages are summed up in the order of the display memory */
+uint16_t checksum(u8g2_t *u8g2, void (*draw)(u8g2_t *u8g2, uint16_t frame))
+{
+  uint16_t frame, cnt, sum = 0;
+  uint8_t *ptr;
+  
+  for( frame = 0; frame < 32; frame++ )
+  {
+    u8g2_FirstPage(u8g2);
+    do
+    {
+      draw(u8g2, frame);
+      ptr = u8g2_GetBufferPtr(u8g2);
+      cnt = u8g2_GetBufferTileWidth(u8g2)*8*u8g2_GetBufferTileHeight(u8g2);
+      while( cnt > 0 )
+      {
+	sum = (sum << 1) + (sum >> 15) + *ptr++;
+	cnt--;
+      }
+    } while( u8g2_NextPage(u8g2) );
+  }
+  return sum;
+}
+
+int check(u8g2_t *u8g2, const char *name)
+{
+  uint16_t disc, disc_ref, ellipse, ellipse_ref;
+  
+  disc = checksum(u8g2, draw_discs);
+  disc_ref = checksum(u8g2, draw_ref_discs);
+  ellipse = checksum(u8g2, draw_filled_ellipses);
+  ellipse_ref = checksum(u8g2, draw_ref_filled_ellipses);
+  printf("%-28s discs %04x/%04x  filled ellipses %04x/%04x  %s\n", name, 
+    disc, disc_ref, ellipse, ellipse_ref, 
+    disc == disc_ref && ellipse == ellipse_ref ? "ok" : "failed");
+  return disc == disc_ref && ellipse == ellipse_ref ? 0 : 1;
+}
+
+/*===========================================*/
+
+void bench(u8g2_t *u8g2, const char *name, void (*draw)(u8g2_t *u8g2, uint16_t frame))
+{
+  clock_t t;
+  uint16_t frame;
+  
+  t = clock();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_FirstPage(u8g2);
+    do
+    {
+      draw(u8g2, frame);
+    } while( u8g2_NextPage(u8g2) );
+  }
+  t = clock() - t;
+  printf("%-28s %8.1f us/frame\n", name, (double)t*1000000.0/CLOCKS_PER_SEC/FRAMES);
+}
+
+void bench_all(u8g2_t *u8g2, const char *name)
+{
+  printf("%s\n", name);
+  bench(u8g2, "  circles", draw_circles);
+  bench(u8g2, "  discs", draw_discs);
+  bench(u8g2, "  ellipses", draw_ellipses);
+  bench(u8g2, "  filled ellipses", draw_filled_ellipses);
+}
+
+int main(void)
+{
+  static const u8g2_cb_t *rotation[4] = { U8G2_R0, U8G2_R1, U8G2_R2, U8G2_R3 };
+  char s[32];
+  u8g2_t u8g2;
+  uint8_t i;
+  int err = 0;
+  
+  u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench_all(&u8g2, "ssd1306 128x64 page buffer");
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench_all(&u8g2, "ssd1306 128x64 full buffer");
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R1, u8x8_byte_null, u8x8_byte_null);
+  bench_all(&u8g2, "ssd1306 128x64 full buffer, R1");
+  
+  for( i = 0; i < 4; i++ )
+  {
+    u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, rotation[i], u8x8_byte_null, u8x8_byte_null);
+    sprintf(s, "page buffer, R%d", i);
+    err |= check(&u8g2, s);
+    u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, rotation[i], u8x8_byte_null, u8x8_byte_null);
+    sprintf(s, "full buffer, R%d", i);
+    err |= check(&u8g2, s);
+  }
+  return err;
+}
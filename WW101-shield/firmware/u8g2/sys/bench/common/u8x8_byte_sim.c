@@ -0,0 +1,395 @@
+/* 
+
+  u8x8_byte_sim.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  
+  Host stand-in for a byte procedure: Nothing is sent, instead the bus
+  time is simulated.
+  
+  I2C: 
+    start: bus free time (4.7us up to 100 kHz, 1.3us above), start 
+      condition and address byte with ACK (10 bit)
+    9 bit per byte (data and ACK)
+    stop condition (1 bit)
+  SPI: 
+    start/end: chip enable/disable wait time of the display
+    8 bit per byte, D/C is ignored
+  
+  The clock is set with u8x8_sim_Init(). With clock_khz = 0, the max. 
+  clock of the display (display_info) is used.
+  
+  With U8X8_WITH_XFER, U8X8_MSG_BYTE_XFER_SUBMIT is accepted (if enabled
+  with u8x8_sim_Init()): The transfer runs in the background and completes 
+  when the simulated time (u8x8_sim_Advance) has reached the end of the 
+  transfer or if the caller waits (U8X8_MSG_BYTE_XFER_POLL).
+  
+  Blocking byte messages advance the simulated time immediately.
+  
+  All sent bytes are summed up in a checksum, so that different ways of 
+  sending the same content can be compared.
+  
+  Frame report: u8x8_sim_BeginFrame() and u8x8_sim_EndFrame() enclose 
+  one frame, EndFrame prints one line with the time on the wire, the 
+  overhead (start, address, stop, bus free, chip select), transfers, 
+  bytes and messages.
+  
+  Trace: u8x8_sim_SetTrace() writes all byte messages with the simulated 
+  time since the start of the frame into a file. The trace does not 
+  depend on the host, so it can be compared with a reference trace 
+  ("golden trace") to detect changes in the transfer of a frame.
+  
+*/
+
+#include "u8x8.h"
+#include <stdio.h>
+#include <string.h>
+
+struct u8x8_sim_stat_struct
+{
+  unsigned long long wire_ns;		/* total time on the wire */
+  unsigned long long overhead_ns;	/* start, address, stop, bus free, chip select */
+  unsigned long transfers;
+  unsigned long bytes;
+  unsigned long data_bytes;		/* bytes with D/C = 1, SPI only (I2C uses control bytes) */
+  unsigned long msg_cnt;
+};
+
+struct u8x8_sim_struct
+{
+  unsigned long long now_ns;
+  unsigned long long done_ns;	/* end of the pending transfer */
+  unsigned long long wait_ns;	/* CPU time lost in blocking messages or while waiting for a transfer */
+  unsigned long bit_ns;		/* 0: not yet known, clock of the display */
+  unsigned long transfers;
+  unsigned long bytes;
+  unsigned long submits;
+  unsigned long checksum;
+  uint8_t is_i2c;
+  uint8_t is_async;	/* accept U8X8_MSG_BYTE_XFER_SUBMIT */
+  uint8_t dc;
+  void *pending;		/* u8x8_xfer_t */
+  u8x8_t *pending_u8x8;
+  
+  /* frame report and trace */
+  uint8_t is_frame;
+  unsigned long frame_cnt;
+  unsigned long long frame_start_ns;
+  char frame_name[32];
+  struct u8x8_sim_stat_struct frame;
+  struct u8x8_sim_stat_struct total;
+  FILE *trace;
+};
+
+struct u8x8_sim_struct u8x8_sim;
+
+void u8x8_sim_Init(uint8_t is_i2c, unsigned long clock_khz, uint8_t is_async)
+{
+  FILE *trace = u8x8_sim.trace;
+  memset(&u8x8_sim, 0, sizeof(u8x8_sim));
+  u8x8_sim.is_i2c = is_i2c;
+  u8x8_sim.is_async = is_async;
+  if ( clock_khz != 0 )
+    u8x8_sim.bit_ns = 1000000UL / clock_khz;
+  u8x8_sim.trace = trace;
+}
+
+/* write the trace into this file, NULL: no trace */
+int u8x8_sim_SetTrace(const char *filename)
+{
+  if ( u8x8_sim.trace != NULL )
+    fclose(u8x8_sim.trace);
+  u8x8_sim.trace = NULL;
+  if ( filename == NULL )
+    return 1;
+  u8x8_sim.trace = fopen(filename, "w");
+  return u8x8_sim.trace != NULL;
+}
+
+static unsigned long u8x8_sim_bits_ns(u8x8_t *u8x8, unsigned long bits)
+{
+  if ( u8x8_sim.bit_ns == 0 )
+  {
+    if ( u8x8_sim.is_i2c )
+      u8x8_sim.bit_ns = 10000UL / u8x8->display_info->i2c_bus_clock_100kHz;
+    else
+      u8x8_sim.bit_ns = 1000000000UL / u8x8->display_info->sck_clock_hz;
+  }
+  return bits * u8x8_sim.bit_ns;
+}
+
+/* t: simulated time of the message, a submitted transfer is traced in advance */
+static void u8x8_sim_trace_time(unsigned long long t)
+{
+  fprintf(u8x8_sim.trace, "%12llu ", t - u8x8_sim.frame_start_ns);
+}
+
+static void u8x8_sim_stat(unsigned long ns, unsigned long overhead_ns)
+{
+  u8x8_sim.frame.wire_ns += ns;
+  u8x8_sim.frame.overhead_ns += overhead_ns;
+}
+
+static unsigned long u8x8_sim_start_ns(u8x8_t *u8x8, unsigned long long t)
+{
+  unsigned long ns;
+  u8x8_sim.transfers++;
+  u8x8_sim.frame.transfers++;
+  u8x8_sim.checksum = u8x8_sim.checksum * 31 + 1000;
+  if ( u8x8_sim.is_i2c )
+  {
+    if ( u8x8_sim.trace != NULL )
+    {
+      u8x8_sim_trace_time(t);
+      fprintf(u8x8_sim.trace, "start %02x\n", u8x8_GetI2CAddress(u8x8));
+    }
+    ns = u8x8_sim_bits_ns(u8x8, 10) + (u8x8_sim.bit_ns < 10000 ? 1300 : 4700);
+  }
+  else
+  {
+    if ( u8x8_sim.trace != NULL )
+    {
+      u8x8_sim_trace_time(t);
+      fprintf(u8x8_sim.trace, "start\n");
+    }
+    ns = u8x8->display_info->post_chip_enable_wait_ns;
+  }
+  u8x8_sim_stat(ns, ns);
+  return ns;
+}
+
+static unsigned long u8x8_sim_end_ns(u8x8_t *u8x8, unsigned long long t)
+{
+  unsigned long ns;
+  u8x8_sim.checksum = u8x8_sim.checksum * 31 + 2000;
+  if ( u8x8_sim.trace != NULL )
+  {
+    u8x8_sim_trace_time(t);
+    fprintf(u8x8_sim.trace, "end\n");
+  }
+  if ( u8x8_sim.is_i2c )
+    ns = u8x8_sim_bits_ns(u8x8, 1);
+  else
+    ns = u8x8->display_info->pre_chip_disable_wait_ns;
+  u8x8_sim_stat(ns, ns);
+  return ns;
+}
+
+static void u8x8_sim_trace_dc(uint8_t dc, unsigned long long t)
+{
+  if ( u8x8_sim.trace != NULL && u8x8_sim.dc != dc )
+  {
+    u8x8_sim_trace_time(t);
+    fprintf(u8x8_sim.trace, "dc %u\n", dc);
+  }
+  u8x8_sim.dc = dc;
+}
+
+static unsigned long u8x8_sim_bytes_ns(u8x8_t *u8x8, uint16_t cnt, const uint8_t *data, unsigned long long t)
+{
+  unsigned long ns;
+  uint16_t i;
+  
+  if ( u8x8_sim.trace != NULL )
+  {
+    u8x8_sim_trace_time(t);
+    fprintf(u8x8_sim.trace, "send %s %3u:", u8x8_sim.dc ? "d" : "c", cnt);
+    for( i = 0; i < cnt; i++ )
+    {
+      if ( i > 0 && (i & 15) == 0 )
+	fprintf(u8x8_sim.trace, "\n%12s %10s", "", "");
+      fprintf(u8x8_sim.trace, " %02x", data[i]);
+    }
+    fprintf(u8x8_sim.trace, "\n");
+  }
+  
+  for( i = 0; i < cnt; i++ )
+    u8x8_sim.checksum = u8x8_sim.checksum * 31 + data[i] + (u8x8_sim.dc ? 256 : 0);
+  u8x8_sim.bytes += cnt;
+  u8x8_sim.frame.bytes += cnt;
+  if ( u8x8_sim.dc )
+    u8x8_sim.frame.data_bytes += cnt;
+  ns = u8x8_sim_bits_ns(u8x8, (unsigned long)cnt * (u8x8_sim.is_i2c ? 9 : 8));
+  u8x8_sim_stat(ns, 0);
+  return ns;
+}
+
+/* CPU is blocked */
+static void u8x8_sim_block(unsigned long ns)
+{
+  u8x8_sim.now_ns += ns;
+  u8x8_sim.wait_ns += ns;
+}
+
+#ifdef U8X8_WITH_XFER
+static void u8x8_sim_complete(void)
+{
+  u8x8_xfer_t *xfer = (u8x8_xfer_t *)u8x8_sim.pending;
+  u8x8_sim.pending = NULL;
+  u8x8_xfer_Done(u8x8_sim.pending_u8x8, xfer);
+}
+
+static unsigned long u8x8_sim_xfer_ns(u8x8_t *u8x8, u8x8_xfer_t *xfer)
+{
+  unsigned long ns = 0;
+  uint8_t i;
+  for( i = 0; i < xfer->seg_cnt; i++ )
+  {
+    if ( xfer->seg_list[i].flags & U8X8_XFER_SEG_START )
+      ns += u8x8_sim_start_ns(u8x8, u8x8_sim.now_ns + ns);
+    u8x8_sim_trace_dc((xfer->seg_list[i].flags & U8X8_XFER_SEG_DC) ? 1 : 0, u8x8_sim.now_ns + ns);
+    ns += u8x8_sim_bytes_ns(u8x8, xfer->seg_list[i].cnt, xfer->seg_list[i].data, u8x8_sim.now_ns + ns);
+    if ( xfer->seg_list[i].flags & U8X8_XFER_SEG_END )
+      ns += u8x8_sim_end_ns(u8x8, u8x8_sim.now_ns + ns);
+  }
+  return ns;
+}
+#endif
+
+/* the CPU has done something else for ns nanoseconds */
+void u8x8_sim_Advance(unsigned long long ns)
+{
+  u8x8_sim.now_ns += ns;
+#ifdef U8X8_WITH_XFER
+  if ( u8x8_sim.pending != NULL && u8x8_sim.now_ns >= u8x8_sim.done_ns )
+    u8x8_sim_complete();
+#endif
+}
+
+uint8_t u8x8_byte_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      u8x8_sim_block(u8x8_sim_bytes_ns(u8x8, arg_int, (const uint8_t *)arg_ptr, u8x8_sim.now_ns));
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      u8x8_sim_trace_dc(arg_int, u8x8_sim.now_ns);
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      u8x8_sim_block(u8x8_sim_start_ns(u8x8, u8x8_sim.now_ns));
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      u8x8_sim_block(u8x8_sim_end_ns(u8x8, u8x8_sim.now_ns));
+      break;
+    case U8X8_MSG_BYTE_INIT:
+      if ( u8x8_sim.trace != NULL )
+      {
+	u8x8_sim_trace_time(u8x8_sim.now_ns);
+	fprintf(u8x8_sim.trace, "init\n");
+      }
+      break;
+#ifdef U8X8_WITH_XFER
+    case U8X8_MSG_BYTE_XFER_SUBMIT:
+      if ( u8x8_sim.is_async == 0 )
+	return 0;
+      u8x8_sim.submits++;
+      u8x8_sim.pending = arg_ptr;
+      u8x8_sim.pending_u8x8 = u8x8;
+      u8x8_sim.done_ns = u8x8_sim.now_ns + u8x8_sim_xfer_ns(u8x8, (u8x8_xfer_t *)arg_ptr);
+      break;
+    case U8X8_MSG_BYTE_XFER_POLL:
+      if ( u8x8_sim.pending != NULL )
+      {
+	if ( u8x8_sim.done_ns > u8x8_sim.now_ns )
+	  u8x8_sim_block(u8x8_sim.done_ns - u8x8_sim.now_ns);
+	u8x8_sim_complete();
+      }
+      break;
+#endif
+    default:
+      return 0;
+  }
+  u8x8_sim.frame.msg_cnt++;
+  return 1;
+}
+
+/*=========================================*/
+/* frame report */
+
+static void u8x8_sim_stat_add(struct u8x8_sim_stat_struct *dest, const struct u8x8_sim_stat_struct *src)
+{
+  dest->wire_ns += src->wire_ns;
+  dest->overhead_ns += src->overhead_ns;
+  dest->transfers += src->transfers;
+  dest->bytes += src->bytes;
+  dest->data_bytes += src->data_bytes;
+  dest->msg_cnt += src->msg_cnt;
+}
+
+static void u8x8_sim_print(const char *name, const struct u8x8_sim_stat_struct *s)
+{
+  printf("%-24s %9.3f %9.3f %9lu %9lu %9lu %9lu\n", name, s->wire_ns/1e6, s->overhead_ns/1e6, 
+    s->transfers, s->bytes, s->data_bytes, s->msg_cnt);
+}
+
+void u8x8_sim_PrintHeader(void)
+{
+  printf("%-24s %9s %9s %9s %9s %9s %9s\n", "frame", "wire ms", "overh. ms", "transfers", "bytes", "data", "messages");
+}
+
+/* prints the timing of the frame and returns the time on the wire in microseconds */
+uint32_t u8x8_sim_EndFrame(void)
+{
+  if ( u8x8_sim.is_frame == 0 )
+    return 0;
+  u8x8_sim.is_frame = 0;
+  u8x8_sim.frame_cnt++;
+  u8x8_sim_stat_add(&u8x8_sim.total, &u8x8_sim.frame);
+  if ( u8x8_sim.trace != NULL )
+  {
+    u8x8_sim_trace_time(u8x8_sim.now_ns);
+    fprintf(u8x8_sim.trace, "end of frame: %lu transfers, %lu bytes\n", u8x8_sim.frame.transfers, u8x8_sim.frame.bytes);
+  }
+  u8x8_sim_print(u8x8_sim.frame_name, &u8x8_sim.frame);
+  return (uint32_t)(u8x8_sim.frame.wire_ns / 1000);
+}
+
+void u8x8_sim_BeginFrame(const char *name)
+{
+  if ( u8x8_sim.is_frame )
+    u8x8_sim_EndFrame();
+  memset(&u8x8_sim.frame, 0, sizeof(u8x8_sim.frame));
+  strncpy(u8x8_sim.frame_name, name, sizeof(u8x8_sim.frame_name)-1);
+  u8x8_sim.frame_name[sizeof(u8x8_sim.frame_name)-1] = '\0';
+  u8x8_sim.frame_start_ns = u8x8_sim.now_ns;
+  u8x8_sim.is_frame = 1;
+  if ( u8x8_sim.trace != NULL )
+    fprintf(u8x8_sim.trace, "frame %lu %s\n", u8x8_sim.frame_cnt, u8x8_sim.frame_name);
+}
+
+/* prints the sum of all frames since u8x8_sim_Init() */
+void u8x8_sim_PrintTotal(void)
+{
+  u8x8_sim_print("total", &u8x8_sim.total);
+  if ( u8x8_sim.trace != NULL )
+    fflush(u8x8_sim.trace);
+}
@@ -0,0 +1,323 @@
+/* 
+
+  u8x8_logic_sim.c 
+
+  Universal 8bit Graphics Library (https://github.com/olikraus/u8g2/)
+
+  Copyright (c) 2016, olikraus@gmail.com
+  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without modification, 
+  are permitted provided that the following conditions are met:
+
+  * Redistributions of source code must retain the above copyright notice, this list 
+    of conditions and the following disclaimer.
+    
+  * Redistributions in binary form must reproduce the above copyright notice, this 
+    list of conditions and the following disclaimer in the documentation and/or other 
+    materials provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND 
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF 
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+  DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR 
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; 
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, 
+  STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+  ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  
+
+  
+  Logic trace simulator: The port access of u8x8_byte_fast.c and the 
+  gpio messages of u8x8_byte.c are recorded with a simulated time.
+  The trace is decoded and the I2C or SPI timing is checked.
+  
+  Build with: gcc -include u8x8_logic_sim.h ...
+  
+*/
+
+#include "u8x8.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_MAX 600000
+
+struct trace
+{
+  unsigned long long t_ps;
+  uint8_t lines;
+};
+
+static struct trace trace_list[TRACE_MAX];
+static unsigned long trace_cnt;
+static unsigned long long now_ps;
+
+volatile uint32_t u8x8_logic_port;
+struct u8x8_logic_model u8x8_logic_model = { 25, 12000, 200 };
+
+static void u8x8_logic_record(void)
+{
+  if ( trace_cnt > 0 && trace_list[trace_cnt-1].lines == (uint8_t)u8x8_logic_port )
+    return;
+  if ( trace_cnt >= TRACE_MAX )
+    return;
+  trace_list[trace_cnt].t_ps = now_ps;
+  trace_list[trace_cnt].lines = (uint8_t)u8x8_logic_port;
+  trace_cnt++;
+}
+
+void u8x8_logic_port_set(volatile uint32_t *port, uint32_t mask)
+{
+  *port |= mask;
+  u8x8_logic_record();
+  now_ps += u8x8_logic_model.port_ns*1000ULL;
+}
+
+void u8x8_logic_port_clr(volatile uint32_t *port, uint32_t mask)
+{
+  *port &= ~mask;
+  u8x8_logic_record();
+  now_ps += u8x8_logic_model.port_ns*1000ULL;
+}
+
+void u8x8_logic_delay(uint16_t loops)
+{
+  now_ps += (unsigned long long)loops * u8x8_logic_model.loop_ps;
+}
+
+void u8x8_logic_Reset(void)
+{
+  trace_cnt = 0;
+  u8x8_logic_record();
+}
+
+uint32_t u8x8_logic_GetMicros(void)
+{
+  return (uint32_t)(now_ps / 1000000ULL);
+}
+
+static void u8x8_logic_line(uint8_t line, uint8_t is_set)
+{
+  if ( is_set )
+    u8x8_logic_port |= line;
+  else
+    u8x8_logic_port &= ~(uint32_t)line;
+  u8x8_logic_record();
+}
+
+uint8_t u8x8_gpio_and_delay_logic(struct u8x8_struct *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  now_ps += u8x8_logic_model.msg_ns*1000ULL;
+  switch(msg)
+  {
+    case U8X8_MSG_GPIO_AND_DELAY_INIT:
+      break;
+    case U8X8_MSG_DELAY_NANO:
+      now_ps += arg_int == 0 ? 0 : 1000000ULL;
+      break;
+    case U8X8_MSG_DELAY_MILLI:
+      now_ps += arg_int * 1000000000ULL;
+      break;
+    case U8X8_MSG_DELAY_I2C:
+      now_ps += arg_int <= 2 ? 5000000ULL : 2000000ULL;
+      break;
+    case U8X8_MSG_GPIO_I2C_CLOCK:
+    case U8X8_MSG_GPIO_SPI_CLOCK:
+      u8x8_logic_line(U8X8_LOGIC_CLOCK, arg_int);
+      break;
+    case U8X8_MSG_GPIO_I2C_DATA:
+    case U8X8_MSG_GPIO_SPI_DATA:
+      u8x8_logic_line(U8X8_LOGIC_DATA, arg_int);
+      break;
+    case U8X8_MSG_GPIO_CS:
+      u8x8_logic_line(U8X8_LOGIC_CS, arg_int);
+      break;
+    case U8X8_MSG_GPIO_DC:
+      u8x8_logic_line(U8X8_LOGIC_DC, arg_int);
+      break;
+    default:
+      break;
+  }
+  return 1;
+}
+
+static void u8x8_logic_error(struct u8x8_logic_result *r, const char *msg, double t_ns, double min_ns)
+{
+  static char buf[128];
+  if ( r->errors == 0 )
+  {
+    sprintf(buf, "%s: %.0fns < %.0fns", msg, t_ns, min_ns);
+    r->first_error = buf;
+  }
+  r->errors++;
+}
+
+static void u8x8_logic_check(struct u8x8_logic_result *r, const char *msg, double t_ns, double min_ns)
+{
+  if ( t_ns < min_ns )
+    u8x8_logic_error(r, msg, t_ns, min_ns);
+}
+
+static void u8x8_logic_byte(struct u8x8_logic_result *r, const uint16_t *expected, unsigned long cnt, uint16_t b)
+{
+  if ( r->bytes >= cnt || expected[r->bytes] != b )
+  {
+    if ( r->errors == 0 )
+      r->first_error = "decoded byte differs";
+    r->errors++;
+  }
+  r->bytes++;
+}
+
+/* I2C specification: t_low, t_high, t_su_dat, t_hd_sta, t_su_sto, t_buf */
+static const double i2c_min_ns[3][6] = {
+  { 4700, 4000, 250, 4000, 4000, 4700 },	/* standard mode, 100 kHz */
+  { 1300, 600, 100, 600, 600, 1300 },		/* fast mode, 400 kHz */
+  { 500, 260, 50, 260, 260, 500 }		/* fast mode plus, 1 MHz */
+};
+
+void u8x8_logic_CheckI2C(struct u8x8_logic_result *r, const uint16_t *expected, unsigned long cnt, unsigned khz)
+{
+  const double *spec = i2c_min_ns[khz <= 100 ? 0 : (khz <= 400 ? 1 : 2)];
+  unsigned long i;
+  double t, scl_rise = 0, scl_fall = 0, sda_change = 0, start = 0, stop = -1e12;
+  uint8_t p, l, is_transfer = 0, is_first_fall = 0, bit_cnt = 0;
+  uint16_t b = 0;
+  
+  memset(r, 0, sizeof(*r));
+  r->first_error = "";
+  if ( trace_cnt == 0 )
+    return;
+  p = trace_list[0].lines;
+  for( i = 1; i < trace_cnt; i++ )
+  {
+    t = trace_list[i].t_ps / 1000.0;
+    l = trace_list[i].lines;
+    if ( (p & U8X8_LOGIC_CLOCK) && (l & U8X8_LOGIC_CLOCK) && ((p ^ l) & U8X8_LOGIC_DATA) )
+    {
+      if ( (l & U8X8_LOGIC_DATA) == 0 )
+      {
+	/* start condition */
+	if ( is_transfer == 0 )
+	  u8x8_logic_check(r, "t_buf", t-stop, spec[5]);
+	else
+	  r->busy_ns += t-start;
+	is_transfer = 1;
+	is_first_fall = 1;
+	start = t;
+	bit_cnt = 0;
+      }
+      else if ( is_transfer )
+      {
+	/* stop condition */
+	u8x8_logic_check(r, "t_su_sto", t-scl_rise, spec[4]);
+	r->busy_ns += t-start;
+	is_transfer = 0;
+	stop = t;
+      }
+    }
+    else if ( is_transfer && (~p & l & U8X8_LOGIC_CLOCK) )
+    {
+      u8x8_logic_check(r, "t_low", t-scl_fall, spec[0]);
+      u8x8_logic_check(r, "t_su_dat", t-sda_change, spec[2]);
+      scl_rise = t;
+      r->bits++;
+      bit_cnt++;
+      if ( bit_cnt <= 8 )
+	b = (b << 1) | ((l & U8X8_LOGIC_DATA) ? 1 : 0);
+      if ( bit_cnt == 9 )
+      {
+	/* 9th bit is the ack */
+	u8x8_logic_byte(r, expected, cnt, b & 255);
+	bit_cnt = 0;
+      }
+    }
+    else if ( is_transfer && (p & ~l & U8X8_LOGIC_CLOCK) )
+    {
+      if ( is_first_fall )
+	u8x8_logic_check(r, "t_hd_sta", t-start, spec[3]);
+      else
+	u8x8_logic_check(r, "t_high", t-scl_rise, spec[1]);
+      is_first_fall = 0;
+      scl_fall = t;
+    }
+    else if ( (p ^ l) & U8X8_LOGIC_DATA )
+    {
+      sda_change = t;
+    }
+    p = l;
+  }
+  if ( r->bytes != cnt && r->errors == 0 )
+  {
+    r->first_error = "number of decoded bytes differs";
+    r->errors++;
+  }
+  if ( r->busy_ns > 0 )
+    r->khz = r->bits * 1e6 / r->busy_ns;
+}
+
+/* chip select is low active */
+void u8x8_logic_CheckSPI(struct u8x8_logic_result *r, const uint16_t *expected, unsigned long cnt, 
+  uint8_t takeover_edge, unsigned setup_ns, unsigned pulse_ns)
+{
+  unsigned long i;
+  double t, cs_start = 0, clock_edge = 0, data_change = 0;
+  uint8_t p, l, bit_cnt = 0;
+  uint16_t b = 0;
+  uint8_t takeover_level = takeover_edge ? U8X8_LOGIC_CLOCK : 0;
+  
+  memset(r, 0, sizeof(*r));
+  r->first_error = "";
+  if ( trace_cnt == 0 )
+    return;
+  p = trace_list[0].lines;
+  for( i = 1; i < trace_cnt; i++ )
+  {
+    t = trace_list[i].t_ps / 1000.0;
+    l = trace_list[i].lines;
+    if ( (p & U8X8_LOGIC_CS) && !(l & U8X8_LOGIC_CS) )
+    {
+      cs_start = t;
+      clock_edge = t;
+      bit_cnt = 0;
+    }
+    else if ( !(p & U8X8_LOGIC_CS) && (l & U8X8_LOGIC_CS) )
+    {
+      r->busy_ns += t - cs_start;
+    }
+    else if ( !(l & U8X8_LOGIC_CS) && ((p ^ l) & U8X8_LOGIC_CLOCK) )
+    {
+      if ( clock_edge > cs_start )
+	u8x8_logic_check(r, "clock pulse width", t-clock_edge, pulse_ns);
+      clock_edge = t;
+      if ( (l & U8X8_LOGIC_CLOCK) == takeover_level )
+      {
+	u8x8_logic_check(r, "data setup", t-data_change, setup_ns);
+	r->bits++;
+	b = (b << 1) | ((l & U8X8_LOGIC_DATA) ? 1 : 0);
+	bit_cnt++;
+	if ( bit_cnt == 8 )
+	{
+	  u8x8_logic_byte(r, expected, cnt, (b & 255) | ((l & U8X8_LOGIC_DC) ? 256 : 0));
+	  bit_cnt = 0;
+	}
+      }
+    }
+    else if ( (p ^ l) & U8X8_LOGIC_DATA )
+    {
+      data_change = t;
+    }
+    p = l;
+  }
+  if ( r->bytes != cnt && r->errors == 0 )
+  {
+    r->first_error = "number of decoded bytes differs";
+    r->errors++;
+  }
+  if ( r->busy_ns > 0 )
+    r->khz = r->bits * 1e6 / r->busy_ns;
+}
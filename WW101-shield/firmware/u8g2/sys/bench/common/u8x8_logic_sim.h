@@ -0,0 +1,66 @@
+/*
+  u8x8_logic_sim.h
+  
+  Logic trace simulator for the software I2C and SPI procedures.
+  Include this before u8x8.h (gcc -include u8x8_logic_sim.h), so that the
+  port access and the delay of u8x8_byte_fast.c are simulated.
+*/
+
+#ifndef U8X8_LOGIC_SIM_H
+#define U8X8_LOGIC_SIM_H
+
+#include <stdint.h>
+
+struct u8x8_struct;
+
+/* lines of the simulated port */
+#define U8X8_LOGIC_CLOCK 1
+#define U8X8_LOGIC_DATA 2
+#define U8X8_LOGIC_CS 4
+#define U8X8_LOGIC_DC 8
+
+/* cost model of the simulated controller */
+struct u8x8_logic_model
+{
+  unsigned port_ns;		/* one port access */
+  unsigned loop_ps;		/* one delay loop */
+  unsigned msg_ns;		/* one call of the gpio_and_delay_cb */
+};
+
+struct u8x8_logic_result
+{
+  unsigned long bytes;		/* decoded bytes */
+  unsigned long errors;		/* timing violations */
+  unsigned long bits;		/* clock pulses */
+  double busy_ns;		/* time between start and stop (I2C) or with active chip select (SPI) */
+  double khz;			/* bits/busy_ns */
+  const char *first_error;
+};
+
+extern volatile uint32_t u8x8_logic_port;
+extern struct u8x8_logic_model u8x8_logic_model;
+
+void u8x8_logic_port_set(volatile uint32_t *port, uint32_t mask);
+void u8x8_logic_port_clr(volatile uint32_t *port, uint32_t mask);
+void u8x8_logic_delay(uint16_t loops);
+
+/* 
+  gpio_and_delay_cb for the procedures of u8x8_byte.c (and chip select/dc of the fast procedures).
+  Delays are the same as in the Arduino procedure (U8x8lib.cpp): 
+  U8X8_MSG_DELAY_I2C 5us (100kHz) or 2us, U8X8_MSG_DELAY_NANO 1us 
+*/
+uint8_t u8x8_gpio_and_delay_logic(struct u8x8_struct *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+void u8x8_logic_Reset(void);
+uint32_t u8x8_logic_GetMicros(void);
+/* decode the trace, compare with the expected bytes and check the timing */
+void u8x8_logic_CheckI2C(struct u8x8_logic_result *r, const uint16_t *expected, unsigned long cnt, unsigned khz);
+/* takeover_edge: 1 rising, 0 falling; expected bytes have bit 8 set for D/C = 1 */
+void u8x8_logic_CheckSPI(struct u8x8_logic_result *r, const uint16_t *expected, unsigned long cnt, 
+  uint8_t takeover_edge, unsigned setup_ns, unsigned pulse_ns);
+
+#define U8X8_FAST_PORT_SET(port, mask) u8x8_logic_port_set((port), (mask))
+#define U8X8_FAST_PORT_CLR(port, mask) u8x8_logic_port_clr((port), (mask))
+#define U8X8_FAST_DELAY(loops) u8x8_logic_delay(loops)
+
+#endif
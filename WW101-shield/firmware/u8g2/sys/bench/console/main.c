@@ -0,0 +1,96 @@
+/*
+  Text console (u8x8_console.c) with and without hardware scroll.
+  
+  SSD1306 128x64 with the I2C command/data interface. The I2C bus is 
+  simulated: Each byte requires 9 clock cycles at 400 kHz, each transfer 
+  adds start condition, address byte and stop condition.
+  
+  The SSD1306 128x32 does not support the start line message. Like
+  u8x8_d_stdio, the wrapper below returns 1 for unknown messages, still the
+  console must not use the hardware scroll there.
+  
+  Build and run: make test
+*/
+
+#include "u8x8.h"
+#include <stdio.h>
+
+#define I2C_KHZ 400
+#define BYTE_US (9.0*1000.0/I2C_KHZ)
+#define TRANSFER_US (BYTE_US*2)
+#define LINES 200
+
+static double bus_us;
+static unsigned long bus_bytes;
+
+uint8_t u8x8_byte_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      bus_us += BYTE_US * arg_int;
+      bus_bytes += arg_int;
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      bus_us += TRANSFER_US;
+      break;
+  }
+  return 1;
+}
+
+void bench(uint8_t is_hw_scroll)
+{
+  static char buf[16*8];
+  u8x8_t u8x8;
+  u8x8_console_t con;
+  char line[32];
+  uint16_t i;
+  
+  u8x8_Setup(&u8x8, u8x8_d_ssd1306_128x64_noname, u8x8_cad_ssd13xx_i2c, u8x8_byte_sim, u8x8_byte_sim);
+  u8x8_SetFont(&u8x8, u8x8_font_amstrad_cpc_extended_f);
+  u8x8_ConsoleInit(&u8x8, &con, buf);
+  u8x8_ConsoleSetHardwareScroll(&con, is_hw_scroll);
+  
+  /* fill the display, so that each new line will scroll */
+  for( i = 0; i < 8; i++ )
+    u8x8_ConsoleWrite(&u8x8, &con, "\n");
+  
+  bus_us = 0;
+  bus_bytes = 0;
+  for( i = 0; i < LINES; i++ )
+  {
+    sprintf(line, "\nline %5u", i);
+    u8x8_ConsoleWrite(&u8x8, &con, line);
+  }
+  printf("%-16s %6lu bytes/line %8.0f us/line %6.1f lines/s\n", 
+    con.is_hw_scroll ? "hardware scroll" : "redraw",
+    bus_bytes/LINES, bus_us/LINES, LINES*1000000.0/bus_us);
+}
+
+uint8_t u8x8_d_ack_all(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_d_ssd1306_128x32_univision(u8x8, msg, arg_int, arg_ptr);
+  return 1;
+}
+
+int check_no_start_line(void)
+{
+  static char buf[16*4];
+  u8x8_t u8x8;
+  u8x8_console_t con;
+  
+  u8x8_Setup(&u8x8, u8x8_d_ack_all, u8x8_cad_ssd13xx_i2c, u8x8_byte_sim, u8x8_byte_sim);
+  u8x8_SetFont(&u8x8, u8x8_font_amstrad_cpc_extended_f);
+  u8x8_ConsoleInit(&u8x8, &con, buf);
+  printf("ssd1306 128x32: hardware scroll %s   %s\n", 
+    con.is_hw_scroll ? "on" : "off", con.is_hw_scroll ? "failed" : "ok");
+  return con.is_hw_scroll;
+}
+
+int main(void)
+{
+  printf("ssd1306 128x64, I2C %d kHz\n", I2C_KHZ);
+  bench(0);
+  bench(1);
+  return check_no_start_line();
+}
@@ -0,0 +1,187 @@
+/*
+  Double buffering with asynchronous transfer (U8G2_WITH_DOUBLE_BUFFER).
+  
+  The I2C bus is simulated: Each byte requires 9 clock cycles at 400 kHz,
+  each transfer adds start condition, address byte and stop condition.
+  A second device (e.g. the CapSense controller) must wait until the
+  display releases the bus. The bus is released after u8g2_SendBuffer() 
+  or after each u8g2_SendBufferStep().
+  
+  bench_double_buffer_diff is built with U8G2_WITH_FRAME_DIFF and 
+  additionally mixes u8g2_SendBuffer() and u8g2_SendBufferAsync(): The
+  display memory is modelled and compared with the frame after each transfer.
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+
+#define I2C_KHZ 400
+#define BYTE_US (9.0*1000.0/I2C_KHZ)
+#define TRANSFER_US (BYTE_US*2)
+
+static double bus_us;		/* bus time of the display */
+static uint16_t frames_done;
+
+uint8_t u8x8_byte_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_SEND:
+      bus_us += BYTE_US * arg_int;
+      break;
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      bus_us += TRANSFER_US;
+      break;
+  }
+  return 1;
+}
+
+#ifdef U8G2_WITH_FRAME_DIFF
+
+/* display model: the display memory as written by DRAW_TILE */
+static uint8_t model_ram[128*8];
+
+uint8_t u8x8_d_model(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_tile_t *tile;
+  uint8_t i;
+  
+  if ( msg == U8X8_MSG_DISPLAY_DRAW_TILE )
+  {
+    tile = (u8x8_tile_t *)arg_ptr;
+    for( i = 0; i < arg_int; i++ )
+      memcpy(model_ram + tile->y_pos*128 + (tile->x_pos + i*tile->cnt)*8, tile->tile_ptr, tile->cnt*8);
+  }
+  return u8x8_d_ssd1306_128x64_noname(u8x8, msg, arg_int, arg_ptr);
+}
+
+#endif /* U8G2_WITH_FRAME_DIFF */
+
+void send_done(u8g2_t *u8g2)
+{
+  /* on the target, set a semaphore here */
+  frames_done++;
+}
+
+void draw(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_ClearBuffer(u8g2);
+  u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+  u8g2_DrawBox(u8g2, frame & 63, 10, 20, 20);
+  u8g2_DrawDisc(u8g2, 100, 40, 10 + (frame & 7), U8G2_DRAW_ALL);
+}
+
+void bench_sync(u8g2_t *u8g2)
+{
+  bus_us = 0;
+  draw(u8g2, 0);
+  u8g2_SendBuffer(u8g2);
+  printf("%-24s frame %7.0f us, draw task blocked %7.0f us, longest bus lock %7.0f us\n", 
+    "u8g2_SendBuffer", bus_us, bus_us, bus_us);
+}
+
+void bench_async(u8g2_t *u8g2, uint8_t chunk)
+{
+  double frame_us, start_us, max_lock_us;
+  char s[32];
+  
+  u8g2_SetSendChunkSize(u8g2, chunk);
+  
+  frames_done = 0;
+  bus_us = 0;
+  draw(u8g2, 0);
+  
+  /* draw task: returns immediately, the bus is not used */
+  start_us = bus_us;
+  u8g2_SendBufferAsync(u8g2, send_done);
+  frame_us = bus_us - start_us;
+  
+  /* the draw task can continue with the next frame while the transfer is active */
+  draw(u8g2, 1);
+  
+  /* transfer task: one part per bus lock */
+  max_lock_us = 0;
+  while( u8g2_IsSendBusy(u8g2) )
+  {
+    start_us = bus_us;
+    u8g2_SendBufferStep(u8g2);
+    if ( max_lock_us < bus_us - start_us )
+      max_lock_us = bus_us - start_us;
+  }
+  
+  sprintf(s, "async, %d tiles/step", chunk);
+  printf("%-24s frame %7.0f us, draw task blocked %7.0f us, longest bus lock %7.0f us, done %d\n", 
+    s, bus_us, frame_us, max_lock_us, frames_done);
+}
+
+#ifdef U8G2_WITH_FRAME_DIFF
+
+/* 
+  Send the frames 0, 1, 0, 1, 1, 0 and alternate between the synchronous
+  and the asynchronous transfer. After an asynchronous transfer, the 
+  shadow buffer does not reflect the display memory.
+*/
+int bench_mixed(u8g2_t *u8g2)
+{
+  static const uint8_t frame_seq[] = { 0, 1, 0, 1, 1, 0 };
+  static const uint8_t async_seq[] = { 0, 1, 0, 0, 1, 0 };
+  static uint8_t frame_buf[128*8];
+  uint8_t i;
+  int err = 0;
+  
+  for( i = 0; i < sizeof(frame_seq); i++ )
+  {
+    bus_us = 0;
+    draw(u8g2, frame_seq[i]);
+    memcpy(frame_buf, u8g2_GetBufferPtr(u8g2), sizeof(frame_buf));
+    if ( async_seq[i] )
+    {
+      u8g2_SendBufferAsync(u8g2, send_done);
+      u8g2_FinishSendBuffer(u8g2);
+    }
+    else
+    {
+      u8g2_SendBuffer(u8g2);
+    }
+    printf("%-24s frame %d %7.0f us, display memory %s\n", 
+      async_seq[i] ? "mixed, async" : "mixed, u8g2_SendBuffer", frame_seq[i], bus_us,
+      memcmp(model_ram, frame_buf, sizeof(frame_buf)) == 0 ? "ok" : "failed");
+    if ( memcmp(model_ram, frame_buf, sizeof(frame_buf)) != 0 )
+      err = 1;
+  }
+  return err;
+}
+
+#endif /* U8G2_WITH_FRAME_DIFF */
+
+int main(void)
+{
+  static uint8_t back_buf[128*8];
+  u8g2_t u8g2;
+#ifdef U8G2_WITH_FRAME_DIFF
+  static uint8_t shadow_buf[128*8];
+#endif
+  
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_sim, u8x8_byte_sim);
+#ifdef U8G2_WITH_FRAME_DIFF
+  u8g2_GetU8x8(&u8g2)->display_cb = u8x8_d_model;
+  u8g2_SetShadowBuffer(&u8g2, shadow_buf);
+  printf("ssd1306 128x64, I2C %d kHz, frame diff\n", I2C_KHZ);
+#else
+  printf("ssd1306 128x64, I2C %d kHz\n", I2C_KHZ);
+#endif
+  bench_sync(&u8g2);
+  u8g2_SetBackBuffer(&u8g2, back_buf);
+  bench_async(&u8g2, 16);
+  bench_async(&u8g2, 8);
+  bench_async(&u8g2, 4);
+  bench_async(&u8g2, 1);
+#ifdef U8G2_WITH_FRAME_DIFF
+  return bench_mixed(&u8g2);
+#else
+  return 0;
+#endif
+}
@@ -0,0 +1,217 @@
+/*
+  Partial and non-blocking refresh of the SSD1607 (U8X8_WITH_EPD).
+  
+  The SSD1607 is emulated: The update time follows from the timing part 
+  of the loaded LUT (12 ms per frame, about 950 ms with the full LUT), 
+  power down requires 267 ms. BUSY is high during this time. Commands 
+  which are sent while BUSY is high are counted as errors.
+  
+  Each update: render (20 ms), u8g2_SendBuffer(), other work of the 
+  application (1000 ms), which polls u8x8_IsRefreshBusy() every 10 ms.
+  "blocked" is the time spent in delays of the library.
+  
+  u8x8_IsRefreshBusy() must return 0 for a display procedure, which 
+  returns 1 for all messages (like u8x8_d_stdio).
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+
+#define UPDATES 20
+#define FRAME_MS 12
+
+/* ../common/u8x8_byte_sim.c */
+struct u8x8_sim_struct
+{
+  unsigned long long now_ns;
+  unsigned long long done_ns;
+  unsigned long long wait_ns;
+  unsigned long bit_ns;
+  unsigned long transfers;
+  unsigned long bytes;
+  unsigned long submits;
+  unsigned long checksum;
+  uint8_t is_i2c;
+  uint8_t is_async;
+  uint8_t dc;
+  void *pending;
+  u8x8_t *pending_u8x8;
+};
+extern struct u8x8_sim_struct u8x8_sim;
+extern void u8x8_sim_Init(uint8_t is_i2c, unsigned long clock_khz, uint8_t is_async);
+extern void u8x8_sim_Advance(unsigned long long ns);
+extern uint8_t u8x8_byte_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+/*=========================================*/
+/* SSD1607 update engine */
+
+struct
+{
+  unsigned long long busy_until_ns;
+  unsigned long long update_ns;		/* sum of all pattern display updates */
+  uint8_t lut[30];
+  uint8_t cmd;
+  uint8_t arg_pos;
+  uint8_t option;	/* command 0x22 */
+  uint8_t is_dc;
+  unsigned full_cnt;
+  unsigned partial_cnt;
+  unsigned busy_errors;
+} epd;
+
+static unsigned lut_frames(void)
+{
+  unsigned i, n = 0;
+  for( i = 20; i < 30; i++ )
+    n += (epd.lut[i] >> 4) + (epd.lut[i] & 15);
+  return n;
+}
+
+static void epd_execute(void)
+{
+  unsigned long long t = 0;
+  if ( epd.option & 0xc0 )
+    t += 10000000ULL;		/* enable clock and charge pump */
+  if ( epd.option & 0x04 )
+  {
+    t += (unsigned long long)lut_frames()*FRAME_MS*1000000ULL;
+    epd.update_ns += t;
+    if ( lut_frames() > 40 )
+      epd.full_cnt++;
+    else
+      epd.partial_cnt++;
+  }
+  if ( epd.option & 0x03 )
+    t += 267000000ULL;	/* disable clock and charge pump */
+  epd.busy_until_ns = u8x8_sim.now_ns + t;
+}
+
+static void epd_byte(uint8_t b)
+{
+  if ( u8x8_sim.now_ns < epd.busy_until_ns )
+    epd.busy_errors++;
+  if ( epd.is_dc == 0 )
+  {
+    epd.cmd = b;
+    epd.arg_pos = 0;
+    if ( b == 0x20 )
+      epd_execute();
+    return;
+  }
+  if ( epd.cmd == 0x22 )
+    epd.option = b;
+  else if ( epd.cmd == 0x32 && epd.arg_pos < 30 )
+    epd.lut[epd.arg_pos] = b;
+  epd.arg_pos++;
+}
+
+uint8_t u8x8_byte_epd(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t i;
+  if ( msg == U8X8_MSG_BYTE_SET_DC )
+    epd.is_dc = arg_int;
+  else if ( msg == U8X8_MSG_BYTE_SEND )
+    for( i = 0; i < arg_int; i++ )
+      epd_byte(((uint8_t *)arg_ptr)[i]);
+  return u8x8_byte_sim(u8x8, msg, arg_int, arg_ptr);
+}
+
+static unsigned long long blocked_ns;
+
+uint8_t u8x8_gpio_epd(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_DELAY_MILLI:
+      u8x8_sim_Advance(arg_int*1000000ULL);
+      blocked_ns += arg_int*1000000ULL;
+      break;
+    case U8X8_MSG_GPIO_BUSY:
+      u8x8_SetGPIOResult(u8x8, u8x8_sim.now_ns < epd.busy_until_ns ? 1 : 0);
+      break;
+  }
+  return 1;
+}
+
+/*=========================================*/
+
+static u8g2_t u8g2;
+static u8x8_epd_t epd_state;
+
+static void run(const char *name, uint8_t is_epd, uint8_t full_interval)
+{
+  unsigned long long start_ns;
+  int i, j;
+  
+  u8x8_sim_Init(0, 4000, 0);
+  u8g2_Setup_ssd1607_200x200_f(&u8g2, U8G2_R0, u8x8_byte_epd, u8x8_gpio_epd);
+  if ( is_epd )
+    u8x8_SetEpd(u8g2_GetU8x8(&u8g2), &epd_state, full_interval);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  
+  /* statistics without the init sequence */
+  u8x8_WaitRefresh(u8g2_GetU8x8(&u8g2));
+  if ( u8x8_sim.now_ns < epd.busy_until_ns )
+    u8x8_sim.now_ns = epd.busy_until_ns;
+  start_ns = u8x8_sim.now_ns;
+  blocked_ns = 0;
+  epd.update_ns = 0;
+  epd.full_cnt = 0;
+  epd.partial_cnt = 0;
+  epd.busy_errors = 0;
+  
+  for( i = 0; i < UPDATES; i++ )
+  {
+    u8g2_ClearBuffer(&u8g2);
+    u8g2_DrawFrame(&u8g2, 0, 0, 200, 200);
+    u8g2_DrawBox(&u8g2, 10+i*8, 80, 20, 40);
+    u8x8_sim_Advance(20000000ULL);
+    u8g2_SendBuffer(&u8g2);
+    for( j = 0; j < 100; j++ )
+    {
+      u8x8_sim_Advance(10000000ULL);
+      u8x8_IsRefreshBusy(u8g2_GetU8x8(&u8g2));
+    }
+  }
+  u8x8_WaitRefresh(u8g2_GetU8x8(&u8g2));
+  
+  printf("%-22s %8.1f %10.1f %6u %8u %10.1f %7u\n", name, 
+    (u8x8_sim.now_ns-start_ns)/1e9,
+    blocked_ns/1e6/UPDATES, 
+    epd.full_cnt, epd.partial_cnt, 
+    epd.full_cnt+epd.partial_cnt ? epd.update_ns/1e6/(epd.full_cnt+epd.partial_cnt) : 0.0,
+    epd.busy_errors);
+  u8x8_SetEpd(u8g2_GetU8x8(&u8g2), NULL, 0);
+}
+
+uint8_t u8x8_d_ack_all(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_d_ssd1306_128x64_noname(u8x8, msg, arg_int, arg_ptr);
+  return 1;
+}
+
+int check_ack_all(void)
+{
+  u8g2_t u8g2;
+  uint8_t is_busy;
+  
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_epd, u8x8_gpio_epd);
+  u8g2_GetU8x8(&u8g2)->display_cb = u8x8_d_ack_all;
+  /* u8x8_WaitRefresh() would not return if this is 1 */
+  is_busy = u8x8_IsRefreshBusy(u8g2_GetU8x8(&u8g2));
+  printf("ssd1306, all messages acknowledged: busy %d   %s\n", is_busy, is_busy ? "failed" : "ok");
+  return is_busy;
+}
+
+int main(void)
+{
+  printf("%d updates\n", UPDATES);
+  printf("%-22s %8s %10s %6s %8s %10s %7s\n", "", "total s", "blocked ms", "full", "partial", "update ms", "errors");
+  run("blocking", 0, 0);
+  run("non-blocking, full", 1, 0);
+  run("non-blocking, 1+9", 1, 9);
+  return check_ack_all();
+}
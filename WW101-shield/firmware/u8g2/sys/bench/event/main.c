@@ -0,0 +1,220 @@
+/*
+  Menu events from interrupts (u8x8_event.c) against polling the menu 
+  pins (u8x8_debounce.c).
+  
+  u8x8_UserInterfaceSelectionList() on a SSD1306 128x64 with I2C 
+  (400 kHz). The NEXT button is pressed 12 times (every 30 ms, 12 ms 
+  hold time, 3 bounces at each edge), then SELECT is pressed. The list 
+  must return entry 13. The redraw of the list takes longer than the 
+  time between two presses.
+  
+  Interrupts are simulated: Pin changes are delivered to 
+  u8x8_event_PushPin() with their own time stamp as soon as the simulated 
+  time (../common/u8x8_byte_sim.c) has passed them. Each read of a menu 
+  pin costs 1 us, U8X8_MSG_DELAY_EVENT sleeps until the next pin change.
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PRESS_CNT 12
+#define PRESS_START_US 200000UL
+#define PRESS_INTERVAL_US 30000UL
+#define PRESS_HOLD_US 12000UL
+#define BOUNCE_US 300UL
+#define DEBOUNCE_US 5000
+
+/* ../common/u8x8_byte_sim.c */
+struct u8x8_sim_struct
+{
+  unsigned long long now_ns;
+  unsigned long long done_ns;
+  unsigned long long wait_ns;
+  unsigned long bit_ns;
+  unsigned long transfers;
+  unsigned long bytes;
+  unsigned long submits;
+  unsigned long checksum;
+  uint8_t is_i2c;
+  uint8_t is_async;
+  uint8_t dc;
+  void *pending;
+  u8x8_t *pending_u8x8;
+};
+extern struct u8x8_sim_struct u8x8_sim;
+extern void u8x8_sim_Init(uint8_t is_i2c, unsigned long clock_khz, uint8_t is_async);
+extern void u8x8_sim_Advance(unsigned long long ns);
+extern uint8_t u8x8_byte_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+/*=========================================*/
+/* pin changes */
+
+struct edge
+{
+  unsigned long us;
+  uint8_t pin;
+  uint8_t level;
+};
+
+#define EDGE_MAX ((PRESS_CNT+1)*6)
+static struct edge edge_list[EDGE_MAX];
+static int edge_cnt;
+static int edge_delivered;
+
+static u8x8_event_queue_t queue;
+static u8x8_event_t event_list[16];
+static uint8_t is_event;
+static unsigned long long sleep_ns;
+static unsigned long pin_reads;
+
+static void add_press(uint8_t pin, unsigned long us)
+{
+  /* press and release, each with bounces */
+  static const uint8_t level_list[6] = { 0, 1, 0, 1, 0, 1 };
+  static const unsigned long offset_list[6] = { 0, BOUNCE_US, 2*BOUNCE_US, PRESS_HOLD_US, PRESS_HOLD_US+BOUNCE_US, PRESS_HOLD_US+2*BOUNCE_US };
+  int i;
+  for( i = 0; i < 6; i++ )
+  {
+    edge_list[edge_cnt].us = us + offset_list[i];
+    edge_list[edge_cnt].pin = pin;
+    edge_list[edge_cnt].level = level_list[i];
+    edge_cnt++;
+  }
+}
+
+static void edge_init(void)
+{
+  int i;
+  edge_cnt = 0;
+  edge_delivered = 0;
+  for( i = 0; i < PRESS_CNT; i++ )
+    add_press(U8X8_PIN_MENU_NEXT, PRESS_START_US + i*PRESS_INTERVAL_US);
+  add_press(U8X8_PIN_MENU_SELECT, PRESS_START_US + PRESS_CNT*PRESS_INTERVAL_US + 300000UL);
+}
+
+static unsigned long now_us(void)
+{
+  return (unsigned long)(u8x8_sim.now_ns / 1000);
+}
+
+/* pin level for polling */
+static uint8_t edge_level(uint8_t pin)
+{
+  uint8_t level = 1;
+  int i;
+  for( i = 0; i < edge_cnt && edge_list[i].us <= now_us(); i++ )
+    if ( edge_list[i].pin == pin )
+      level = edge_list[i].level;
+  return level;
+}
+
+/* GPIO interrupt */
+static void edge_deliver(void)
+{
+  if ( is_event == 0 )
+    return;
+  while( edge_delivered < edge_cnt && edge_list[edge_delivered].us <= now_us() )
+  {
+    u8x8_event_PushPin(&queue, edge_list[edge_delivered].pin, edge_list[edge_delivered].level, edge_list[edge_delivered].us);
+    edge_delivered++;
+  }
+}
+
+uint8_t u8x8_gpio_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  switch(msg)
+  {
+    case U8X8_MSG_DELAY_EVENT:
+      /* interrupts are disabled here: an event might have been pushed after u8x8_event_Pop() */
+      if ( u8x8_event_IsEmpty((u8x8_event_queue_t *)arg_ptr) == 0 )
+	break;
+      if ( edge_delivered >= edge_cnt )
+      {
+	puts("no more events, the selection list does not return");
+	exit(1);
+      }
+      /* sleep until the next interrupt */
+      sleep_ns += edge_list[edge_delivered].us*1000ULL - u8x8_sim.now_ns;
+      u8x8_sim_Advance(edge_list[edge_delivered].us*1000ULL - u8x8_sim.now_ns);
+      break;
+    case U8X8_MSG_DELAY_MILLI:
+      u8x8_sim_Advance(arg_int*1000000ULL);
+      break;
+    default:
+      if ( msg >= U8X8_MSG_GPIO(U8X8_PIN_OUTPUT_CNT) && msg < U8X8_MSG_GPIO(U8X8_PIN_OUTPUT_CNT+U8X8_PIN_INPUT_CNT) )
+      {
+	u8x8_sim_Advance(1000);
+	pin_reads++;
+	u8x8_SetGPIOResult(u8x8, edge_level(msg-U8X8_MSG_GPIO(0)));
+	if ( pin_reads > 100000000UL )
+	{
+	  puts("too many pin reads, the selection list does not return");
+	  exit(1);
+	}
+      }
+      break;
+  }
+  edge_deliver();
+  return 1;
+}
+
+uint8_t u8x8_byte_sim_irq(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t r = u8x8_byte_sim(u8x8, msg, arg_int, arg_ptr);
+  edge_deliver();
+  return r;
+}
+
+/*=========================================*/
+
+static u8x8_t u8x8;
+
+static int run(const char *name, uint8_t is_queue)
+{
+  static char sl[30*4];
+  uint8_t result;
+  int i;
+  
+  sl[0] = '\0';
+  for( i = 1; i <= 30; i++ )
+    sprintf(sl+strlen(sl), "%s%d", i > 1 ? "\n" : "", i);
+  
+  edge_init();
+  sleep_ns = 0;
+  pin_reads = 0;
+  u8x8_sim_Init(1, 400, 0);
+  u8x8_Setup(&u8x8, u8x8_d_ssd1306_128x64_noname, u8x8_cad_ssd13xx_i2c, u8x8_byte_sim_irq, u8x8_gpio_sim);
+  u8x8_InitDisplay(&u8x8);
+  u8x8_SetPowerSave(&u8x8, 0);
+  u8x8_SetFont(&u8x8, u8x8_font_5x7_f);
+  
+  is_event = is_queue;
+  if ( is_queue )
+  {
+    u8x8_event_InitQueue(&queue, event_list, 16, DEBOUNCE_US);
+    u8x8_SetEventQueue(&u8x8, &queue);
+  }
+  
+  u8x8_sim.now_ns = 0;
+  u8x8_sim.wait_ns = 0;
+  result = u8x8_UserInterfaceSelectionList(&u8x8, NULL, 0, sl);
+  
+  printf("%-24s %8u %8u %10.1f %10.1f %10lu   %s\n", name, result, PRESS_CNT+1, 
+    u8x8_sim.now_ns/1e6, (u8x8_sim.now_ns - sleep_ns)/1e6, pin_reads, 
+    result == PRESS_CNT+1 ? "ok" : "presses lost");
+  return is_queue && result != PRESS_CNT+1;
+}
+
+int main(void)
+{
+  int err = 0;
+  printf("%-24s %8s %8s %10s %10s %10s\n", "", "result", "expected", "total ms", "CPU ms", "pin reads");
+  run("polling (debounce.c)", 0);
+  err += run("event queue", 1);
+  printf("%s\n", err ? "failed" : "ok");
+  return err ? 1 : 0;
+}
@@ -0,0 +1,361 @@
+/*
+  One render object for four SSD1306 128x64 displays on the same I2C bus
+  (u8x8_fanout.c) against one u8g2 object per display.
+  
+  Displays 0 and 1 are attached at the start, display 2 with frame 5 and 
+  display 3 with frame 8. Display 1 is detached with frame 12 and attached 
+  again with frame 15. Each display has its own i2c address. The byte 
+  procedure emulates the memory of all four controllers, the memory of 
+  all attached displays must be identical to the frame after each frame.
+  
+  The bus time is simulated (../common/u8x8_byte_sim.c, 400 kHz).
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+
+#define FRAMES 20
+#define DISPLAYS 4
+
+/* ../common/u8x8_byte_sim.c */
+struct u8x8_sim_struct
+{
+  unsigned long long now_ns;
+  unsigned long long done_ns;
+  unsigned long long wait_ns;
+  unsigned long bit_ns;
+  unsigned long transfers;
+  unsigned long bytes;
+  unsigned long submits;
+  unsigned long checksum;
+  uint8_t is_i2c;
+  uint8_t is_async;
+  uint8_t dc;
+  void *pending;
+  u8x8_t *pending_u8x8;
+};
+extern struct u8x8_sim_struct u8x8_sim;
+extern void u8x8_sim_Init(uint8_t is_i2c, unsigned long clock_khz, uint8_t is_async);
+extern uint8_t u8x8_byte_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+/*=========================================*/
+/* SSD1306 memory, one emulator for each i2c address */
+
+struct emu_struct
+{
+  uint8_t ram[8][128];
+  uint8_t col, page, col_start, col_end, page_start, page_end;
+  uint8_t addr_mode;	/* 0: horizontal, 2: page */
+  uint8_t cmd, arg_list[6], arg_pos, arg_cnt;
+  uint8_t is_control, is_single, is_data;
+  uint8_t is_power_save;
+  unsigned long bytes;
+};
+
+static struct emu_struct emu_list[DISPLAYS];
+
+static void emu_init(void)
+{
+  uint8_t i;
+  memset(emu_list, 0, sizeof(emu_list));
+  for( i = 0; i < DISPLAYS; i++ )
+  {
+    /* random memory content after power on */
+    memset(emu_list[i].ram, 0x5a+i, sizeof(emu_list[i].ram));
+    emu_list[i].col_end = 127;
+    emu_list[i].page_end = 7;
+    emu_list[i].addr_mode = 2;
+    emu_list[i].is_power_save = 1;
+  }
+}
+
+static uint8_t emu_arg_cnt(uint8_t c)
+{
+  switch(c)
+  {
+    case 0x20: case 0x81: case 0x8d: case 0xa8: case 0xd3: 
+    case 0xd5: case 0xd9: case 0xda: case 0xdb:
+      return 1;
+    case 0x21: case 0x22: case 0xa3:
+      return 2;
+    case 0x29: case 0x2a:
+      return 5;
+    case 0x26: case 0x27:
+      return 6;
+  }
+  return 0;
+}
+
+static void emu_cmd(struct emu_struct *e, uint8_t c)
+{
+  if ( e->arg_pos < e->arg_cnt )
+  {
+    e->arg_list[e->arg_pos++] = c;
+    if ( e->arg_pos < e->arg_cnt )
+      return;
+    switch(e->cmd)
+    {
+      case 0x20: e->addr_mode = e->arg_list[0] & 3; break;
+      case 0x21: e->col_start = e->arg_list[0] & 127; e->col_end = e->arg_list[1] & 127; e->col = e->col_start; break;
+      case 0x22: e->page_start = e->arg_list[0] & 7; e->page_end = e->arg_list[1] & 7; e->page = e->page_start; break;
+    }
+    return;
+  }
+  e->cmd = c;
+  e->arg_pos = 0;
+  e->arg_cnt = emu_arg_cnt(c);
+  if ( c < 0x10 )
+    e->col = (e->col & 0xf0) | (c & 15);
+  else if ( c < 0x20 )
+    e->col = (e->col & 0x0f) | ((c & 7) << 4);
+  else if ( c >= 0xb0 && c <= 0xb7 )
+    e->page = c & 7;
+  else if ( c == 0xae || c == 0xaf )
+    e->is_power_save = c == 0xae ? 1 : 0;
+}
+
+static void emu_data(struct emu_struct *e, uint8_t d)
+{
+  e->ram[e->page][e->col] = d;
+  if ( e->addr_mode == 0 )
+  {
+    e->col++;
+    if ( e->col > e->col_end )
+    {
+      e->col = e->col_start;
+      e->page = e->page >= e->page_end ? e->page_start : e->page+1;
+    }
+  }
+  else
+  {
+    e->col = (e->col+1) & 127;
+  }
+}
+
+uint8_t u8x8_byte_emu(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  struct emu_struct *e = emu_list + ((u8x8_GetI2CAddress(u8x8) - 0x78)/2) % DISPLAYS;
+  uint8_t *p = (uint8_t *)arg_ptr;
+  uint8_t i;
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      e->is_control = 1;
+      break;
+    case U8X8_MSG_BYTE_SEND:
+      e->bytes += arg_int;
+      for( i = 0; i < arg_int; i++ )
+      {
+	if ( e->is_control )
+	{
+	  /* SSD13xx i2c control byte */
+	  e->is_single = (p[i] & 0x80) ? 1 : 0;
+	  e->is_data = (p[i] & 0x40) ? 1 : 0;
+	  e->is_control = 0;
+	  continue;
+	}
+	if ( e->is_data )
+	  emu_data(e, p[i]);
+	else
+	  emu_cmd(e, p[i]);
+	if ( e->is_single )
+	  e->is_control = 1;
+      }
+      break;
+  }
+  return u8x8_byte_sim(u8x8, msg, arg_int, arg_ptr);
+}
+
+uint8_t u8x8_gpio_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/*=========================================*/
+
+static u8g2_t u8g2;
+static u8g2_t u8g2_ref;
+static uint8_t ref[128*8];
+
+static u8x8_t target_u8x8[DISPLAYS];
+static u8x8_fanout_target_t target_list[DISPLAYS];
+static u8x8_fanout_t fanout;
+static uint8_t shadow[128*8];
+
+static void draw(u8g2_t *u8g2, uint8_t frame)
+{
+  /* status wall: static frame, one moving marker, one bar */
+  u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+  u8g2_DrawBox(u8g2, 4, 4, 30, 30);
+  u8g2_DrawDisc(u8g2, 50+frame*3, 44, 6, U8G2_DRAW_ALL);
+  u8g2_DrawBox(u8g2, 4, 56, 2+frame*6, 4);
+}
+
+/* frame content in the layout of the SSD1306 memory */
+static void draw_ref(uint8_t frame)
+{
+  u8x8_Setup(u8g2_GetU8x8(&u8g2_ref), u8x8_d_ssd1306_128x64_noname, u8x8_cad_001, u8x8_gpio_null, u8x8_gpio_null);
+  u8g2_SetupBuffer(&u8g2_ref, ref, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+  u8g2_ClearBuffer(&u8g2_ref);
+  draw(&u8g2_ref, frame);
+}
+
+/* 1: display i is attached with this frame, 2: display i is detached */
+static uint8_t attach_event(uint8_t i, uint8_t frame)
+{
+  if ( frame == 0 && i < 2 )
+    return 1;
+  if ( frame == 5 && i == 2 )
+    return 1;
+  if ( frame == 8 && i == 3 )
+    return 1;
+  if ( frame == 12 && i == 1 )
+    return 2;
+  if ( frame == 15 && i == 1 )
+    return 1;
+  return 0;
+}
+
+static int check(uint8_t *is_attached, uint8_t frame)
+{
+  uint8_t i;
+  int err = 0;
+  for( i = 0; i < DISPLAYS; i++ )
+  {
+    if ( is_attached[i] == 0 )
+      continue;
+    if ( memcmp(emu_list[i].ram, ref, sizeof(ref)) != 0 )
+    {
+      printf("frame %u: memory of display %u differs\n", frame, i);
+      err = 1;
+    }
+    if ( emu_list[i].is_power_save )
+    {
+      printf("frame %u: display %u is in power save mode\n", frame, i);
+      err = 1;
+    }
+  }
+  return err;
+}
+
+static void print_result(const char *name, unsigned long renders, unsigned long long t, int err)
+{
+  unsigned long bytes = 0;
+  uint8_t i;
+  printf("%-30s %8lu %10.2f", name, renders, t/1e6);
+  for( i = 0; i < DISPLAYS; i++ )
+  {
+    printf(" %8lu", emu_list[i].bytes);
+    bytes += emu_list[i].bytes;
+  }
+  printf(" %9lu   %s\n", bytes, err ? "failed" : "ok");
+}
+
+/* one u8g2 object (and render pass) for each display */
+static int run_separate(void)
+{
+  uint8_t is_attached[DISPLAYS] = { 0 };
+  unsigned long renders = 0;
+  uint8_t frame, i, ev;
+  int err = 0;
+  
+  emu_init();
+  u8x8_sim_Init(1, 400, 0);
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    draw_ref(frame);
+    for( i = 0; i < DISPLAYS; i++ )
+    {
+      u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_emu, u8x8_gpio_null);
+      u8x8_SetI2CAddress(u8g2_GetU8x8(&u8g2), 0x78+2*i);
+      ev = attach_event(i, frame);
+      if ( ev == 1 )
+      {
+	u8g2_InitDisplay(&u8g2);
+	u8g2_SetPowerSave(&u8g2, 0);
+      }
+      if ( ev != 0 )
+	is_attached[i] = ev == 1 ? 1 : 0;
+      if ( is_attached[i] == 0 )
+	continue;
+      u8g2_ClearBuffer(&u8g2);
+      draw(&u8g2, frame);
+      u8g2_SendBuffer(&u8g2);
+      renders++;
+    }
+    err |= check(is_attached, frame);
+  }
+  print_result("one u8g2 object per display", renders, u8x8_sim.now_ns, err);
+  return err;
+}
+
+static int run_fanout(const char *name, uint8_t is_shadow, uint8_t is_page_buffer)
+{
+  uint8_t is_attached[DISPLAYS] = { 0 };
+  unsigned long renders = 0;
+  uint8_t frame, i, ev;
+  int err = 0;
+  
+  emu_init();
+  u8x8_sim_Init(1, 400, 0);
+  for( i = 0; i < DISPLAYS; i++ )
+  {
+    u8x8_Setup(target_u8x8+i, u8x8_d_ssd1306_128x64_noname, u8x8_cad_ssd13xx_i2c, u8x8_byte_emu, u8x8_gpio_null);
+    u8x8_SetI2CAddress(target_u8x8+i, 0x78+2*i);
+    target_list[i].u8x8 = target_u8x8+i;
+  }
+  
+  if ( is_page_buffer )
+    u8g2_Setup_ssd1306_i2c_128x64_noname_2(&u8g2, U8G2_R0, u8x8_byte_emu, u8x8_gpio_null);
+  else
+    u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_emu, u8x8_gpio_null);
+  u8x8_SetFanout(u8g2_GetU8x8(&u8g2), &fanout, target_list, DISPLAYS, is_shadow ? shadow : NULL);
+  
+  /* nothing is attached: only the state of the render object is set */
+  u8g2_InitDisplay(&u8g2);
+  u8x8_ClearDisplay(u8g2_GetU8x8(&u8g2));
+  u8g2_SetPowerSave(&u8g2, 0);
+  
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    draw_ref(frame);
+    for( i = 0; i < DISPLAYS; i++ )
+    {
+      ev = attach_event(i, frame);
+      if ( ev == 1 )
+	u8x8_AttachFanoutTarget(u8g2_GetU8x8(&u8g2), i);
+      else if ( ev == 2 )
+	u8x8_DetachFanoutTarget(u8g2_GetU8x8(&u8g2), i);
+      if ( ev != 0 )
+	is_attached[i] = ev == 1 ? 1 : 0;
+    }
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      draw(&u8g2, frame);
+    } while( u8g2_NextPage(&u8g2) );
+    renders++;
+    err |= check(is_attached, frame);
+  }
+  print_result(name, renders, u8x8_sim.now_ns, err);
+  return err;
+}
+
+int main(void)
+{
+  int err = 0;
+  uint8_t i;
+  printf("%-30s %8s %10s", "", "renders", "bus ms");
+  for( i = 0; i < DISPLAYS; i++ )
+    printf("   disp %u", i);
+  printf(" %9s\n", "bytes");
+  err += run_separate();
+  err += run_fanout("fan-out, no shadow", 0, 0);
+  err += run_fanout("fan-out, shadow", 1, 0);
+  err += run_fanout("fan-out, shadow, 2 row pages", 1, 1);
+  printf("%s\n", err ? "failed" : "ok");
+  return err ? 1 : 0;
+}
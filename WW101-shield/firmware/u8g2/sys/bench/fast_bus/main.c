@@ -0,0 +1,123 @@
+/*
+  Software I2C and SPI: gpio messages (u8x8_byte_sw_i2c, u8x8_byte_4wire_sw_spi)
+  against direct port access (u8x8_byte_fast_sw_i2c, u8x8_byte_fast_4wire_sw_spi).
+  
+  The lines are recorded by the logic trace simulator (../common/u8x8_logic_sim.c),
+  the trace is decoded and the timing is checked against the I2C specification 
+  or the SPI timing of the display.
+  
+  Cost model (about 100 MHz Cortex-M): 25ns per port access, 12ns per delay 
+  loop, 200ns per call of the gpio_and_delay_cb. The delays of the gpio 
+  messages are taken from the Arduino procedure.
+  
+  Build and run: make test
+*/
+
+#include "u8x8.h"
+#include <stdio.h>
+
+#define EXPECTED_MAX 4000
+
+static u8x8_t u8x8;
+static u8x8_display_info_t info;
+static u8x8_fast_bus_t bus;
+static u8x8_msg_cb byte_cb;
+static uint16_t expected[EXPECTED_MAX];
+static unsigned long expected_cnt;
+static uint8_t is_expected;
+static uint8_t expected_dc;
+
+/* record the bytes which should appear on the bus */
+uint8_t u8x8_byte_expect(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *p = (uint8_t *)arg_ptr;
+  uint8_t cnt = arg_int;
+  if ( is_expected )
+  {
+    switch(msg)
+    {
+      case U8X8_MSG_BYTE_START_TRANSFER:
+	if ( byte_cb == u8x8_byte_sw_i2c || byte_cb == u8x8_byte_fast_sw_i2c )
+	  expected[expected_cnt++] = u8x8_GetI2CAddress(u8x8);
+	break;
+      case U8X8_MSG_BYTE_SET_DC:
+	expected_dc = arg_int;
+	break;
+      case U8X8_MSG_BYTE_SEND:
+	for( ; cnt > 0 && expected_cnt < EXPECTED_MAX; cnt-- )
+	  expected[expected_cnt++] = *p++ | (expected_dc ? 256 : 0);
+	break;
+    }
+  }
+  return byte_cb(u8x8, msg, arg_int, arg_ptr);
+}
+
+static int run(const char *name, u8x8_msg_cb cad, u8x8_msg_cb byte, uint8_t i2c_clock)
+{
+  static uint8_t tile[8] = { 0x81, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x81 };
+  struct u8x8_logic_result r;
+  uint32_t t;
+  uint8_t x, y;
+  uint8_t is_i2c = (byte == u8x8_byte_sw_i2c || byte == u8x8_byte_fast_sw_i2c);
+  
+  byte_cb = byte;
+  u8x8_logic_port = U8X8_LOGIC_CLOCK|U8X8_LOGIC_DATA|U8X8_LOGIC_CS;
+  u8x8_Setup(&u8x8, u8x8_d_ssd1306_128x64_noname, cad, u8x8_byte_expect, u8x8_gpio_and_delay_logic);
+  info = *u8x8.display_info;
+  info.i2c_bus_clock_100kHz = i2c_clock;
+  u8x8.display_info = &info;
+  /* u8x8_SetFastBus() checks the byte procedure */
+  u8x8.byte_cb = byte;
+  u8x8_SetFastBus(&u8x8, &bus);
+  u8x8.byte_cb = u8x8_byte_expect;
+  u8x8_InitDisplay(&u8x8);
+  u8x8_SetPowerSave(&u8x8, 0);
+  
+  /* record and check one full screen */
+  u8x8_logic_Reset();
+  expected_cnt = 0;
+  is_expected = 1;
+  t = u8x8_logic_GetMicros();
+  for( y = 0; y < 8; y++ )
+    for( x = 0; x < 16; x += 4 )
+    {
+      u8x8_DrawTile(&u8x8, x, y, 1, tile);
+      u8x8_DrawTile(&u8x8, x+1, y, 1, tile);
+      u8x8_DrawTile(&u8x8, x+2, y, 1, tile);
+      u8x8_DrawTile(&u8x8, x+3, y, 1, tile);
+    }
+  t = u8x8_logic_GetMicros() - t;
+  is_expected = 0;
+  
+  if ( is_i2c )
+    u8x8_logic_CheckI2C(&r, expected, expected_cnt, i2c_clock*100);
+  else
+    u8x8_logic_CheckSPI(&r, expected, expected_cnt, u8x8_GetSPIClockPhase(&u8x8), 
+      info.sda_setup_time_ns > info.sck_pulse_width_ns ? info.sda_setup_time_ns : info.sck_pulse_width_ns, info.sck_pulse_width_ns);
+  printf("%-22s %8.2f %9.1f %7lu   %s\n", name, t/1000.0, r.khz, r.bytes, r.errors ? r.first_error : "ok");
+  return r.errors ? 1 : 0;
+}
+
+int main(void)
+{
+  int err = 0;
+  
+  u8x8_logic_port = U8X8_LOGIC_CLOCK|U8X8_LOGIC_DATA|U8X8_LOGIC_CS;
+  bus.clock_port = &u8x8_logic_port;
+  bus.clock_mask = U8X8_LOGIC_CLOCK;
+  bus.data_port = &u8x8_logic_port;
+  bus.data_mask = U8X8_LOGIC_DATA;
+  u8x8_CalibrateFastBus(&bus, u8x8_logic_GetMicros);
+  printf("calibration: %lu ps per delay loop, %u ns per port access\n", (unsigned long)bus.loop_ps, bus.port_ns);
+  
+  printf("%-22s %8s %9s %7s   %s\n", "", "ms", "bus kHz", "bytes", "trace");
+  err += run("i2c 400kHz gpio msg", u8x8_cad_ssd13xx_i2c, u8x8_byte_sw_i2c, 4);
+  err += run("i2c 400kHz fast", u8x8_cad_ssd13xx_i2c, u8x8_byte_fast_sw_i2c, 4);
+  err += run("i2c 100kHz gpio msg", u8x8_cad_ssd13xx_i2c, u8x8_byte_sw_i2c, 1);
+  err += run("i2c 100kHz fast", u8x8_cad_ssd13xx_i2c, u8x8_byte_fast_sw_i2c, 1);
+  err += run("i2c 1MHz fast", u8x8_cad_ssd13xx_i2c, u8x8_byte_fast_sw_i2c, 10);
+  err += run("spi gpio msg", u8x8_cad_001, u8x8_byte_4wire_sw_spi, 4);
+  err += run("spi fast", u8x8_cad_001, u8x8_byte_fast_4wire_sw_spi, 4);
+  printf("%s\n", err ? "failed" : "ok");
+  return err ? 1 : 0;
+}
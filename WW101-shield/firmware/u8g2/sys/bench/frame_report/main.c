@@ -0,0 +1,93 @@
+/*
+  Bus time report for a SSD1306 128x64 with I2C (400 kHz) and 
+  4-wire SPI (max. clock of the display).
+  
+  The trace of all byte messages is written to the file given as 
+  argument. "make test" compares it with golden.trace, "make golden" 
+  updates golden.trace after an intended change of the transfer.
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+
+/* ../common/u8x8_byte_sim.c */
+extern void u8x8_sim_Init(uint8_t is_i2c, unsigned long clock_khz, uint8_t is_async);
+extern int u8x8_sim_SetTrace(const char *filename);
+extern void u8x8_sim_PrintHeader(void);
+extern void u8x8_sim_BeginFrame(const char *name);
+extern uint32_t u8x8_sim_EndFrame(void);
+extern void u8x8_sim_PrintTotal(void);
+extern uint8_t u8x8_byte_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+u8g2_t u8g2;
+
+uint8_t u8x8_gpio_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static void draw(uint8_t frame)
+{
+  u8g2_DrawFrame(&u8g2, 0, 0, 128, 64);
+  u8g2_DrawDisc(&u8g2, 20+frame*8, 32, 12, U8G2_DRAW_ALL);
+  u8g2_DrawBox(&u8g2, 70, 8+frame*4, 40, 16);
+}
+
+static void frames(void)
+{
+  uint8_t frame;
+  
+  u8x8_sim_BeginFrame("init");
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  u8x8_sim_EndFrame();
+  
+  u8x8_sim_BeginFrame("clear display");
+  u8g2_ClearDisplay(&u8g2);
+  u8x8_sim_EndFrame();
+  
+  for( frame = 0; frame < 2; frame++ )
+  {
+    u8x8_sim_BeginFrame(frame == 0 ? "full buffer 0" : "full buffer 1");
+    u8g2_ClearBuffer(&u8g2);
+    draw(frame);
+    u8g2_SendBuffer(&u8g2);
+    u8x8_sim_EndFrame();
+  }
+  
+  u8x8_sim_BeginFrame("u8x8 text line");
+  u8x8_SetFont(u8g2_GetU8x8(&u8g2), u8x8_font_5x7_f);
+  u8x8_DrawString(u8g2_GetU8x8(&u8g2), 0, 7, "Bus time");
+  u8x8_sim_EndFrame();
+  
+  u8x8_sim_BeginFrame("contrast");
+  u8g2_SetContrast(&u8g2, 128);
+  u8x8_sim_EndFrame();
+  
+  u8x8_sim_PrintTotal();
+}
+
+int main(int argc, char **argv)
+{
+  if ( argc > 1 && u8x8_sim_SetTrace(argv[1]) == 0 )
+  {
+    perror(argv[1]);
+    return 1;
+  }
+  
+  u8x8_sim_PrintHeader();
+  
+  printf("I2C 400 kHz\n");
+  u8x8_sim_Init(1, 400, 0);
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_sim, u8x8_gpio_null);
+  u8x8_SetI2CAddress(u8g2_GetU8x8(&u8g2), 0x78);
+  frames();
+  
+  printf("SPI, clock of the display\n");
+  u8x8_sim_Init(0, 0, 0);
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_sim, u8x8_gpio_null);
+  frames();
+  
+  u8x8_sim_SetTrace(NULL);
+  return 0;
+}
@@ -0,0 +1,204 @@
+/*
+  Frame rate limit, dimming and power save (u8x8_governor.c) for a 
+  SSD1306 128x64 with I2C (400 kHz) on the shield.
+  
+  10 minutes are simulated in steps of 1 ms:
+  - new sensor values every 100 ms, each one requests a redraw
+  - button presses at 5 s, 40 s, 200 s and 320 s
+  - the proximity sensor (BVAL_PROX_MASK of the button register) detects 
+    somebody from 0 to 90 s and from 300 to 360 s, it is polled every 50 ms
+  
+  Power model (rough values for a 0.96" SSD1306 module at 3.3 V):
+  - display on: 0.3 mA + 20 mA * (lit pixels / all pixels) * (contrast+1)/256
+  - power save: 0.01 mA
+  - I2C transfer: 8 mA for the CPU while the bus is busy (../common/u8x8_byte_sim.c)
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SIM_MS (10UL*60UL*1000UL)
+#define VOLTAGE 3.3
+
+/* same value as in I2CRegMap/regmap.h (requires the PSoC project.h) */
+#define BVAL_PROX_MASK (0x40)
+
+/* ../common/u8x8_byte_sim.c */
+struct u8x8_sim_struct
+{
+  unsigned long long now_ns;
+  unsigned long long done_ns;
+  unsigned long long wait_ns;
+  unsigned long bit_ns;
+  unsigned long transfers;
+  unsigned long bytes;
+  unsigned long submits;
+  unsigned long checksum;
+  uint8_t is_i2c;
+  uint8_t is_async;
+  uint8_t dc;
+  void *pending;
+  u8x8_t *pending_u8x8;
+};
+extern struct u8x8_sim_struct u8x8_sim;
+extern void u8x8_sim_Init(uint8_t is_i2c, unsigned long clock_khz, uint8_t is_async);
+extern uint8_t u8x8_byte_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+uint8_t u8x8_gpio_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/*=========================================*/
+/* display model: contrast and power save as seen by the controller */
+
+static uint8_t model_contrast;
+static uint8_t model_power_save;
+static unsigned long model_lit;		/* lit pixels of the last frame */
+
+uint8_t u8x8_d_model(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  if ( msg == U8X8_MSG_DISPLAY_SET_CONTRAST )
+    model_contrast = arg_int;
+  else if ( msg == U8X8_MSG_DISPLAY_SET_POWER_SAVE )
+    model_power_save = arg_int;
+  return u8x8_d_ssd1306_128x64_noname(u8x8, msg, arg_int, arg_ptr);
+}
+
+static double model_display_ma(void)
+{
+  if ( model_power_save )
+    return 0.01;
+  return 0.3 + 20.0 * model_lit / (128.0*64.0) * (model_contrast+1) / 256.0;
+}
+
+/*=========================================*/
+/* shield: sensor values, buttons, proximity */
+
+static uint8_t shield_button_val(unsigned long ms)
+{
+  if ( ms < 90000UL || (ms >= 300000UL && ms < 360000UL) )
+    return BVAL_PROX_MASK;
+  return 0;
+}
+
+static uint8_t is_button_press(unsigned long ms)
+{
+  return ms == 5000UL || ms == 40000UL || ms == 200000UL || ms == 320000UL;
+}
+
+/*=========================================*/
+
+static u8g2_t u8g2;
+static u8x8_governor_t governor;
+
+static void draw(unsigned long ms)
+{
+  /* status page: frame, three bar graphs with the sensor values */
+  u8g2_DrawFrame(&u8g2, 0, 0, 128, 64);
+  u8g2_DrawBox(&u8g2, 4, 8, 10+(ms/100)%100, 8);
+  u8g2_DrawBox(&u8g2, 4, 28, 40+(ms/700)%60, 8);
+  u8g2_DrawBox(&u8g2, 4, 48, 20+(ms/1300)%80, 8);
+}
+
+static unsigned long count_lit(void)
+{
+  uint8_t *p = u8g2_GetBufferPtr(&u8g2);
+  unsigned long cnt = 0;
+  uint16_t i;
+  uint8_t b;
+  for( i = 0; i < 128*8; i++ )
+    for( b = p[i]; b != 0; b &= b-1 )
+      cnt++;
+  return cnt;
+}
+
+static int run(const char *name, uint32_t min_frame_ms, uint32_t dim_ms, uint32_t power_save_ms)
+{
+  unsigned long ms, last_frame_ms = 0;
+  double display_mj = 0.0, bus_mj, on_s = 0.0;
+  int err = 0;
+  
+  u8x8_sim_Init(1, 400, 0);
+  u8g2_Setup_ssd1306_i2c_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_sim, u8x8_gpio_null);
+  u8g2_GetU8x8(&u8g2)->display_cb = u8x8_d_model;
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  model_lit = 0;
+  
+  u8x8_SetGovernor(u8g2_GetU8x8(&u8g2), &governor, min_frame_ms, dim_ms, power_save_ms, 0);
+  u8x8_SetGovernorContrast(u8g2_GetU8x8(&u8g2), 255, 16);
+  u8x8_sim.now_ns = 0;
+  
+  for( ms = 0; ms < SIM_MS; ms++ )
+  {
+    if ( ms % 100 == 0 )
+      u8x8_RequestRedraw(u8g2_GetU8x8(&u8g2));
+    if ( is_button_press(ms) )
+    {
+      u8x8_NotifyActivity(u8g2_GetU8x8(&u8g2), ms);
+      u8x8_RequestRedraw(u8g2_GetU8x8(&u8g2));
+      if ( model_power_save || model_contrast != 255 )
+      {
+	printf("%lu ms: display not active after button press\n", ms);
+	err = 1;
+      }
+    }
+    if ( ms % 50 == 0 )
+      u8x8_SetPresence(u8g2_GetU8x8(&u8g2), (shield_button_val(ms) & BVAL_PROX_MASK) != 0, ms);
+    
+    if ( u8x8_PollGovernor(u8g2_GetU8x8(&u8g2), ms) )
+    {
+      if ( model_power_save )
+      {
+	printf("%lu ms: frame in power save mode\n", ms);
+	err = 1;
+      }
+      if ( governor.frame_cnt > 1 && ms - last_frame_ms < min_frame_ms )
+      {
+	printf("%lu ms: frame rate limit exceeded\n", ms);
+	err = 1;
+      }
+      last_frame_ms = ms;
+      u8g2_ClearBuffer(&u8g2);
+      draw(ms);
+      u8g2_SendBuffer(&u8g2);
+      model_lit = count_lit();
+    }
+    
+    display_mj += model_display_ma() * VOLTAGE * 1e-3;
+    if ( model_power_save == 0 )
+      on_s += 1e-3;
+  }
+  
+  /* somebody is back after 360 s: the display must be off at the end */
+  if ( power_save_ms != 0 && model_power_save == 0 )
+  {
+    printf("display is still on\n");
+    err = 1;
+  }
+  
+  bus_mj = u8x8_sim.now_ns * 1e-9 * 8.0 * VOLTAGE;
+  printf("%-32s %7lu %7lu %6.0f %9.1f %9.1f %9.3f %9.1f   %s\n", name, 
+    (unsigned long)governor.request_cnt, (unsigned long)governor.frame_cnt, on_s, 
+    display_mj, bus_mj, (display_mj + bus_mj) / (SIM_MS * 1e-3) / VOLTAGE,
+    governor.frame_cnt ? bus_mj * 1e3 / governor.frame_cnt : 0.0,
+    err ? "failed" : "ok");
+  return err;
+}
+
+int main(void)
+{
+  int err = 0;
+  printf("%-32s %7s %7s %6s %9s %9s %9s %9s\n", "", "request", "frames", "on s", "disp. mJ", "bus mJ", "avg mA", "uJ/frame");
+  err += run("redraw on every update", 0, 0, 0);
+  err += run("max. 4 frames/s", 250, 0, 0);
+  err += run("4 frames/s, dim after 20 s", 250, 20000, 0);
+  err += run("4 frames/s, dim, off after 30 s", 250, 20000, 30000);
+  err += run("4 frames/s, dim, off after 2 min", 250, 20000, 120000UL);
+  printf("%s\n", err ? "failed" : "ok");
+  return err ? 1 : 0;
+}
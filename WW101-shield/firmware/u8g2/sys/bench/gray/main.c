@@ -0,0 +1,129 @@
+/*
+  Render and transfer time of the 1 bit buffer and the 4 bit gray buffer
+  (u8g2_ll_hvline_horizontal_gray4) for the SSD1322 and SSD1327.
+  
+  With the 1 bit buffer, the display procedure expands each tile to 
+  32 bytes during the transfer. The gray buffer is sent without any
+  conversion, but the buffer is 4 times larger.
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <time.h>
+
+#define FRAMES 500
+
+static unsigned long bus_bytes;
+
+/* the display is not connected: count the bytes */
+uint8_t u8x8_byte_count(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  if ( msg == U8X8_MSG_BYTE_SEND )
+    bus_bytes += arg_int;
+  return 1;
+}
+
+void draw(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t w = u8g2_GetDisplayWidth(u8g2);
+  u8g2_uint_t h = u8g2_GetDisplayHeight(u8g2);
+  u8g2_uint_t i;
+  
+  /* gray scale bars, the 1 bit buffer will show one box */
+  for( i = 0; i < 16; i++ )
+  {
+    u8g2_SetGrayLevel(u8g2, i);
+    u8g2_DrawBox(u8g2, i*(w/16), 0, w/16, h/4);
+  }
+  u8g2_SetGrayLevel(u8g2, 15);
+  u8g2_DrawFrame(u8g2, 0, h/4, w, h-h/4);
+  
+  /* chart with a dimmed grid */
+  u8g2_SetGrayLevel(u8g2, 3);
+  for( i = 8; i < w; i += 8 )
+    u8g2_DrawVLine(u8g2, i, h/4+1, h-h/4-2);
+  u8g2_SetGrayLevel(u8g2, 15);
+  for( i = 1; i < w-1; i++ )
+    u8g2_DrawPixel(u8g2, i, h/2 + ((i*7+frame) % (h/2)) / 2);
+  
+  u8g2_SetGrayLevel(u8g2, 8);
+  u8g2_DrawDisc(u8g2, w/2, h*5/8, h/4, U8G2_DRAW_ALL);
+  u8g2_SetGrayLevel(u8g2, 15);
+  u8g2_SetDrawColor(u8g2, 2);
+  u8g2_DrawBox(u8g2, frame % (w-20), h/2, 20, 10);
+  u8g2_SetDrawColor(u8g2, 1);
+}
+
+void bench_full(u8g2_t *u8g2, const char *name)
+{
+  clock_t t, render, transfer;
+  uint16_t frame;
+  
+  render = 0;
+  transfer = 0;
+  bus_bytes = 0;
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    t = clock();
+    u8g2_ClearBuffer(u8g2);
+    draw(u8g2, frame);
+    render += clock() - t;
+    t = clock();
+    u8g2_SendBuffer(u8g2);
+    transfer += clock() - t;
+  }
+  printf("%-26s %5u bytes buffer  render %7.1f us  transfer %7.1f us  %6lu bytes/frame\n", name, 
+    u8g2_GetBufferTileWidth(u8g2)*u8g2_GetBufferTileHeight(u8g2)*u8g2_GetBufferTileSize(u8g2),
+    (double)render*1000000.0/CLOCKS_PER_SEC/FRAMES, 
+    (double)transfer*1000000.0/CLOCKS_PER_SEC/FRAMES, 
+    bus_bytes/FRAMES);
+}
+
+void bench_page(u8g2_t *u8g2, const char *name)
+{
+  clock_t t;
+  uint16_t frame;
+  
+  bus_bytes = 0;
+  t = clock();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_FirstPage(u8g2);
+    do
+    {
+      draw(u8g2, frame);
+    } while( u8g2_NextPage(u8g2) );
+  }
+  t = clock() - t;
+  printf("%-26s %5u bytes buffer  render+transfer %7.1f us          %6lu bytes/frame\n", name, 
+    u8g2_GetBufferTileWidth(u8g2)*u8g2_GetBufferTileHeight(u8g2)*u8g2_GetBufferTileSize(u8g2),
+    (double)t*1000000.0/CLOCKS_PER_SEC/FRAMES, 
+    bus_bytes/FRAMES);
+}
+
+int main(void)
+{
+  u8g2_t u8g2;
+  
+  u8g2_Setup_ssd1322_nhd_256x64_f(&u8g2, U8G2_R0, u8x8_byte_count, u8x8_byte_count);
+  bench_full(&u8g2, "ssd1322 256x64 full");
+  u8g2_Setup_ssd1322_nhd_256x64_gray_f(&u8g2, U8G2_R0, u8x8_byte_count, u8x8_byte_count);
+  bench_full(&u8g2, "ssd1322 256x64 gray full");
+  u8g2_Setup_ssd1322_nhd_256x64_1(&u8g2, U8G2_R0, u8x8_byte_count, u8x8_byte_count);
+  bench_page(&u8g2, "ssd1322 256x64 page");
+  u8g2_Setup_ssd1322_nhd_256x64_gray_1(&u8g2, U8G2_R0, u8x8_byte_count, u8x8_byte_count);
+  bench_page(&u8g2, "ssd1322 256x64 gray page");
+
+  u8g2_Setup_ssd1327_seeed_96x96_f(&u8g2, U8G2_R0, u8x8_byte_count, u8x8_byte_count);
+  bench_full(&u8g2, "ssd1327 96x96 full");
+  u8g2_Setup_ssd1327_seeed_96x96_gray_f(&u8g2, U8G2_R0, u8x8_byte_count, u8x8_byte_count);
+  bench_full(&u8g2, "ssd1327 96x96 gray full");
+  u8g2_Setup_ssd1327_seeed_96x96_1(&u8g2, U8G2_R0, u8x8_byte_count, u8x8_byte_count);
+  bench_page(&u8g2, "ssd1327 96x96 page");
+  u8g2_Setup_ssd1327_seeed_96x96_gray_1(&u8g2, U8G2_R0, u8x8_byte_count, u8x8_byte_count);
+  bench_page(&u8g2, "ssd1327 96x96 gray page");
+  
+  return 0;
+}
@@ -0,0 +1,104 @@
+/*
+  Frames per second for displays with horizontal byte order
+  (u8g2_ll_hvline_horizontal_right_lsb: ST7920, LS013B7DH03, T6963).
+  The SSD1306 (u8g2_ll_hvline_vertical_top_lsb) is shown for comparison.
+  
+  The display is not connected, so this is the CPU time for rendering
+  and for the transfer procedures of u8x8.
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <time.h>
+
+#define FRAMES 500
+
+/* ../common/u8x8_byte_null.c */
+extern uint8_t u8x8_byte_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+void draw(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t w = u8g2_GetDisplayWidth(u8g2);
+  u8g2_uint_t h = u8g2_GetDisplayHeight(u8g2);
+  u8g2_uint_t i;
+  
+  /* typical menu: frame, title bar, selected line with XOR */
+  u8g2_DrawFrame(u8g2, 0, 0, w, h);
+  u8g2_DrawBox(u8g2, 0, 0, w, 12);
+  for( i = 16; i+8 < h; i += 10 )
+    u8g2_DrawHLine(u8g2, 4 + (i & 3), i, w-12);
+  u8g2_SetDrawColor(u8g2, 2);
+  u8g2_DrawBox(u8g2, 2, 14 + (frame % 4)*10, w-4, 10);
+  u8g2_SetDrawColor(u8g2, 1);
+  /* bar graph */
+  for( i = 0; i < 8; i++ )
+    u8g2_DrawBox(u8g2, w/2 + i*6, h - 4 - ((frame + i*5) % (h/2)), 5, (frame + i*5) % (h/2));
+  u8g2_DrawDisc(u8g2, w/4, h*2/3, h/6, U8G2_DRAW_ALL);
+}
+
+uint16_t checksum(u8g2_t *u8g2)
+{
+  uint8_t *ptr = u8g2_GetBufferPtr(u8g2);
+  uint16_t cnt = u8g2_GetBufferTileWidth(u8g2)*8*u8g2_GetBufferTileHeight(u8g2);
+  uint16_t sum = 0;
+  while( cnt > 0 )
+  {
+    sum = (sum << 1) + (sum >> 15) + *ptr++;
+    cnt--;
+  }
+  return sum;
+}
+
+void bench(u8g2_t *u8g2, const char *name)
+{
+  clock_t t;
+  uint16_t frame;
+  uint16_t sum = 0;
+  
+  t = clock();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_FirstPage(u8g2);
+    do
+    {
+      draw(u8g2, frame);
+    } while( u8g2_NextPage(u8g2) );
+    sum += checksum(u8g2);
+  }
+  t = clock() - t;
+  printf("%-26s %3dx%-3d %8.1f us/frame %8.0f frames/s  checksum %04x\n", name, 
+    u8g2_GetDisplayWidth(u8g2), u8g2_GetDisplayHeight(u8g2), 
+    (double)t*1000000.0/CLOCKS_PER_SEC/FRAMES, 
+    (double)FRAMES*CLOCKS_PER_SEC/(t ? t : 1), sum);
+}
+
+int main(void)
+{
+  u8g2_t u8g2;
+  
+  u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "ssd1306 page");
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "ssd1306 full");
+  
+  u8g2_Setup_st7920_s_128x64_1(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "st7920 page");
+  u8g2_Setup_st7920_s_128x64_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "st7920 full");
+  u8g2_Setup_st7920_s_128x64_f(&u8g2, U8G2_R1, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "st7920 full R1");
+  
+  u8g2_Setup_ls013b7dh03_128x128_1(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "ls013b7dh03 page");
+  u8g2_Setup_ls013b7dh03_128x128_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "ls013b7dh03 full");
+  
+  u8g2_Setup_t6963_240x128_1(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "t6963 page");
+  u8g2_Setup_t6963_240x128_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "t6963 full");
+  
+  return 0;
+}
@@ -0,0 +1,228 @@
+/*
+  i2c transfers of u8x8_cad_ssd13xx_i2c: one transfer per command byte 
+  and 24 byte data chunks (previous version, copied below) against 
+  commands and data combined into one transfer.
+  
+  The byte procedure counts transfers and bytes on the wire (including
+  the address byte) and decodes the SSD13xx control bytes. Both versions
+  must send the same sequence of command and data bytes to the controller.
+  
+  time@400kHz: 9 bit per byte, 2 bit for start and stop condition.
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_MAX 200000
+
+struct stat
+{
+  unsigned long transfers;
+  unsigned long bytes;		/* including address byte */
+  unsigned long max_transfer;	/* largest transfer, without address */
+};
+
+static struct stat stat;
+static unsigned long transfer_bytes;
+
+/* decoded bytes: bit 8 is set for data bytes */
+static uint16_t log_list[LOG_MAX];
+static unsigned long log_cnt;
+static int is_log_overflow;
+
+static uint8_t is_control;	/* next byte is a control byte */
+static uint8_t is_single;	/* Co was 1: only one byte follows */
+static uint8_t is_data;		/* D/C of the last control byte */
+
+static void log_byte(uint16_t v)
+{
+  if ( log_cnt < LOG_MAX )
+    log_list[log_cnt++] = v;
+  else
+    is_log_overflow = 1;
+}
+
+uint8_t u8x8_byte_count(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *p = (uint8_t *)arg_ptr;
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      stat.transfers++;
+      stat.bytes++;		/* address */
+      transfer_bytes = 0;
+      is_control = 1;
+      break;
+    case U8X8_MSG_BYTE_SEND:
+      stat.bytes += arg_int;
+      transfer_bytes += arg_int;
+      while( arg_int > 0 )
+      {
+	if ( is_control )
+	{
+	  is_single = (*p & 0x80) ? 1 : 0;
+	  is_data = (*p & 0x40) ? 1 : 0;
+	  is_control = 0;
+	}
+	else
+	{
+	  log_byte(*p | (is_data ? 0x100 : 0));
+	  if ( is_single )
+	    is_control = 1;
+	}
+	p++;
+	arg_int--;
+      }
+      break;
+    case U8X8_MSG_BYTE_END_TRANSFER:
+      if ( stat.max_transfer < transfer_bytes )
+	stat.max_transfer = transfer_bytes;
+      break;
+  }
+  return 1;
+}
+
+uint8_t u8x8_gpio_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/* previous version of u8x8_cad_ssd13xx_i2c */
+static void legacy_data_transfer(u8x8_t *u8x8, uint8_t arg_int, void *arg_ptr)
+{
+    u8x8_byte_StartTransfer(u8x8);    
+    u8x8_byte_SendByte(u8x8, 0x040);
+    u8x8->byte_cb(u8x8, U8X8_MSG_CAD_SEND_DATA, arg_int, arg_ptr);
+    u8x8_byte_EndTransfer(u8x8);
+}
+
+uint8_t u8x8_cad_legacy_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *p;
+  switch(msg)
+  {
+    case U8X8_MSG_CAD_SEND_CMD:
+    case U8X8_MSG_CAD_SEND_ARG:
+      u8x8_byte_StartTransfer(u8x8);
+      u8x8_byte_SendByte(u8x8, 0x000);
+      u8x8_byte_SendByte(u8x8, arg_int);
+      u8x8_byte_EndTransfer(u8x8);      
+      break;
+    case U8X8_MSG_CAD_SEND_DATA:
+      p = arg_ptr;
+      while( arg_int > 24 )
+      {
+	legacy_data_transfer(u8x8, 24, p);
+	arg_int-=24;
+	p+=24;
+      }
+      legacy_data_transfer(u8x8, arg_int, p);
+      break;
+    case U8X8_MSG_CAD_INIT:
+      if ( u8x8->i2c_address == 255 )
+	u8x8->i2c_address = 0x078;
+      return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
+    case U8X8_MSG_CAD_START_TRANSFER:
+    case U8X8_MSG_CAD_END_TRANSFER:
+      break;
+    default:
+      return 0;
+  }
+  return 1;
+}
+
+static u8g2_t u8g2;
+static uint8_t buf[128*8];
+
+static void draw(uint8_t frame)
+{
+  u8g2_ClearBuffer(&u8g2);
+  u8g2_DrawFrame(&u8g2, 0, 0, 128, 64);
+  u8g2_DrawDisc(&u8g2, 20+frame, 32, 15, U8G2_DRAW_ALL);
+  u8g2_DrawBox(&u8g2, 60, 10+(frame&7), 40, 20);
+}
+
+/* 0: init, 1: full frames, 2: updates of 3 tiles (e.g. a numeric field) */
+static void scenario(int n)
+{
+  uint8_t tile[3*8];
+  int i;
+  switch(n)
+  {
+    case 0:
+      u8g2_InitDisplay(&u8g2);
+      u8g2_SetPowerSave(&u8g2, 0);
+      u8g2_SetContrast(&u8g2, 128);
+      break;
+    case 1:
+      for( i = 0; i < 10; i++ )
+      {
+	draw(i);
+	u8g2_SendBuffer(&u8g2);
+      }
+      break;
+    case 2:
+      for( i = 0; i < 100; i++ )
+      {
+	memset(tile, i, sizeof(tile));
+	u8x8_DrawTile(u8g2_GetU8x8(&u8g2), 5, i & 7, 3, tile);
+      }
+      break;
+  }
+}
+
+static const char *scenario_name[3] = { "init", "10 frames", "100x3 tiles" };
+
+static void run(u8x8_msg_cb cad_cb, int n, uint16_t *copy, unsigned long *copy_cnt, struct stat *s)
+{
+  u8x8_Setup(u8g2_GetU8x8(&u8g2), u8x8_d_ssd1306_128x64_noname, cad_cb, u8x8_byte_count, u8x8_gpio_null);
+  u8g2_SetupBuffer(&u8g2, buf, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+  memset(&stat, 0, sizeof(stat));
+  log_cnt = 0;
+  scenario(n);
+  *s = stat;
+  memcpy(copy, log_list, log_cnt*sizeof(uint16_t));
+  *copy_cnt = log_cnt;
+}
+
+static double wire_ms(const struct stat *s)
+{
+  return (s->bytes*9.0 + s->transfers*2.0) / 400.0;
+}
+
+int main(void)
+{
+  static uint16_t legacy_log[LOG_MAX];
+  static uint16_t new_log[LOG_MAX];
+  unsigned long legacy_cnt, new_cnt;
+  struct stat legacy, cur;
+  int n, err = 0;
+  
+  printf("U8X8_I2C_MAX_TRANSFER=%d\n", U8X8_I2C_MAX_TRANSFER);
+  printf("%-12s %21s %21s %17s\n", "", "transfers", "bytes on wire", "time@400kHz ms");
+  printf("%-12s %10s %10s %10s %10s %8s %8s\n", "", "previous", "combined", "previous", "combined", "previous", "combined");
+  for( n = 0; n < 3; n++ )
+  {
+    run(u8x8_cad_legacy_i2c, n, legacy_log, &legacy_cnt, &legacy);
+    run(u8x8_cad_ssd13xx_i2c, n, new_log, &new_cnt, &cur);
+    printf("%-12s %10lu %10lu %10lu %10lu %8.2f %8.2f\n", scenario_name[n],
+      legacy.transfers, cur.transfers, legacy.bytes, cur.bytes, wire_ms(&legacy), wire_ms(&cur));
+    if ( legacy_cnt != new_cnt || memcmp(legacy_log, new_log, new_cnt*sizeof(uint16_t)) != 0 )
+    {
+      printf("%s: different command/data bytes\n", scenario_name[n]);
+      err++;
+    }
+    if ( cur.max_transfer > U8X8_I2C_MAX_TRANSFER )
+    {
+      printf("%s: transfer with %lu bytes\n", scenario_name[n], cur.max_transfer);
+      err++;
+    }
+  }
+  if ( is_log_overflow )
+    err++;
+  printf("%s\n", err ? "failed" : "ok");
+  return err ? 1 : 0;
+}
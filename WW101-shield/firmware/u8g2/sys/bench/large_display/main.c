@@ -0,0 +1,145 @@
+/*
+  Benchmark for the hvline, clipping and intersection procedures 
+  on small and large displays.
+  
+  Build with 8 Bit (default) and 16 Bit (U8G2_16BIT) coordinates and with
+  16 Bit coordinates and 8 Bit buffer positions (U8G2_8BIT_BUFFER): make test
+  In 8 Bit mode, the width of the 256x64 display is limited to 240 pixel.
+  The 384x240 a2printer must use its complete width in 16 Bit mode, except
+  with U8G2_8BIT_BUFFER.
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <time.h>
+
+#define FRAMES 200
+
+/* ../common/u8x8_byte_null.c */
+extern uint8_t u8x8_byte_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+void draw(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t w = u8g2_GetDisplayWidth(u8g2);
+  u8g2_uint_t h = u8g2_GetDisplayHeight(u8g2);
+  u8g2_uint_t i;
+  
+  u8g2_DrawFrame(u8g2, 0, 0, w, h);
+  for( i = 0; i < h; i += 4 )
+    u8g2_DrawHLine(u8g2, frame & 15, i, w-16);
+  for( i = 0; i < w; i += 4 )
+    u8g2_DrawVLine(u8g2, i, frame & 7, h-8);
+  for( i = 0; i < 16; i++ )
+  {
+    u8g2_DrawPixel(u8g2, (frame*7+i*13) % w, (frame*3+i*5) % h);
+    u8g2_DrawBox(u8g2, (i*17) % w, (i*11) % h, 10, 6);
+  }
+  u8g2_DrawLine(u8g2, 0, 0, w-1, h-1);
+  u8g2_DrawCircle(u8g2, w/2, h/2, h/3, U8G2_DRAW_ALL);
+  u8g2_DrawDisc(u8g2, w/4, h/2, h/4, U8G2_DRAW_ALL);
+  /* partly outside of the display */
+  u8g2_DrawBox(u8g2, w-5, h-5, 20, 20);
+}
+
+uint16_t checksum(u8g2_t *u8g2)
+{
+  uint8_t *ptr = u8g2_GetBufferPtr(u8g2);
+  uint16_t cnt = u8g2_GetBufferTileWidth(u8g2)*8*u8g2_GetBufferTileHeight(u8g2);
+  uint16_t sum = 0;
+  while( cnt > 0 )
+  {
+    sum = (sum << 1) + (sum >> 15) + *ptr++;
+    cnt--;
+  }
+  return sum;
+}
+
+#ifdef U8G2_16BIT
+/* returns the number of pixel in the buffer after a box right of x = 256 is drawn */
+unsigned long draw_right_box(u8g2_t *u8g2)
+{
+  uint8_t *ptr = u8g2_GetBufferPtr(u8g2);
+  uint16_t cnt = u8g2_GetBufferTileWidth(u8g2)*8*u8g2_GetBufferTileHeight(u8g2);
+  unsigned long pixel = 0;
+  uint8_t b;
+  
+  u8g2_ClearBuffer(u8g2);
+  u8g2_DrawBox(u8g2, 300, 100, 10, 8);
+  while( cnt > 0 )
+  {
+    for( b = *ptr++; b != 0; b &= b-1 )
+      pixel++;
+    cnt--;
+  }
+  return pixel;
+}
+#endif
+
+void bench(u8g2_t *u8g2, const char *name)
+{
+  clock_t t;
+  uint16_t frame;
+  uint16_t sum = 0;
+  
+  t = clock();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_FirstPage(u8g2);
+    do
+    {
+      draw(u8g2, frame);
+    } while( u8g2_NextPage(u8g2) );
+    sum += checksum(u8g2);
+  }
+  t = clock() - t;
+  printf("%-24s %2d bit %3dx%-3d %8.1f us/frame  checksum %04x\n", name, 
+    (int)sizeof(u8g2_uint_t)*8, u8g2_GetDisplayWidth(u8g2), u8g2_GetDisplayHeight(u8g2), 
+    (double)t*1000000.0/CLOCKS_PER_SEC/FRAMES, sum);
+}
+
+int main(void)
+{
+  u8g2_t u8g2;
+#ifdef U8G2_16BIT
+  unsigned long pixel, expected;
+#endif
+  
+  u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "ssd1306 128x64 page");
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "ssd1306 128x64 full");
+  
+  u8g2_Setup_ssd1322_nhd_256x64_1(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "ssd1322 256x64 page");
+  u8g2_Setup_ssd1322_nhd_256x64_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "ssd1322 256x64 full");
+  u8g2_Setup_ssd1322_nhd_256x64_f(&u8g2, U8G2_R1, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "ssd1322 256x64 full R1");
+
+  u8g2_Setup_ssd1607_200x200_1(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "ssd1607 200x200 page");
+  u8g2_Setup_ssd1607_200x200_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "ssd1607 200x200 full");
+  
+  u8g2_Setup_a2printer_384x240_1(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "a2printer 384x240 page");
+  u8g2_Setup_a2printer_384x240_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "a2printer 384x240 full");
+  u8g2_Setup_a2printer_384x240_f(&u8g2, U8G2_R1, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "a2printer 384x240 R1");
+  
+#ifdef U8G2_16BIT
+  u8g2_Setup_a2printer_384x240_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  pixel = draw_right_box(&u8g2);
+#ifdef U8G2_8BIT_BUFFER
+  expected = 0;	/* clipped */
+#else
+  expected = 80;
+#endif
+  printf("box at x = 300: %lu pixel, expected %lu   %s\n", pixel, expected, pixel == expected ? "ok" : "failed");
+  if ( pixel != expected )
+    return 1;
+#endif
+  return 0;
+}
+
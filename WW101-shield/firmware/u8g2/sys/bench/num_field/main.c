@@ -0,0 +1,233 @@
+/*
+  Numeric fields (u8x8_num_field.c) against redrawing complete text lines.
+  
+  Three sensor readouts (temperature, humidity, light) change slowly.
+  Line redraw: format each line with snprintf and draw it with 
+  u8x8_DrawString. Field: labels are drawn once, the values are updated
+  with u8x8_UpdateNumField.
+  
+  fps@i2c adds the transfer time of the tiles with a 400 kHz i2c bus.
+  The display memory is emulated: after each update, the memory of both
+  methods must be identical. u8x8_fixtoap is also compared with snprintf.
+  
+  Build and run: make test
+*/
+
+#include "u8x8.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define UPDATES 20000
+
+static uint8_t ram[128*64/8];		/* emulated display memory */
+static unsigned long sent_tiles;
+
+/* 128x64 display, which stores the tiles in "ram" */
+uint8_t u8x8_d_emu(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_tile_t *tile = (u8x8_tile_t *)arg_ptr;
+  if ( msg == U8X8_MSG_DISPLAY_SETUP_MEMORY )
+    return u8x8_d_ssd1306_128x64_noname(u8x8, msg, arg_int, arg_ptr);
+  if ( msg == U8X8_MSG_DISPLAY_DRAW_TILE )
+  {
+    memcpy(ram + tile->y_pos*128 + tile->x_pos*8, tile->tile_ptr, tile->cnt*8);
+    sent_tiles += tile->cnt;
+  }
+  return 1;
+}
+
+uint8_t u8x8_null_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+struct sensor
+{
+  int32_t temp;		/* 1/10 degree */
+  int32_t humidity;	/* 1/10 percent */
+  int32_t light;
+};
+
+static void sensor_step(struct sensor *s)
+{
+  s->temp += (rand() % 5) - 2;
+  s->humidity += (rand() % 3) - 1;
+  s->light += (rand() % 21) - 10;
+  if ( s->light < 0 )
+    s->light = 0;
+}
+
+static void draw_lines(u8x8_t *u8x8, const struct sensor *s)
+{
+  char str[20];
+  snprintf(str, sizeof(str), "Temp:   %6.1f", s->temp/10.0);
+  u8x8_DrawString(u8x8, 0, 3, str);
+  snprintf(str, sizeof(str), "Humid:  %6.1f", s->humidity/10.0);
+  u8x8_DrawString(u8x8, 0, 4, str);
+  snprintf(str, sizeof(str), "Light:  %6.0f", (double)s->light);
+  u8x8_DrawString(u8x8, 0, 5, str);
+}
+
+static u8x8_num_field_t field_list[3];
+
+static void init_fields(u8x8_t *u8x8)
+{
+  u8x8_DrawString(u8x8, 0, 3, "Temp:   ");
+  u8x8_DrawString(u8x8, 0, 4, "Humid:  ");
+  u8x8_DrawString(u8x8, 0, 5, "Light:  ");
+  u8x8_InitNumField(field_list+0, u8x8_font_amstrad_cpc_extended_r, 8, 3, 6, 1, 1);
+  u8x8_InitNumField(field_list+1, u8x8_font_amstrad_cpc_extended_r, 8, 4, 6, 1, 1);
+  u8x8_InitNumField(field_list+2, u8x8_font_amstrad_cpc_extended_r, 8, 5, 6, 0, 1);
+}
+
+static void draw_fields(u8x8_t *u8x8, const struct sensor *s)
+{
+  u8x8_UpdateNumField(u8x8, field_list+0, s->temp);
+  u8x8_UpdateNumField(u8x8, field_list+1, s->humidity);
+  u8x8_UpdateNumField(u8x8, field_list+2, s->light);
+}
+
+/* reference for u8x8_fixtoap, based on snprintf */
+static void ref_fixtoa(char *dest, int32_t v, uint8_t width, uint8_t decimals)
+{
+  static const long long pow10[] = { 1, 10, 100, 1000 };
+  char s[40];
+  long long a = v < 0 ? -(long long)v : v;
+  size_t len;
+  
+  if ( decimals == 0 )
+    snprintf(s, sizeof(s), "%lld", (long long)v);
+  else
+    snprintf(s, sizeof(s), "%s%lld.%0*lld", v < 0 ? "-" : "", a / pow10[decimals], (int)(decimals & 3), a % pow10[decimals]);
+  len = strlen(s);
+  if ( len > width )
+  {
+    memset(dest, '#', width);
+  }
+  else
+  {
+    memset(dest, ' ', width - len);
+    memcpy(dest + width - len, s, len);
+  }
+  dest[width] = '\0';
+}
+
+/* compare u8x8_fixtoap with snprintf */
+static int check_fixtoap(void)
+{
+  char a[16], b[16];
+  int32_t v;
+  uint8_t w, d;
+  int i, err = 0;
+  
+  for( i = 0; i < 200000; i++ )
+  {
+    switch(i & 3)
+    {
+      case 0: v = (rand() % 2001) - 1000; break;
+      case 1: v = (int32_t)((unsigned)rand() * 2654435761U); break;
+      case 2: v = i & 4 ? 2147483647 : -2147483647-1; break;
+      default: v = (rand() % 200001) - 100000; break;
+    }
+    w = 1 + rand() % U8X8_NUM_FIELD_MAX_WIDTH;
+    d = rand() % 4;
+    u8x8_fixtoap(a, v, w, d);
+    ref_fixtoa(b, v, w, d);
+    if ( strcmp(a, b) != 0 )
+    {
+      if ( err < 10 )
+	printf("fixtoap(%ld, %u, %u): '%s', expected '%s'\n", (long)v, w, d, a, b);
+      err++;
+    }
+  }
+  return err;
+}
+
+static double run(u8x8_t *u8x8, int is_field, unsigned long *tiles, uint8_t *final_ram)
+{
+  struct sensor s = { 215, 453, 1200 };
+  clock_t t;
+  int i;
+  
+  srand(1);
+  memset(ram, 0, sizeof(ram));
+  if ( is_field )
+    init_fields(u8x8);
+  sent_tiles = 0;
+  t = clock();
+  for( i = 0; i < UPDATES; i++ )
+  {
+    sensor_step(&s);
+    if ( is_field )
+      draw_fields(u8x8, &s);
+    else
+      draw_lines(u8x8, &s);
+  }
+  t = clock() - t;
+  *tiles = sent_tiles;
+  memcpy(final_ram, ram, sizeof(ram));
+  return (double)t / CLOCKS_PER_SEC;
+}
+
+/* check after each update that both methods show the same */
+static int check_ram(u8x8_t *u8x8)
+{
+  static uint8_t line_ram[128*64/8];
+  struct sensor s = { -15, 999, 0 };
+  int i;
+  
+  memset(ram, 0, sizeof(ram));
+  init_fields(u8x8);
+  for( i = 0; i < 3000; i++ )
+  {
+    s.temp += (rand() % 41) - 20;
+    s.humidity += (rand() % 41) - 20;
+    s.light += (rand() % 2001) - 1000;
+    if ( s.light < 0 )
+      s.light = 0;
+    draw_fields(u8x8, &s);
+    memcpy(line_ram, ram, sizeof(ram));
+    draw_lines(u8x8, &s);
+    if ( memcmp(line_ram, ram, sizeof(ram)) != 0 )
+    {
+      printf("display memory differs after update %d\n", i);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int main(void)
+{
+  u8x8_t u8x8;
+  static uint8_t ram_lines[128*64/8];
+  static uint8_t ram_fields[128*64/8];
+  unsigned long tiles_lines, tiles_fields;
+  double t_lines, t_fields;
+  double tile_time = (8*9+3*3*9)/400000.0;	/* 8 data bytes + position commands, 9 bits per byte */
+  int err;
+  
+  u8x8_Setup(&u8x8, u8x8_d_emu, u8x8_cad_001, u8x8_null_cb, u8x8_null_cb);
+  u8x8_SetFont(&u8x8, u8x8_font_amstrad_cpc_extended_r);
+  
+  t_lines = run(&u8x8, 0, &tiles_lines, ram_lines);
+  t_fields = run(&u8x8, 1, &tiles_fields, ram_fields);
+  
+  printf("%d updates of 3 values\n", UPDATES);
+  printf("lines:  %8.3f us/update %6.2f tiles/update %7.1f updates/s@i2c\n", 
+    t_lines*1e6/UPDATES, (double)tiles_lines/UPDATES, UPDATES/(t_lines + tiles_lines*tile_time));
+  printf("fields: %8.3f us/update %6.2f tiles/update %7.1f updates/s@i2c\n", 
+    t_fields*1e6/UPDATES, (double)tiles_fields/UPDATES, UPDATES/(t_fields + tiles_fields*tile_time));
+  
+  err = check_fixtoap();
+  if ( memcmp(ram_lines, ram_fields, sizeof(ram_lines)) != 0 )
+  {
+    printf("display memory differs\n");
+    err++;
+  }
+  err += check_ram(&u8x8);
+  printf("%s\n", err ? "failed" : "ok");
+  return err ? 1 : 0;
+}
@@ -0,0 +1,222 @@
+/*
+  Benchmark for the scan line polygon fill (u8g2_polygon.c).
+  
+  Gauges: Each needle is a triangle, each scale segment a polygon
+  with four points.
+  Chart: Filled area chart, one polygon with up to 130 points.
+  
+  Check: Concave, self-intersecting and random polygons (also with 
+  coordinates far outside the display) are compared with a brute-force 
+  even-odd point in polygon test for each pixel.
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#define FRAMES 200
+#define CHART_POINTS 128
+
+/* ../common/u8x8_byte_null.c */
+extern uint8_t u8x8_byte_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+/* memory for the edges of the largest polygon */
+u8g2_pg_point_t chart_points[CHART_POINTS+2];
+u8g2_pg_edge_t chart_edges[CHART_POINTS+2];
+
+void draw_gauge(u8g2_t *u8g2, int16_t cx, int16_t cy, int16_t r, uint16_t value)
+{
+  u8g2_pg_point_t seg[4];
+  u8g2_pg_edge_t edges[4];
+  double a0, a1, a;
+  uint8_t i;
+  
+  /* scale: 12 segments on a half circle */
+  for( i = 0; i < 12; i++ )
+  {
+    a0 = M_PI + (M_PI*i)/12.0 + 0.03;
+    a1 = M_PI + (M_PI*(i+1))/12.0 - 0.03;
+    seg[0].x = cx + r*cos(a0);
+    seg[0].y = cy + r*sin(a0);
+    seg[1].x = cx + r*cos(a1);
+    seg[1].y = cy + r*sin(a1);
+    seg[2].x = cx + (r-5)*cos(a1);
+    seg[2].y = cy + (r-5)*sin(a1);
+    seg[3].x = cx + (r-5)*cos(a0);
+    seg[3].y = cy + (r-5)*sin(a0);
+    u8g2_DrawPolygonList(u8g2, seg, 4, edges);
+  }
+  
+  /* needle */
+  a = M_PI + (M_PI*(value % 100))/100.0;
+  u8g2_DrawTriangle(u8g2, 
+    cx + (r-7)*cos(a), cy + (r-7)*sin(a),
+    cx + 3*cos(a+M_PI/2), cy + 3*sin(a+M_PI/2),
+    cx + 3*cos(a-M_PI/2), cy + 3*sin(a-M_PI/2));
+}
+
+void draw_chart(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t w = u8g2_GetDisplayWidth(u8g2);
+  u8g2_uint_t h = u8g2_GetDisplayHeight(u8g2);
+  uint8_t i;
+  
+  for( i = 0; i < CHART_POINTS; i++ )
+  {
+    chart_points[i].x = (int16_t)((uint32_t)i*(w-1)/(CHART_POINTS-1));
+    chart_points[i].y = h/2 + (h/3)*sin((i+frame)*0.15) + (h/8)*sin((i*3+frame)*0.4);
+  }
+  chart_points[CHART_POINTS].x = w-1;
+  chart_points[CHART_POINTS].y = h;
+  chart_points[CHART_POINTS+1].x = 0;
+  chart_points[CHART_POINTS+1].y = h;
+  u8g2_DrawPolygonList(u8g2, chart_points, CHART_POINTS+2, chart_edges);
+}
+
+void draw_gauges(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t w = u8g2_GetDisplayWidth(u8g2);
+  u8g2_uint_t h = u8g2_GetDisplayHeight(u8g2);
+  draw_gauge(u8g2, w/4, h-4, w/4-2, frame);
+  draw_gauge(u8g2, (w*3)/4, h-4, w/4-2, frame*3);
+}
+
+void bench(u8g2_t *u8g2, const char *name, void (*draw)(u8g2_t *u8g2, uint16_t frame))
+{
+  clock_t t;
+  uint16_t frame;
+  
+  t = clock();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_FirstPage(u8g2);
+    do
+    {
+      draw(u8g2, frame);
+    } while( u8g2_NextPage(u8g2) );
+  }
+  t = clock() - t;
+  printf("%-28s %3dx%-3d %8.1f us/frame\n", name, 
+    u8g2_GetDisplayWidth(u8g2), u8g2_GetDisplayHeight(u8g2), 
+    (double)t*1000000.0/CLOCKS_PER_SEC/FRAMES);
+}
+
+/*===========================================*/
+/* check against a brute-force point in polygon test */
+
+/* even-odd rule: pixel (px, y) is inside, if an odd number of edges crosses the scan line y at or left of px */
+int is_inside(const u8g2_pg_point_t *list, uint16_t cnt, int32_t px, int32_t y)
+{
+  const u8g2_pg_point_t *a, *b;
+  uint16_t i;
+  int inside = 0;
+  
+  for( i = 0; i < cnt; i++ )
+  {
+    a = list+i;
+    b = list+(i+1 < cnt ? i+1 : 0);
+    if ( a->y > b->y )
+    {
+      a = b;
+      b = list+i;
+    }
+    if ( y < a->y || y >= b->y )
+      continue;
+    /* x(y) = a->x + (b->x - a->x)*(y - a->y)/(b->y - a->y) <= px */
+    if ( (int64_t)a->x*(b->y - a->y) + (int64_t)(b->x - a->x)*(y - a->y) <= (int64_t)px*(b->y - a->y) )
+      inside = !inside;
+  }
+  return inside;
+}
+
+/* returns the number of pixel, which differ from the brute-force test */
+unsigned long check_polygon(u8g2_t *u8g2, const u8g2_pg_point_t *list, uint16_t cnt)
+{
+  static u8g2_pg_edge_t edges[64];
+  uint8_t *buf;
+  int32_t x, y;
+  int is_set;
+  unsigned long err = 0;
+  
+  u8g2_ClearBuffer(u8g2);
+  u8g2_DrawPolygonList(u8g2, list, cnt, edges);
+  buf = u8g2_GetBufferPtr(u8g2);
+  for( y = 0; y < 64; y++ )
+    for( x = 0; x < 128; x++ )
+    {
+      is_set = (buf[(y/8)*128 + x] >> (y&7)) & 1;
+      if ( is_set != is_inside(list, cnt, x, y) )
+	err++;
+    }
+  return err;
+}
+
+static const u8g2_pg_point_t pg_star[] = 	/* self-intersecting pentagram */
+  { {64,2}, {90,62}, {20,24}, {108,24}, {38,62} };
+static const u8g2_pg_point_t pg_bowtie[] = 	/* self-intersecting */
+  { {5,5}, {120,58}, {120,5}, {5,58} };
+static const u8g2_pg_point_t pg_comb[] = 	/* concave */
+  { {4,60}, {4,4}, {20,40}, {36,4}, {52,40}, {68,4}, {84,40}, {100,4}, {124,60} };
+static const u8g2_pg_point_t pg_ring[] = 	/* concave, square with a square hole (joined by a zero width cut) */
+  { {10,10}, {110,10}, {110,60}, {10,60}, {10,10}, {40,20}, {40,45}, {80,45}, {80,20}, {40,20} };
+static const u8g2_pg_point_t pg_far[] = 	/* coordinates far outside the display */
+  { {-30000,-20000}, {32000,30}, {-32000,63}, {60,-32000}, {90,32000} };
+
+int check(u8g2_t *u8g2)
+{
+  u8g2_pg_point_t list[12];
+  unsigned long err, total = 0;
+  uint32_t r = 1;
+  uint16_t i, j, cnt;
+  
+  total += err = check_polygon(u8g2, pg_star, 5);
+  printf("%-28s %6lu wrong pixel\n", "pentagram", err);
+  total += err = check_polygon(u8g2, pg_bowtie, 4);
+  printf("%-28s %6lu wrong pixel\n", "bow tie", err);
+  total += err = check_polygon(u8g2, pg_comb, 9);
+  printf("%-28s %6lu wrong pixel\n", "comb", err);
+  total += err = check_polygon(u8g2, pg_ring, 10);
+  printf("%-28s %6lu wrong pixel\n", "ring", err);
+  total += err = check_polygon(u8g2, pg_far, 5);
+  printf("%-28s %6lu wrong pixel\n", "far outside", err);
+  
+  err = 0;
+  for( i = 0; i < 1000; i++ )
+  {
+    cnt = 3 + i % 10;
+    for( j = 0; j < cnt; j++ )
+    {
+      r = r*1103515245UL + 12345UL;
+      list[j].x = (int16_t)((r >> 16) % 160) - 16;
+      r = r*1103515245UL + 12345UL;
+      list[j].y = (int16_t)((r >> 16) % 96) - 16;
+    }
+    err += check_polygon(u8g2, list, cnt);
+  }
+  total += err;
+  printf("%-28s %6lu wrong pixel\n", "1000 random polygons", err);
+  printf("polygon check %s\n", total == 0 ? "ok" : "failed");
+  return total == 0 ? 0 : 1;
+}
+
+int main(void)
+{
+  u8g2_t u8g2;
+  
+  u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "gauges, page buffer", draw_gauges);
+  bench(&u8g2, "chart, page buffer", draw_chart);
+
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "gauges, full buffer", draw_gauges);
+  bench(&u8g2, "chart, full buffer", draw_chart);
+  
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R1, u8x8_byte_null, u8x8_byte_null);
+  bench(&u8g2, "chart, full buffer, R1", draw_chart);
+  
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  return check(&u8g2);
+}
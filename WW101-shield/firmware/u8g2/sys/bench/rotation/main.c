@@ -0,0 +1,95 @@
+/*
+  Benchmark for scenes with many short lines and single pixels, where 
+  the rotation (draw_l90) and the ll_hvline procedure are called very often.
+  
+  bench_default uses the function pointers for all rotations.
+  bench_fixed_r0 is compiled with U8G2_FIXED_ROTATION and U8G2_FIXED_LL_HVLINE 
+  for U8G2_R0. The U8G2_R1 result shows the fallback for other rotations.
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <time.h>
+
+#define FRAMES 500
+
+/* ../common/u8x8_byte_null.c */
+extern uint8_t u8x8_byte_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+static const uint8_t pattern_bits[] = { 
+  0x3c, 0x42, 0xa5, 0x81, 0xa5, 0x99, 0x42, 0x3c };
+
+void draw_pixel(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t x, y;
+  for( y = frame & 3; y < 64; y += 3 )
+    for( x = y & 1; x < 128; x += 2 )
+      u8g2_DrawPixel(u8g2, x, y);
+}
+
+void draw_xbm(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t x, y;
+  for( y = 0; y < 64; y += 9 )
+    for( x = frame & 7; x < 120; x += 9 )
+      u8g2_DrawXBM(u8g2, x, y, 8, 8, pattern_bits);
+}
+
+void draw_lines(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t i;
+  for( i = 0; i < 64; i += 2 )
+  {
+    u8g2_DrawLine(u8g2, 0, i, 127, 63-i);
+    u8g2_DrawLine(u8g2, i*2, 0, 127-i*2, 63);
+  }
+  u8g2_DrawDisc(u8g2, 64, 32, 10+(frame & 15), U8G2_DRAW_ALL);
+}
+
+void bench(u8g2_t *u8g2, const char *name, void (*draw)(u8g2_t *u8g2, uint16_t frame))
+{
+  clock_t t;
+  uint16_t frame;
+  
+  t = clock();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_FirstPage(u8g2);
+    do
+    {
+      draw(u8g2, frame);
+    } while( u8g2_NextPage(u8g2) );
+  }
+  t = clock() - t;
+  printf("%-32s %8.1f us/frame\n", name, (double)t*1000000.0/CLOCKS_PER_SEC/FRAMES);
+}
+
+void bench_all(u8g2_t *u8g2, const char *name)
+{
+  printf("%s\n", name);
+  bench(u8g2, "  pixel", draw_pixel);
+  bench(u8g2, "  xbm", draw_xbm);
+  bench(u8g2, "  lines", draw_lines);
+}
+
+int main(void)
+{
+  u8g2_t u8g2;
+  
+#ifdef U8G2_FIXED_ROTATION
+  printf("U8G2_FIXED_ROTATION=%d\n", U8G2_FIXED_ROTATION);
+#else
+  printf("function pointer dispatch\n");
+#endif
+  
+  u8g2_Setup_ssd1306_128x64_noname_1(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench_all(&u8g2, "ssd1306 128x64 page buffer, R0");
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R0, u8x8_byte_null, u8x8_byte_null);
+  bench_all(&u8g2, "ssd1306 128x64 full buffer, R0");
+  u8g2_Setup_ssd1306_128x64_noname_f(&u8g2, U8G2_R1, u8x8_byte_null, u8x8_byte_null);
+  bench_all(&u8g2, "ssd1306 128x64 full buffer, R1");
+  
+  return 0;
+}
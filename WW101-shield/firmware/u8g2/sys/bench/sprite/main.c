@@ -0,0 +1,246 @@
+/*
+  Sprite layer (u8g2_sprite.c) against a full redraw of the scene.
+  
+  Full redraw: copy the background into the buffer, draw all sprites, 
+  send the complete buffer. Layer: move the sprites, compose and send 
+  the dirty tiles only.
+  
+  fps@i2c adds the transfer time of the tiles with a 400 kHz i2c bus.
+  The display memory is emulated: after each frame, the emulated memory
+  must be identical to the buffer of the full redraw.
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define FRAMES 2000
+#define SPRITE_CNT 6
+
+static uint8_t ram[128*64/8];		/* emulated display memory */
+static unsigned long sent_tiles;
+static uint8_t is_horizontal;
+
+/* 128x64 display, which stores the tiles in "ram" */
+uint8_t u8x8_d_emu(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  u8x8_tile_t *tile = (u8x8_tile_t *)arg_ptr;
+  if ( msg == U8X8_MSG_DISPLAY_SETUP_MEMORY )
+    return u8x8_d_ssd1306_128x64_noname(u8x8, msg, arg_int, arg_ptr);
+  if ( msg == U8X8_MSG_DISPLAY_DRAW_TILE )
+  {
+    if ( is_horizontal )
+      memcpy(ram + tile->y_pos*128, tile->tile_ptr, 128);	/* always a complete tile row */
+    else
+      memcpy(ram + tile->y_pos*128 + tile->x_pos*8, tile->tile_ptr, tile->cnt*8);
+    sent_tiles += tile->cnt;
+  }
+  else if ( msg == U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK )
+  {
+    /* the display info of the SSD1306 announces tile blocks, arg_int is the number of rows */
+    uint8_t i;
+    for( i = 0; i < arg_int; i++ )
+      memcpy(ram + (tile->y_pos+i)*128 + tile->x_pos*8, tile->tile_ptr + i*tile->cnt*8, tile->cnt*8);
+    sent_tiles += tile->cnt*arg_int;
+  }
+  return 1;
+}
+
+uint8_t u8x8_null_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static const uint8_t ball_bits[] = {
+  0xe0, 0x07, 0xf8, 0x1f, 0xfc, 0x3f, 0xfe, 0x7f, 0xce, 0x7f, 0x87, 0xff,
+  0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xfe, 0x7b,
+  0xfe, 0x7c, 0xfc, 0x3f, 0xf8, 0x1f, 0xe0, 0x07 };
+
+static const uint8_t ghost_bits[] = {
+  0xe0, 0x07, 0x18, 0x18, 0x04, 0x20, 0x72, 0x4e, 0x52, 0x4a, 0x71, 0x8e,
+  0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80,
+  0x01, 0x80, 0x99, 0x99, 0xa5, 0xa5, 0xc3, 0xc3 };
+
+struct pos
+{
+  int16_t x, y, dx, dy;
+};
+
+static struct pos pos_list[SPRITE_CNT];
+static uint8_t bg_buf[128*64/8];
+static uint8_t ref_buf[128*64/8];
+static uint8_t buf[128*64/8];
+
+void setup(u8g2_t *u8g2, uint8_t *b, uint8_t rows, u8g2_draw_ll_hvline_cb ll_hvline)
+{
+  u8x8_Setup(u8g2_GetU8x8(u8g2), u8x8_d_emu, u8x8_cad_001, u8x8_null_cb, u8x8_null_cb);
+  u8g2_SetupBuffer(u8g2, b, rows, ll_hvline, U8G2_R0);
+}
+
+void draw_background(u8g2_t *u8g2)
+{
+  u8g2_uint_t i;
+  u8g2_ClearBuffer(u8g2);
+  u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+  for( i = 8; i < 128; i += 16 )
+    u8g2_DrawVLine(u8g2, i, 1, 62);
+  for( i = 8; i < 64; i += 16 )
+    u8g2_DrawHLine(u8g2, 1, i, 126);
+  u8g2_DrawDisc(u8g2, 64, 32, 14, U8G2_DRAW_ALL);
+}
+
+void init_sprites(u8g2_sprite_t *sprite_list)
+{
+  uint8_t i;
+  for( i = 0; i < SPRITE_CNT; i++ )
+  {
+    u8g2_SetSprite(sprite_list+i, 16, 16, (i & 1) ? ghost_bits : ball_bits);
+    sprite_list[i].is_transparent = i & 1;
+    pos_list[i].x = 5 + i*19;
+    pos_list[i].y = 3 + i*7;
+    pos_list[i].dx = (i % 3) + 1;
+    pos_list[i].dy = 2 - (i % 2)*3;
+    sprite_list[i].x = pos_list[i].x;
+    sprite_list[i].y = pos_list[i].y;
+  }
+}
+
+void step_sprites(void)
+{
+  uint8_t i;
+  for( i = 0; i < SPRITE_CNT; i++ )
+  {
+    pos_list[i].x += pos_list[i].dx;
+    pos_list[i].y += pos_list[i].dy;
+    if ( pos_list[i].x < 0 || pos_list[i].x > 128-16 )
+    {
+      pos_list[i].dx = -pos_list[i].dx;
+      pos_list[i].x += 2*pos_list[i].dx;
+    }
+    if ( pos_list[i].y < 0 || pos_list[i].y > 64-16 )
+    {
+      pos_list[i].dy = -pos_list[i].dy;
+      pos_list[i].y += 2*pos_list[i].dy;
+    }
+  }
+}
+
+/* the current way: background, then all sprites with u8g2_DrawXBM */
+void draw_full(u8g2_t *u8g2, u8g2_sprite_t *sprite_list)
+{
+  uint8_t i;
+  u8g2_uint_t x, y;
+  memcpy(u8g2_GetBufferPtr(u8g2), bg_buf, sizeof(bg_buf));
+  for( i = 0; i < SPRITE_CNT; i++ )
+  {
+    if ( sprite_list[i].is_visible == 0 )
+      continue;
+    if ( sprite_list[i].is_transparent == 0 )
+    {
+      u8g2_DrawXBM(u8g2, pos_list[i].x, pos_list[i].y, 16, 16, sprite_list[i].bitmap);
+    }
+    else
+    {
+      for( y = 0; y < 16; y++ )
+	for( x = 0; x < 16; x++ )
+	  if ( sprite_list[i].bitmap[y*2+x/8] & (1<<(x&7)) )
+	    u8g2_DrawPixel(u8g2, pos_list[i].x+x, pos_list[i].y+y);
+    }
+  }
+}
+
+/* frame rate with a 400 kHz i2c bus: 8 bytes per tile, 9 clocks per byte */
+double fps_i2c(double fps_cpu, unsigned long tiles)
+{
+  return 1.0 / (1.0/fps_cpu + (double)tiles/FRAMES*8.0*9.0/400000.0);
+}
+
+int bench(const char *name, uint8_t rows, u8g2_draw_ll_hvline_cb ll_hvline)
+{
+  u8g2_t u8g2, ref, bg;
+  u8g2_layer_t layer;
+  u8g2_sprite_t sprite_list[SPRITE_CNT];
+  uint8_t dirty[U8G2_LAYER_DIRTY_SIZE(16, 8)];
+  uint16_t frame;
+  uint8_t i;
+  unsigned errors = 0;
+  clock_t t;
+  double fps_full, fps_layer;
+  unsigned long tiles_full, tiles_layer;
+
+  is_horizontal = ( ll_hvline != u8g2_ll_hvline_vertical_top_lsb );
+  setup(&bg, bg_buf, 8, ll_hvline);
+  draw_background(&bg);
+  
+  /* full redraw */
+  setup(&ref, ref_buf, 8, ll_hvline);
+  init_sprites(sprite_list);
+  sent_tiles = 0;
+  t = clock();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    step_sprites();
+    draw_full(&ref, sprite_list);
+    u8g2_SendBuffer(&ref);
+  }
+  t = clock() - t;
+  fps_full = (double)FRAMES*CLOCKS_PER_SEC/(double)(t == 0 ? 1 : t);
+  tiles_full = sent_tiles;
+  
+  /* layer */
+  setup(&u8g2, buf, rows, ll_hvline);
+  init_sprites(sprite_list);
+  u8g2_InitLayer(&u8g2, &layer, bg_buf, sprite_list, SPRITE_CNT, dirty);
+  u8g2_UpdateLayer(&u8g2, &layer);
+  sent_tiles = 0;
+  t = clock();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    step_sprites();
+    for( i = 0; i < SPRITE_CNT; i++ )
+      u8g2_MoveSprite(&u8g2, &layer, sprite_list+i, pos_list[i].x, pos_list[i].y);
+    u8g2_UpdateLayer(&u8g2, &layer);
+  }
+  t = clock() - t;
+  fps_layer = (double)FRAMES*CLOCKS_PER_SEC/(double)(t == 0 ? 1 : t);
+  tiles_layer = sent_tiles;
+  
+  /* check: same sequence again, compare the display memory with the full redraw */
+  init_sprites(sprite_list);
+  u8g2_InitLayer(&u8g2, &layer, bg_buf, sprite_list, SPRITE_CNT, dirty);
+  u8g2_UpdateLayer(&u8g2, &layer);
+  for( frame = 0; frame < 300; frame++ )
+  {
+    step_sprites();
+    for( i = 0; i < SPRITE_CNT; i++ )
+      u8g2_MoveSprite(&u8g2, &layer, sprite_list+i, pos_list[i].x, pos_list[i].y);
+    if ( frame == 100 )
+      u8g2_ShowSprite(&u8g2, &layer, sprite_list+2, 0);
+    if ( frame == 200 )
+      u8g2_ShowSprite(&u8g2, &layer, sprite_list+2, 1);
+    u8g2_UpdateLayer(&u8g2, &layer);
+    
+    draw_full(&ref, sprite_list);
+    if ( memcmp(ram, ref_buf, sizeof(ram)) != 0 )
+      errors++;
+  }
+  
+  printf("%-28s full redraw: %7.0f fps %5.1f tiles/frame %4.0f fps@i2c   layer: %7.0f fps %5.1f tiles/frame %4.0f fps@i2c   %s\n", 
+    name, 
+    fps_full, (double)tiles_full/FRAMES, fps_i2c(fps_full, tiles_full), 
+    fps_layer, (double)tiles_layer/FRAMES, fps_i2c(fps_layer, tiles_layer), 
+    errors == 0 ? "ok" : "FAIL");
+  return errors != 0;
+}
+
+int main(void)
+{
+  int err = 0;
+  err |= bench("vertical_top_lsb", 8, u8g2_ll_hvline_vertical_top_lsb);
+  err |= bench("horizontal_right_lsb", 8, u8g2_ll_hvline_horizontal_right_lsb);
+  err |= bench("vertical_top_lsb, page (2)", 2, u8g2_ll_hvline_vertical_top_lsb);
+  return err;
+}
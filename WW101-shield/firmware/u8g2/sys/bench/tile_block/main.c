@@ -0,0 +1,257 @@
+/*
+  Full frame transfer with U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK (SSD1306
+  horizontal addressing mode) against one DRAW_TILE message per tile row.
+  
+  The bus time is simulated (../common/u8x8_byte_sim.c): I2C with 400 kHz 
+  and 4-wire SPI with 8 MHz. The byte procedure also emulates the SSD1306 
+  memory, which must be identical to the frame buffer after each frame.
+  A tile block which exceeds the bottom of the display must not wrap
+  around to the top.
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+
+#define FRAMES 10
+
+/* ../common/u8x8_byte_sim.c */
+struct u8x8_sim_struct
+{
+  unsigned long long now_ns;
+  unsigned long long done_ns;
+  unsigned long long wait_ns;
+  unsigned long bit_ns;
+  unsigned long transfers;
+  unsigned long bytes;
+  unsigned long submits;
+  unsigned long checksum;
+  uint8_t is_i2c;
+  uint8_t is_async;
+  uint8_t dc;
+  void *pending;
+  u8x8_t *pending_u8x8;
+};
+extern struct u8x8_sim_struct u8x8_sim;
+extern void u8x8_sim_Init(uint8_t is_i2c, unsigned long clock_khz, uint8_t is_async);
+extern uint8_t u8x8_byte_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+/*=========================================*/
+/* SSD1306 memory */
+
+static uint8_t ram[8][128];
+static uint8_t col, page, col_start, col_end = 127, page_start, page_end = 7;
+static uint8_t addr_mode;	/* 0: horizontal, 2: page */
+static uint8_t cmd, arg_list[6], arg_pos, arg_cnt;
+
+static uint8_t emu_arg_cnt(uint8_t c)
+{
+  switch(c)
+  {
+    case 0x20: case 0x81: case 0x8d: case 0xa8: case 0xd3: 
+    case 0xd5: case 0xd9: case 0xda: case 0xdb:
+      return 1;
+    case 0x21: case 0x22: case 0xa3:
+      return 2;
+    case 0x29: case 0x2a:
+      return 5;
+    case 0x26: case 0x27:
+      return 6;
+  }
+  return 0;
+}
+
+static void emu_cmd(uint8_t c)
+{
+  if ( arg_pos < arg_cnt )
+  {
+    arg_list[arg_pos++] = c;
+    if ( arg_pos < arg_cnt )
+      return;
+    switch(cmd)
+    {
+      case 0x20: addr_mode = arg_list[0] & 3; break;
+      case 0x21: col_start = arg_list[0] & 127; col_end = arg_list[1] & 127; col = col_start; break;
+      case 0x22: page_start = arg_list[0] & 7; page_end = arg_list[1] & 7; page = page_start; break;
+    }
+    return;
+  }
+  cmd = c;
+  arg_pos = 0;
+  arg_cnt = emu_arg_cnt(c);
+  if ( c < 0x10 )
+    col = (col & 0xf0) | (c & 15);
+  else if ( c < 0x20 )
+    col = (col & 0x0f) | ((c & 7) << 4);
+  else if ( c >= 0xb0 && c <= 0xb7 )
+    page = c & 7;
+}
+
+static void emu_data(uint8_t d)
+{
+  ram[page][col] = d;
+  if ( addr_mode == 0 )
+  {
+    col++;
+    if ( col > col_end )
+    {
+      col = col_start;
+      page = page >= page_end ? page_start : page+1;
+    }
+  }
+  else
+  {
+    col = (col+1) & 127;
+  }
+}
+
+static uint8_t is_control, is_single, is_data;
+
+uint8_t u8x8_byte_emu(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  uint8_t *p = (uint8_t *)arg_ptr;
+  uint8_t i;
+  switch(msg)
+  {
+    case U8X8_MSG_BYTE_START_TRANSFER:
+      is_control = 1;
+      break;
+    case U8X8_MSG_BYTE_SET_DC:
+      is_data = arg_int;
+      break;
+    case U8X8_MSG_BYTE_SEND:
+      for( i = 0; i < arg_int; i++ )
+      {
+	if ( u8x8_sim.is_i2c && is_control )
+	{
+	  /* SSD13xx i2c control byte */
+	  is_single = (p[i] & 0x80) ? 1 : 0;
+	  is_data = (p[i] & 0x40) ? 1 : 0;
+	  is_control = 0;
+	  continue;
+	}
+	if ( is_data )
+	  emu_data(p[i]);
+	else
+	  emu_cmd(p[i]);
+	if ( u8x8_sim.is_i2c && is_single )
+	  is_control = 1;
+      }
+      break;
+  }
+  return u8x8_byte_sim(u8x8, msg, arg_int, arg_ptr);
+}
+
+uint8_t u8x8_gpio_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+/*=========================================*/
+
+/* same display without DRAW_TILE_BLOCK */
+uint8_t u8x8_d_no_block(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  if ( msg == U8X8_MSG_DISPLAY_DRAW_TILE_BLOCK )
+    return 0;
+  return u8x8_d_ssd1306_128x64_noname(u8x8, msg, arg_int, arg_ptr);
+}
+
+static u8g2_t u8g2;
+static u8g2_t u8g2_ref;
+static uint8_t buf[128*8];
+static uint8_t ref[128*8];
+
+static void draw(u8g2_t *u8g2, uint8_t frame)
+{
+  u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+  u8g2_DrawDisc(u8g2, 20+frame*3, 32, 15, U8G2_DRAW_ALL);
+  u8g2_DrawBox(u8g2, 60, 10+(frame&7), 40, 20);
+  u8g2_DrawLine(u8g2, 0, frame, 127, 63-frame);
+}
+
+/* frame content in the layout of the SSD1306 memory */
+static void draw_ref(uint8_t frame)
+{
+  u8x8_Setup(u8g2_GetU8x8(&u8g2_ref), u8x8_d_ssd1306_128x64_noname, u8x8_cad_001, u8x8_gpio_null, u8x8_gpio_null);
+  u8g2_SetupBuffer(&u8g2_ref, ref, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+  u8g2_ClearBuffer(&u8g2_ref);
+  draw(&u8g2_ref, frame);
+}
+
+static int run(const char *name, uint8_t is_i2c, u8x8_msg_cb display_cb, uint8_t page_rows)
+{
+  unsigned long long t = 0;
+  unsigned long bytes = 0, transfers = 0;
+  uint8_t frame;
+  int err = 0;
+  
+  u8x8_sim_Init(is_i2c, is_i2c ? 400 : 8000, 0);
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    draw_ref(frame);
+    u8x8_Setup(u8g2_GetU8x8(&u8g2), display_cb, is_i2c ? u8x8_cad_ssd13xx_i2c : u8x8_cad_001, u8x8_byte_emu, u8x8_gpio_null);
+    u8g2_SetupBuffer(&u8g2, buf, page_rows, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+    if ( frame == 0 )
+    {
+      u8g2_InitDisplay(&u8g2);
+      u8g2_SetPowerSave(&u8g2, 0);
+    }
+    
+    u8x8_sim.now_ns = 0;
+    u8x8_sim.bytes = 0;
+    u8x8_sim.transfers = 0;
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      draw(&u8g2, frame);
+    } while( u8g2_NextPage(&u8g2) );
+    t += u8x8_sim.now_ns;
+    bytes += u8x8_sim.bytes;
+    transfers += u8x8_sim.transfers;
+    
+    if ( memcmp(ram, ref, sizeof(ref)) != 0 )
+      err = 1;
+  }
+  printf("%-28s %10.2f %10lu %10lu   %s\n", name, t/1e6/FRAMES, bytes/FRAMES, transfers/FRAMES, err ? "display memory differs" : "ok");
+  return err;
+}
+
+/* 4 rows at tile row 6: only rows 6 and 7 are sent */
+static int check_bottom(void)
+{
+  static uint8_t tiles[4*128];
+  static const uint8_t zero[128];
+  uint8_t i;
+  int err = 0;
+  
+  for( i = 0; i < 4; i++ )
+    memset(tiles + i*128, 0x11*(i+1), 128);
+  u8x8_sim_Init(1, 400, 0);
+  u8x8_Setup(u8g2_GetU8x8(&u8g2), u8x8_d_ssd1306_128x64_noname, u8x8_cad_ssd13xx_i2c, u8x8_byte_emu, u8x8_gpio_null);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  memset(ram, 0, sizeof(ram));
+  u8x8_DrawTileBlock(u8g2_GetU8x8(&u8g2), 0, 6, 16, 4, tiles);
+  for( i = 0; i < 8; i++ )
+    if ( memcmp(ram[i], i < 6 ? zero : tiles + (i-6)*128, 128) != 0 )
+      err = 1;
+  printf("%-28s %s\n", "tile block below bottom", err ? "display memory differs" : "ok");
+  return err;
+}
+
+int main(void)
+{
+  int err = 0;
+  printf("%-28s %10s %10s %10s\n", "", "ms/frame", "bytes", "transfers");
+  err += run("i2c full buffer, tile rows", 1, u8x8_d_no_block, 8);
+  err += run("i2c full buffer, tile block", 1, u8x8_d_ssd1306_128x64_noname, 8);
+  err += run("i2c 4 row pages, tile rows", 1, u8x8_d_no_block, 4);
+  err += run("i2c 4 row pages, tile block", 1, u8x8_d_ssd1306_128x64_noname, 4);
+  err += run("spi full buffer, tile rows", 0, u8x8_d_no_block, 8);
+  err += run("spi full buffer, tile block", 0, u8x8_d_ssd1306_128x64_noname, 8);
+  err += check_bottom();
+  printf("%s\n", err ? "failed" : "ok");
+  return err ? 1 : 0;
+}
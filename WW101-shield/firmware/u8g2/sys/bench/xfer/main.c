@@ -0,0 +1,118 @@
+/*
+  Scatter-gather transfer (U8X8_WITH_XFER) with a simulated I2C bus 
+  (../common/u8x8_byte_sim.c, 400 kHz).
+  
+  Page buffer mode (one tile row per page). The rendering of a page takes
+  a fixed simulated time. Each frame is sent
+    blocking: byte messages, the CPU waits for the bus
+    replay:   recorded segments, the byte procedure does not accept the submit
+    async:    recorded segments are sent in the background while the next page is rendered
+  All three must send the same bytes (checksum).
+  
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+
+#define FRAMES 10
+
+/* ../common/u8x8_byte_sim.c */
+struct u8x8_sim_struct
+{
+  unsigned long long now_ns;
+  unsigned long long done_ns;
+  unsigned long long wait_ns;
+  unsigned long bit_ns;
+  unsigned long transfers;
+  unsigned long bytes;
+  unsigned long submits;
+  unsigned long checksum;
+  uint8_t is_i2c;
+  uint8_t is_async;
+  uint8_t dc;
+  void *pending;
+  u8x8_t *pending_u8x8;
+};
+extern struct u8x8_sim_struct u8x8_sim;
+extern void u8x8_sim_Init(uint8_t is_i2c, unsigned long clock_khz, uint8_t is_async);
+extern void u8x8_sim_Advance(unsigned long long ns);
+extern uint8_t u8x8_byte_sim(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
+uint8_t u8x8_gpio_null(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+static u8g2_t u8g2;
+static uint8_t buf[128];
+static u8x8_xfer_t xfer;
+static u8x8_xfer_seg_t seg_list[16];
+static uint8_t pool[256];
+
+static void draw(uint8_t frame)
+{
+  u8g2_DrawFrame(&u8g2, 0, 0, 128, 64);
+  u8g2_DrawDisc(&u8g2, 20+frame, 32, 15, U8G2_DRAW_ALL);
+  u8g2_DrawBox(&u8g2, 60, 10+(frame&7), 40, 20);
+}
+
+enum { MODE_BLOCKING, MODE_REPLAY, MODE_ASYNC };
+static const char *mode_name[3] = { "blocking", "replay", "async" };
+
+/* returns ms per frame */
+static double run(int mode, unsigned long render_us)
+{
+  uint8_t frame;
+  
+  u8x8_sim_Init(1, 400, mode == MODE_ASYNC);
+  u8x8_Setup(u8g2_GetU8x8(&u8g2), u8x8_d_ssd1306_128x64_noname, u8x8_cad_ssd13xx_i2c, u8x8_byte_sim, u8x8_gpio_null);
+  u8g2_SetupBuffer(&u8g2, buf, 1, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+  if ( mode != MODE_BLOCKING )
+    u8x8_SetXfer(u8g2_GetU8x8(&u8g2), &xfer, seg_list, sizeof(seg_list)/sizeof(*seg_list), pool, sizeof(pool));
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  u8x8_sim.now_ns = 0;
+  u8x8_sim.wait_ns = 0;
+  
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      u8x8_sim_Advance(render_us*1000ULL);
+      draw(frame);
+    } while( u8g2_NextPage(&u8g2) );
+  }
+  u8x8_WaitXfer(u8g2_GetU8x8(&u8g2));
+  return u8x8_sim.now_ns / 1e6 / FRAMES;
+}
+
+int main(void)
+{
+  static const unsigned long render_us_list[] = { 500, 1000, 3000, 6000 };
+  unsigned i;
+  int mode, err = 0;
+  unsigned long checksum = 0;
+  double ms;
+  
+  printf("%-10s %10s %10s %10s %10s %10s\n", "render/page", "mode", "ms/frame", "wait ms", "transfers", "submits");
+  for( i = 0; i < sizeof(render_us_list)/sizeof(*render_us_list); i++ )
+  {
+    for( mode = MODE_BLOCKING; mode <= MODE_ASYNC; mode++ )
+    {
+      ms = run(mode, render_us_list[i]);
+      printf("%8lu us %10s %10.2f %10.2f %10lu %10lu\n", render_us_list[i], mode_name[mode], ms, 
+	u8x8_sim.wait_ns/1e6/FRAMES, u8x8_sim.transfers, u8x8_sim.submits);
+      if ( mode == MODE_BLOCKING )
+	checksum = u8x8_sim.checksum;
+      else if ( checksum != u8x8_sim.checksum )
+      {
+	printf("checksum mismatch\n");
+	err++;
+      }
+    }
+  }
+  printf("%s\n", err ? "failed" : "ok");
+  return err ? 1 : 0;
+}
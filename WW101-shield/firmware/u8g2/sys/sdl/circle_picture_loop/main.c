@@ -0,0 +1,69 @@
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <time.h>
+
+/*
+  Animated circles, discs and ellipses.
+  Prints the time for the draw procedures (without the transfer to 
+  the SDL window) every 100 frames. Press 'q' to quit.
+*/
+  
+u8g2_t u8g2;
+
+void draw(uint16_t frame)
+{
+  u8g2_uint_t i;
+  
+  for( i = 0; i < 4; i++ )
+  {
+    u8g2_DrawCircle(&u8g2, 16+i*32, 16, 4+((frame+i*5)&7), U8G2_DRAW_ALL);
+    u8g2_DrawDisc(&u8g2, 16+i*32, 48, 4+((frame+i*3)&11), U8G2_DRAW_ALL);
+  }
+  u8g2_DrawEllipse(&u8g2, 64, 32, 60, 4+(frame&31), U8G2_DRAW_ALL);
+  u8g2_SetDrawColor(&u8g2, 2);
+  u8g2_DrawFilledEllipse(&u8g2, (frame*3)&127, 32, 20, 12, U8G2_DRAW_ALL);
+  u8g2_SetDrawColor(&u8g2, 1);
+  /* partly outside of the display */
+  u8g2_DrawDisc(&u8g2, 0, 0, 20, U8G2_DRAW_ALL);
+}
+
+int main(void)
+{
+  uint16_t frame = 0;
+  clock_t t, draw_time = 0;
+  
+  u8g2_SetupBuffer_SDL_128x64_4(&u8g2, &u8g2_cb_r0);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  u8x8_SetPowerSave(u8g2_GetU8x8(&u8g2), 0);  
+  
+  for(;;)
+  {
+#ifdef U8G2_WITH_HVLINE_COUNT
+    u8g2.hv_cnt = 0UL;
+#endif /* U8G2_WITH_HVLINE_COUNT */   
+    
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      t = clock();
+      draw(frame);
+      draw_time += clock() - t;
+    } while( u8g2_NextPage(&u8g2) );
+    
+    frame++;
+    if ( (frame % 100) == 0 )
+    {
+      printf("draw: %.1f us/frame", (double)draw_time*1000000.0/CLOCKS_PER_SEC/100);
+#ifdef U8G2_WITH_HVLINE_COUNT
+      printf(", hv lines: %lu", u8g2.hv_cnt);
+#endif /* U8G2_WITH_HVLINE_COUNT */   
+      printf("\n");
+      draw_time = 0;
+    }
+    
+    if ( u8g_sdl_get_key() == 'q' )
+      break;
+  }
+  return 0;
+}
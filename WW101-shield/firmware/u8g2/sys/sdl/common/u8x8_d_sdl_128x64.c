@@ -204,7 +204,8 @@ static const u8x8_display_info_t u8x8_sdl_128x64_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ 128,
-  /* pixel_height = */ 64
+  /* pixel_height = */ 64,
+  /* flags = */ 0
 };
 
 
@@ -314,6 +315,38 @@ void u8x8_Setup_SDL_128x64(u8x8_t *u8x8)
   u8x8_SetupMemory(u8x8);  
 }
 
+#ifdef U8G2_WITH_PROFILE
+/* 
+  With U8G2_WITH_PROFILE and the environment variable U8G2_PROFILE, 
+  a report is printed for each frame. Cycles are nanoseconds.
+*/
+#include <stdlib.h>
+#include <time.h>
+
+static u8g2_profile_t sdl_profile;
+
+static uint32_t sdl_profile_get_cycles(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)ts.tv_sec*1000000000UL + (uint32_t)ts.tv_nsec;
+}
+
+static void sdl_profile_frame(u8g2_t *u8g2, u8g2_profile_t *profile)
+{
+  u8g2_PrintProfile(profile);
+}
+
+static void sdl_setup_profile(u8g2_t *u8g2)
+{
+  if ( getenv("U8G2_PROFILE") == NULL )
+    return;
+  sdl_profile.get_cycles = sdl_profile_get_cycles;
+  sdl_profile.frame_cb = sdl_profile_frame;
+  u8g2_SetProfile(u8g2, &sdl_profile);
+}
+#endif /* U8G2_WITH_PROFILE */
+
 void u8g2_SetupBuffer_SDL_128x64(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb)
 {
   
@@ -321,6 +354,9 @@ void u8g2_SetupBuffer_SDL_128x64(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb)
   
   u8x8_Setup_SDL_128x64(u8g2_GetU8x8(u8g2));
   u8g2_SetupBuffer(u8g2, buf, 8, u8g2_ll_hvline_vertical_top_lsb, u8g2_cb);
+#ifdef U8G2_WITH_PROFILE
+  sdl_setup_profile(u8g2);
+#endif
 }
 
 
@@ -331,6 +367,9 @@ void u8g2_SetupBuffer_SDL_128x64_4(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb)
   
   u8x8_Setup_SDL_128x64(u8g2_GetU8x8(u8g2));
   u8g2_SetupBuffer(u8g2, buf, 3, u8g2_ll_hvline_vertical_top_lsb, u8g2_cb);
+#ifdef U8G2_WITH_PROFILE
+  sdl_setup_profile(u8g2);
+#endif
 }
 
 
@@ -0,0 +1,136 @@
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+/*
+  Moving sprites on a static background, drawn in two ways:
+    1) full redraw: background and all sprites for each frame, send the complete buffer
+    2) layer (u8g2_sprite.c): only the dirty tiles are composed and sent
+  The achieved frame rate of both methods is printed.
+  Press 'q' to quit.
+*/
+
+#define SPRITE_CNT 6
+#define FRAMES 300
+
+u8g2_t u8g2;
+u8g2_t bg;
+uint8_t bg_buf[128*8];
+u8g2_layer_t layer;
+u8g2_sprite_t sprite_list[SPRITE_CNT];
+uint8_t dirty[U8G2_LAYER_DIRTY_SIZE(16, 8)];
+int16_t dx[SPRITE_CNT], dy[SPRITE_CNT];
+int16_t px[SPRITE_CNT], py[SPRITE_CNT];
+
+static const uint8_t ball_bits[] = {
+  0xe0, 0x07, 0xf8, 0x1f, 0xfc, 0x3f, 0xfe, 0x7f, 0xce, 0x7f, 0x87, 0xff,
+  0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf7, 0xfe, 0x7b,
+  0xfe, 0x7c, 0xfc, 0x3f, 0xf8, 0x1f, 0xe0, 0x07 };
+
+double get_time(void)
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec/1000000.0;
+}
+
+void draw_background(u8g2_t *u8g2)
+{
+  u8g2_uint_t i;
+  u8g2_ClearBuffer(u8g2);
+  u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+  for( i = 8; i < 128; i += 16 )
+    u8g2_DrawVLine(u8g2, i, 1, 62);
+  for( i = 8; i < 64; i += 16 )
+    u8g2_DrawHLine(u8g2, 1, i, 126);
+  u8g2_DrawDisc(u8g2, 64, 32, 14, U8G2_DRAW_ALL);
+}
+
+void init_sprites(void)
+{
+  int i;
+  for( i = 0; i < SPRITE_CNT; i++ )
+  {
+    u8g2_SetSprite(sprite_list+i, 16, 16, ball_bits);
+    px[i] = 5 + i*19;
+    py[i] = 3 + i*7;
+    dx[i] = (i % 3) + 1;
+    dy[i] = 2 - (i % 2)*3;
+    sprite_list[i].x = px[i];
+    sprite_list[i].y = py[i];
+  }
+}
+
+void step_sprites(void)
+{
+  int i;
+  for( i = 0; i < SPRITE_CNT; i++ )
+  {
+    px[i] += dx[i];
+    py[i] += dy[i];
+    if ( px[i] < 0 || px[i] > 128-16 )
+    {
+      dx[i] = -dx[i];
+      px[i] += 2*dx[i];
+    }
+    if ( py[i] < 0 || py[i] > 64-16 )
+    {
+      dy[i] = -dy[i];
+      py[i] += 2*dy[i];
+    }
+  }
+}
+
+int main(void)
+{
+  int i, frame;
+  double t, fps_full, fps_layer;
+  
+  /* background: drawn once into a second buffer */
+  u8x8_Setup_SDL_128x64(u8g2_GetU8x8(&bg));
+  u8g2_SetupBuffer(&bg, bg_buf, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+  draw_background(&bg);
+  
+  u8g2_SetupBuffer_SDL_128x64(&u8g2, &u8g2_cb_r0);
+  u8x8_InitDisplay(u8g2_GetU8x8(&u8g2));
+  u8x8_SetPowerSave(u8g2_GetU8x8(&u8g2), 0);  
+  
+  /* 1) full redraw */
+  init_sprites();
+  t = get_time();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    step_sprites();
+    memcpy(u8g2_GetBufferPtr(&u8g2), bg_buf, sizeof(bg_buf));
+    for( i = 0; i < SPRITE_CNT; i++ )
+      u8g2_DrawXBM(&u8g2, px[i], py[i], 16, 16, ball_bits);
+    u8g2_SendBuffer(&u8g2);
+    if ( u8g_sdl_get_key() == 'q' )
+      return 0;
+  }
+  fps_full = FRAMES / (get_time() - t);
+  
+  /* 2) layer */
+  init_sprites();
+  u8g2_InitLayer(&u8g2, &layer, bg_buf, sprite_list, SPRITE_CNT, dirty);
+  u8g2_UpdateLayer(&u8g2, &layer);
+  t = get_time();
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    step_sprites();
+    for( i = 0; i < SPRITE_CNT; i++ )
+      u8g2_MoveSprite(&u8g2, &layer, sprite_list+i, px[i], py[i]);
+    u8g2_UpdateLayer(&u8g2, &layer);
+    if ( u8g_sdl_get_key() == 'q' )
+      return 0;
+  }
+  fps_layer = FRAMES / (get_time() - t);
+  
+  printf("full redraw: %.1f fps, layer: %.1f fps\n", fps_full, fps_layer);
+  
+  while( u8g_sdl_get_key() != 'q' )
+    ;
+  return 0;
+}
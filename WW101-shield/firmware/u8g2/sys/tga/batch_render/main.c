@@ -0,0 +1,206 @@
+/*
+  Render a batch of screenshots in parallel threads.
+
+  Each job (scene x rotation) has its own u8g2 object, its own frame
+  buffer and its own tga canvas (user_ptr of the u8x8 structure), so
+  that no state is shared between the threads. The batch is rendered
+  once with one thread and once with all threads; the checksums of
+  both runs must be identical.
+
+  Build and run: make test
+  Usage: batch_render [threads] [-s]
+    -s: save one tga file per job (batch_<scene>_r<rotation>.tga)
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define FRAMES 50
+
+/* u8x8_d_tga.c */
+typedef struct tga_canvas_struct tga_canvas_t;
+extern tga_canvas_t *tga_canvas_new(void);
+extern void tga_canvas_delete(tga_canvas_t *c);
+extern void tga_canvas_save(tga_canvas_t *c, const char *name);
+extern void u8x8_Setup_TGA_LCD(u8x8_t *u8x8);
+
+static const uint8_t xbm_logo[] = {
+  0xff, 0xff, 0x01, 0x80, 0x3d, 0xbc, 0x25, 0xa4, 0x25, 0xa4, 0x3d, 0xbc,
+  0x01, 0x80, 0x81, 0x81, 0x81, 0x81, 0x01, 0x80, 0x11, 0x88, 0x21, 0x84,
+  0xc1, 0x83, 0x01, 0x80, 0x01, 0x80, 0xff, 0xff };
+
+void draw_boxes(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t i;
+  for( i = 0; i < 8; i++ )
+    u8g2_DrawFrame(u8g2, i*4, i*4, 64-i*8+((frame+i)&15), 64-i*8);
+  u8g2_DrawRBox(u8g2, 70, 4, 50, 24, 6);
+  u8g2_DrawBox(u8g2, 70+(frame&31), 40, 16, 16);
+}
+
+void draw_circles(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t i;
+  for( i = 0; i < 8; i++ )
+    u8g2_DrawCircle(u8g2, 8+i*16, 32, 4+((frame+i)&15), U8G2_DRAW_ALL);
+  u8g2_DrawFilledEllipse(u8g2, 64, 32, 20, 4+(frame&7), U8G2_DRAW_ALL);
+}
+
+void draw_lines(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t i;
+  for( i = 0; i < 16; i++ )
+    u8g2_DrawLine(u8g2, (i*8+frame)&127, 0, 127-i*8, 63);
+  u8g2_DrawTriangle(u8g2, 10, 60, 60, 2+(frame&31), 110, 60);
+}
+
+void draw_bitmaps(u8g2_t *u8g2, uint16_t frame)
+{
+  u8g2_uint_t x, y;
+  for( y = 0; y < 64; y += 16 )
+    for( x = 0; x < 128; x += 16 )
+      if ( ((x+y)/16 + frame) & 1 )
+	u8g2_DrawXBM(u8g2, x, y, 16, 16, xbm_logo);
+}
+
+struct scene
+{
+  const char *name;
+  void (*draw)(u8g2_t *u8g2, uint16_t frame);
+};
+
+static const struct scene scene_list[] = {
+  { "boxes", draw_boxes },
+  { "circles", draw_circles },
+  { "lines", draw_lines },
+  { "bitmaps", draw_bitmaps }
+};
+
+#define SCENE_CNT (sizeof(scene_list)/sizeof(*scene_list))
+
+static const u8g2_cb_t *rotation_list[4] = { U8G2_R0, U8G2_R1, U8G2_R2, U8G2_R3 };
+
+#define JOB_CNT (SCENE_CNT*4)
+
+struct job
+{
+  u8g2_t u8g2;		/* one u8g2 object per job: nothing is shared */
+  uint8_t buf[128*64/8];
+  tga_canvas_t *canvas;
+  uint32_t checksum;	/* over the frame buffer of all frames */
+};
+
+static struct job job_list[JOB_CNT];
+static unsigned next_job;
+static pthread_mutex_t next_job_mutex = PTHREAD_MUTEX_INITIALIZER;
+static int is_save = 0;
+
+void render_job(unsigned n)
+{
+  struct job *job = job_list+n;
+  const struct scene *scene = scene_list + n/4;
+  u8g2_t *u8g2 = &(job->u8g2);
+  uint16_t frame;
+  unsigned i;
+  char name[64];
+
+  job->canvas = tga_canvas_new();
+  u8x8_Setup_TGA_LCD(u8g2_GetU8x8(u8g2));
+  u8g2_SetUserPtr(u8g2, job->canvas);
+  u8g2_SetupBuffer(u8g2, job->buf, 8, u8g2_ll_hvline_vertical_top_lsb, rotation_list[n&3]);
+  u8g2_InitDisplay(u8g2);
+  u8g2_SetPowerSave(u8g2, 0);
+
+  job->checksum = 0;
+  for( frame = 0; frame < FRAMES; frame++ )
+  {
+    u8g2_ClearBuffer(u8g2);
+    scene->draw(u8g2, frame);
+    u8g2_SendBuffer(u8g2);
+    for( i = 0; i < sizeof(job->buf); i++ )
+      job->checksum = job->checksum*31 + job->buf[i];
+  }
+
+  if ( is_save )
+  {
+    sprintf(name, "batch_%s_r%u.tga", scene->name, n&3);
+    tga_canvas_save(job->canvas, name);
+  }
+  tga_canvas_delete(job->canvas);
+}
+
+void *worker(void *arg)
+{
+  unsigned n;
+  for(;;)
+  {
+    pthread_mutex_lock(&next_job_mutex);
+    n = next_job++;
+    pthread_mutex_unlock(&next_job_mutex);
+    if ( n >= JOB_CNT )
+      break;
+    render_job(n);
+  }
+  return NULL;
+}
+
+double render_batch(unsigned thread_cnt, uint32_t *checksum_list)
+{
+  pthread_t thread_list[64];
+  struct timespec t0, t1;
+  unsigned i;
+
+  next_job = 0;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for( i = 0; i < thread_cnt; i++ )
+    pthread_create(thread_list+i, NULL, worker, NULL);
+  for( i = 0; i < thread_cnt; i++ )
+    pthread_join(thread_list[i], NULL);
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+
+  for( i = 0; i < JOB_CNT; i++ )
+    checksum_list[i] = job_list[i].checksum;
+  return (t1.tv_sec-t0.tv_sec) + (t1.tv_nsec-t0.tv_nsec)/1e9;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t serial_checksum[JOB_CNT];
+  uint32_t parallel_checksum[JOB_CNT];
+  unsigned thread_cnt;
+  double ts, tp;
+  int i;
+
+  thread_cnt = (unsigned)sysconf(_SC_NPROCESSORS_ONLN);
+  for( i = 1; i < argc; i++ )
+  {
+    if ( strcmp(argv[i], "-s") == 0 )
+      is_save = 1;
+    else
+      thread_cnt = (unsigned)atoi(argv[i]);
+  }
+  if ( thread_cnt < 1 )
+    thread_cnt = 1;
+  if ( thread_cnt > 64 )
+    thread_cnt = 64;
+
+  ts = render_batch(1, serial_checksum);
+  tp = render_batch(thread_cnt, parallel_checksum);
+
+  printf("%u jobs, %d frames each\n", (unsigned)JOB_CNT, FRAMES);
+  printf("1 thread:   %8.3f s\n", ts);
+  printf("%u threads: %8.3f s (speedup %.2f)\n", thread_cnt, tp, ts/tp);
+
+  if ( memcmp(serial_checksum, parallel_checksum, sizeof(serial_checksum)) != 0 )
+  {
+    printf("checksum mismatch between serial and parallel rendering\n");
+    return 1;
+  }
+  printf("checksums ok\n");
+  return 0;
+}
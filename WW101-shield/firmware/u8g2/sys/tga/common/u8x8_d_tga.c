@@ -14,19 +14,24 @@
 uint16_t tga_max_x;
 uint16_t tga_max_y;
 
-static uint16_t tga_width;
-static uint16_t tga_height;
-static uint8_t *tga_data = NULL;
-
-uint8_t tga_is_transparent = 0;
+/*
+  One tga_canvas_t holds one picture. u8x8_d_tga_desc and u8x8_d_tga_lcd draw into 
+  the canvas from the user_ptr of the u8x8 object (requires U8X8_WITH_USER_PTR). 
+  Without user_ptr, the default canvas is used, which is also the target for 
+  tga_init() and tga_save(). Different canvas objects can be drawn from different threads.
+*/
+typedef struct tga_canvas_struct
+{
+  uint16_t width;
+  uint16_t height;
+  uint8_t *data;
+  uint8_t fg_r, fg_g, fg_b;	/* current foreground color */
+  uint8_t bg_r, bg_g, bg_b;	/* current background color */
+} tga_canvas_t;
 
-uint8_t tga_fg_r = 0;
-uint8_t tga_fg_g = 0;
-uint8_t tga_fg_b = 0;
+static tga_canvas_t tga_default_canvas = { 0, 0, NULL, 0, 0, 0, 255, 255, 255 };
 
-uint8_t tga_bg_r = 255;
-uint8_t tga_bg_g = 255;
-uint8_t tga_bg_b = 255;
+uint8_t tga_is_transparent = 0;
 
 uint8_t tga_desc_fg_r = 0;
 uint8_t tga_desc_fg_g = 0;
@@ -44,24 +49,59 @@ uint8_t tga_lcd_bg_r = 255;
 uint8_t tga_lcd_bg_g = 255;
 uint8_t tga_lcd_bg_b = 255;
 
+static tga_canvas_t *tga_get_canvas(u8x8_t *u8x8)
+{
+#ifdef U8X8_WITH_USER_PTR
+  if ( u8x8_GetUserPtr(u8x8) != NULL )
+    return (tga_canvas_t *)u8x8_GetUserPtr(u8x8);
+#endif
+  (void)u8x8;
+  return &tga_default_canvas;
+}
+
+static int tga_canvas_init(tga_canvas_t *c, uint16_t w, uint16_t h)
+{
+  c->width = 0;
+  c->height = 0;
+  if ( c->data != NULL )
+    free(c->data);
+  c->data = (uint8_t *)malloc(w*h*3);
+  if ( c->data == NULL )
+    return 0;
+  c->width = w;
+  c->height = h;
+  memset(c->data, 255, c->width*c->height*3);
+  return 1;
+}
+
+/* returns an empty canvas, the size is set by the display procedure during DISPLAY_INIT */
+tga_canvas_t *tga_canvas_new(void)
+{
+  tga_canvas_t *c = (tga_canvas_t *)malloc(sizeof(tga_canvas_t));
+  if ( c == NULL )
+    return NULL;
+  *c = tga_default_canvas;
+  c->width = 0;
+  c->height = 0;
+  c->data = NULL;
+  return c;
+}
+
+void tga_canvas_delete(tga_canvas_t *c)
+{
+  if ( c->data != NULL )
+    free(c->data);
+  free(c);
+}
+
 int tga_init(uint16_t w, uint16_t h)
 {
   tga_max_x = 0;
   tga_max_y = 0;
-  tga_width = 0;
-  tga_height = 0;
-  if ( tga_data != NULL )
-    free(tga_data);
-  tga_data = (uint8_t *)malloc(w*h*3);
-  if ( tga_data == NULL )
-    return 0;
-  tga_width = w;
-  tga_height = h;
-  memset(tga_data, 255, tga_width*tga_height*3);
-  return 1;
+  return tga_canvas_init(&tga_default_canvas, w, h);
 }
 
-void tga_set_pixel(uint16_t x, uint16_t y, uint16_t f)
+static void tga_set_pixel(tga_canvas_t *c, uint16_t x, uint16_t y, uint16_t f)
 {
   uint8_t *p;
   uint16_t xx,yy;
@@ -69,19 +109,19 @@ void tga_set_pixel(uint16_t x, uint16_t y, uint16_t f)
   {
     for( xx = x; xx < x+f; xx++ )
     {
-      if ( yy < tga_height && xx < tga_width )
+      if ( yy < c->height && xx < c->width )
       {
 	//printf ("(%d %d) ", xx, yy);
-	p = tga_data + (tga_height-yy-1)*tga_width*3 + xx*3;
-	*p++ = tga_fg_b;
-	*p++ = tga_fg_g;
-	*p++ = tga_fg_r;
+	p = c->data + (c->height-yy-1)*c->width*3 + xx*3;
+	*p++ = c->fg_b;
+	*p++ = c->fg_g;
+	*p++ = c->fg_r;
       }
     }
   }
 }
 
-void tga_clr_pixel(uint16_t x, uint16_t y, uint16_t f)
+static void tga_clr_pixel(tga_canvas_t *c, uint16_t x, uint16_t y, uint16_t f)
 {
   uint8_t *p;
   uint16_t xx,yy;
@@ -92,26 +132,26 @@ void tga_clr_pixel(uint16_t x, uint16_t y, uint16_t f)
     for( xx = x; xx < x+f; xx++ )
     {
       
-      p = tga_data + (tga_height-yy-1)*tga_width*3 + xx*3;
-      *p++ = tga_bg_b;
-      *p++ = tga_bg_g;
-      *p++ = tga_bg_r;
+      p = c->data + (c->height-yy-1)*c->width*3 + xx*3;
+      *p++ = c->bg_b;
+      *p++ = c->bg_g;
+      *p++ = c->bg_r;
     }
   }
 }
 
-void tga_set_8pixel(int x, int y, uint8_t pixel, uint16_t f)
+static void tga_set_8pixel(tga_canvas_t *c, int x, int y, uint8_t pixel, uint16_t f)
 {
   int cnt = 8;
   while( cnt > 0 )
   {
     if ( (pixel & 1) != 0 )
     {
-      tga_set_pixel(x,y, f);
+      tga_set_pixel(c, x,y, f);
     }
     else
     {
-      tga_clr_pixel(x,y, f);
+      tga_clr_pixel(c, x,y, f);
     }
     pixel >>= 1;
     y+=f;
@@ -119,13 +159,13 @@ void tga_set_8pixel(int x, int y, uint8_t pixel, uint16_t f)
   }
 }
 
-void tga_set_multiple_8pixel(int x, int y, int cnt, uint8_t *pixel, uint16_t f)
+static void tga_set_multiple_8pixel(tga_canvas_t *c, int x, int y, int cnt, uint8_t *pixel, uint16_t f)
 {
   uint8_t b;
   while( cnt > 0 )
   {
     b = *pixel;
-    tga_set_8pixel(x, y, b, f);
+    tga_set_8pixel(c, x, y, b, f);
     x+=f;
     pixel++;
     cnt--;
@@ -145,13 +185,13 @@ void tga_write_word(FILE *fp, uint16_t word)
   tga_write_byte(fp, word>>8);
 }
 
-void tga_save(const char *name)
+void tga_canvas_save(tga_canvas_t *c, const char *name)
 {
   FILE *fp;
-  if ( tga_data == NULL )
+  if ( c->data == NULL )
     return;
   
-  printf("tga_save: File %s with %dx%d pixel\n", name, tga_width, tga_height);
+  printf("tga_save: File %s with %dx%d pixel\n", name, c->width, c->height);
   
   fp = fopen(name, "wb");
   if ( fp != NULL )
@@ -164,11 +204,11 @@ void tga_save(const char *name)
     tga_write_byte(fp, 0);		
     tga_write_word(fp, 0);		/* x origin */
     tga_write_word(fp, 0);		/* y origin */
-    tga_write_word(fp, tga_width);		/* width */
-    tga_write_word(fp, tga_height);		/* height */
+    tga_write_word(fp, c->width);		/* width */
+    tga_write_word(fp, c->height);		/* height */
     tga_write_byte(fp, 24);		/* color depth */
     tga_write_byte(fp, 0);		
-    fwrite(tga_data, tga_width*tga_height*3, 1, fp);
+    fwrite(c->data, c->width*c->height*3, 1, fp);
     tga_write_word(fp, 0);
     tga_write_word(fp, 0);
     tga_write_word(fp, 0);
@@ -178,6 +218,11 @@ void tga_save(const char *name)
   }
 }
 
+void tga_save(const char *name)
+{
+  tga_canvas_save(&tga_default_canvas, name);
+}
+
 void tga_save_png(const char *name)
 {
   char convert_cmd[1024*2];
@@ -211,7 +256,8 @@ static const u8x8_display_info_t u8x8_tga_desc_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ (2*XOFFSET+DEFAULT_WIDTH),
-  /* pixel_height = */ (2*YOFFSET+DEFAULT_HEIGHT)
+  /* pixel_height = */ (2*YOFFSET+DEFAULT_HEIGHT),
+  /* flags = */ 0
 };
 
 
@@ -219,6 +265,7 @@ uint8_t u8x8_d_tga_desc(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, void *arg_pt
 {
   u8g2_uint_t x, y, c;
   uint8_t *ptr;
+  tga_canvas_t *canvas = tga_get_canvas(u8g2);
   switch(msg)
   {
     case U8X8_MSG_DISPLAY_SETUP_MEMORY:
@@ -226,8 +273,8 @@ uint8_t u8x8_d_tga_desc(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, void *arg_pt
       break;
     case U8X8_MSG_DISPLAY_INIT:
       u8x8_d_helper_display_init(u8g2);
-      if ( tga_data == NULL )
-	tga_init(2*XOFFSET+DEFAULT_WIDTH, 2*YOFFSET+DEFAULT_HEIGHT);
+      if ( canvas->data == NULL )
+	tga_canvas_init(canvas, 2*XOFFSET+DEFAULT_WIDTH, 2*YOFFSET+DEFAULT_HEIGHT);
       break;
     case U8X8_MSG_DISPLAY_SET_POWER_SAVE:
       break;
@@ -237,13 +284,13 @@ uint8_t u8x8_d_tga_desc(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, void *arg_pt
       break;
     case U8X8_MSG_DISPLAY_DRAW_TILE:
       
-      tga_fg_r = tga_desc_fg_r;
-      tga_fg_g = tga_desc_fg_g;
-      tga_fg_b = tga_desc_fg_b;
+      canvas->fg_r = tga_desc_fg_r;
+      canvas->fg_g = tga_desc_fg_g;
+      canvas->fg_b = tga_desc_fg_b;
 
-      tga_bg_r = tga_desc_bg_r;
-      tga_bg_g = tga_desc_bg_g;
-      tga_bg_b = tga_desc_bg_b;
+      canvas->bg_r = tga_desc_bg_r;
+      canvas->bg_g = tga_desc_bg_g;
+      canvas->bg_b = tga_desc_bg_b;
 
     
       x = ((u8x8_tile_t *)arg_ptr)->x_pos;
@@ -259,7 +306,7 @@ uint8_t u8x8_d_tga_desc(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, void *arg_pt
       {
 	c = ((u8x8_tile_t *)arg_ptr)->cnt;
 	ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
-	tga_set_multiple_8pixel(x, y, c*8, ptr, 1);
+	tga_set_multiple_8pixel(canvas, x, y, c*8, ptr, 1);
 	arg_int--;
 	x += c*8;
       } while( arg_int > 0 );
@@ -284,12 +331,47 @@ void u8x8_Setup_TGA_DESC(u8x8_t *u8x8)
   u8x8_SetupMemory(u8x8);  
 }
 
+#ifdef U8G2_WITH_PROFILE
+/* 
+  With U8G2_WITH_PROFILE and the environment variable U8G2_PROFILE, 
+  a report is printed for each frame. Cycles are nanoseconds.
+*/
+#include <stdlib.h>
+#include <time.h>
+
+static u8g2_profile_t tga_profile;
+
+static uint32_t tga_profile_get_cycles(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)ts.tv_sec*1000000000UL + (uint32_t)ts.tv_nsec;
+}
+
+static void tga_profile_frame(u8g2_t *u8g2, u8g2_profile_t *profile)
+{
+  u8g2_PrintProfile(profile);
+}
+
+static void tga_setup_profile(u8g2_t *u8g2)
+{
+  if ( getenv("U8G2_PROFILE") == NULL )
+    return;
+  tga_profile.get_cycles = tga_profile_get_cycles;
+  tga_profile.frame_cb = tga_profile_frame;
+  u8g2_SetProfile(u8g2, &tga_profile);
+}
+#endif /* U8G2_WITH_PROFILE */
+
 void u8g2_SetupBuffer_TGA_DESC(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb)
 {
   static uint8_t buf[(XOFFSET+DEFAULT_WIDTH)*8];
   
   u8x8_Setup_TGA_DESC(u8g2_GetU8x8(u8g2));
   u8g2_SetupBuffer(u8g2, buf, 1, u8g2_ll_hvline_vertical_top_lsb, u8g2_cb);
+#ifdef U8G2_WITH_PROFILE
+  tga_setup_profile(u8g2);
+#endif
 }
 
 /*==========================================*/
@@ -317,7 +399,8 @@ static const u8x8_display_info_t u8x8_tga_lcd_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ (DEFAULT_WIDTH)/FACTOR,
-  /* pixel_height = */ (DEFAULT_HEIGHT)/FACTOR
+  /* pixel_height = */ (DEFAULT_HEIGHT)/FACTOR,
+  /* flags = */ 0
 };
 
 
@@ -325,6 +408,7 @@ uint8_t u8x8_d_tga_lcd(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, void *arg_ptr
 {
   u8g2_uint_t x, y, c;
   uint8_t *ptr;
+  tga_canvas_t *canvas = tga_get_canvas(u8g2);
   switch(msg)
   {
     case U8X8_MSG_DISPLAY_SETUP_MEMORY:
@@ -332,8 +416,8 @@ uint8_t u8x8_d_tga_lcd(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, void *arg_ptr
       break;
     case U8X8_MSG_DISPLAY_INIT:
       u8x8_d_helper_display_init(u8g2);
-      if ( tga_data == NULL )
-	tga_init(2*XOFFSET+DEFAULT_WIDTH, 2*YOFFSET+DEFAULT_HEIGHT);
+      if ( canvas->data == NULL )
+	tga_canvas_init(canvas, 2*XOFFSET+DEFAULT_WIDTH, 2*YOFFSET+DEFAULT_HEIGHT);
       break;
     case U8X8_MSG_DISPLAY_SET_POWER_SAVE:
       break;
@@ -343,13 +427,13 @@ uint8_t u8x8_d_tga_lcd(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, void *arg_ptr
       break;
     case U8X8_MSG_DISPLAY_DRAW_TILE:
 
-      tga_fg_r = tga_lcd_fg_r;
-      tga_fg_g = tga_lcd_fg_g;
-      tga_fg_b = tga_lcd_fg_b;
+      canvas->fg_r = tga_lcd_fg_r;
+      canvas->fg_g = tga_lcd_fg_g;
+      canvas->fg_b = tga_lcd_fg_b;
 
-      tga_bg_r = tga_lcd_bg_r;
-      tga_bg_g = tga_lcd_bg_g;
-      tga_bg_b = tga_lcd_bg_b;
+      canvas->bg_r = tga_lcd_bg_r;
+      canvas->bg_g = tga_lcd_bg_g;
+      canvas->bg_b = tga_lcd_bg_b;
     
       x = ((u8x8_tile_t *)arg_ptr)->x_pos;
       //printf("U8X8_MSG_DISPLAY_DRAW_TILE x=%d, ", x);
@@ -368,7 +452,7 @@ uint8_t u8x8_d_tga_lcd(u8x8_t *u8g2, uint8_t msg, uint8_t arg_int, void *arg_ptr
       {
 	c = ((u8x8_tile_t *)arg_ptr)->cnt;
 	ptr = ((u8x8_tile_t *)arg_ptr)->tile_ptr;
-	tga_set_multiple_8pixel(x, y, c*8, ptr, FACTOR);
+	tga_set_multiple_8pixel(canvas, x, y, c*8, ptr, FACTOR);
 	arg_int--;
 	x += c*8*FACTOR;
       } while( arg_int > 0 );
@@ -399,6 +483,9 @@ void u8g2_SetupBuffer_TGA_LCD(u8g2_t *u8g2, const u8g2_cb_t *u8g2_cb)
   
   u8x8_Setup_TGA_LCD(u8g2_GetU8x8(u8g2));
   u8g2_SetupBuffer(u8g2, buf, 1, u8g2_ll_hvline_vertical_top_lsb, u8g2_cb);
+#ifdef U8G2_WITH_PROFILE
+  tga_setup_profile(u8g2);
+#endif
 }
 
 
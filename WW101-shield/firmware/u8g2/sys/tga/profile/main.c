@@ -0,0 +1,72 @@
+/*
+  Profiler example: draw some frames with the picture loop (one tile row
+  per page) and with a full buffer. With the environment variable
+  U8G2_PROFILE, u8g2_SetupBuffer_TGA_LCD() assigns a profile, which
+  prints a report after each frame.
+
+  Build and run: make test
+*/
+
+#include "u8g2.h"
+#include <stdio.h>
+
+static const uint8_t xbm_logo[] = {
+  0xff, 0xff, 0x01, 0x80, 0x3d, 0xbc, 0x25, 0xa4, 0x25, 0xa4, 0x3d, 0xbc,
+  0x01, 0x80, 0x81, 0x81, 0x81, 0x81, 0x01, 0x80, 0x11, 0x88, 0x21, 0x84,
+  0xc1, 0x83, 0x01, 0x80, 0x01, 0x80, 0xff, 0xff };
+
+u8g2_t u8g2;
+
+void draw(uint8_t frame)
+{
+  u8g2_uint_t i;
+  u8g2_DrawFrame(&u8g2, 0, 0, 128, 64);
+  u8g2_DrawRBox(&u8g2, 4, 4, 40, 20, 5);
+  u8g2_DrawDisc(&u8g2, 90, 20, 12+frame, U8G2_DRAW_ALL);
+  u8g2_DrawEllipse(&u8g2, 64, 45, 30, 10, U8G2_DRAW_ALL);
+  u8g2_DrawTriangle(&u8g2, 5, 60, 30, 30, 55, 60);
+  for( i = 0; i < 8; i++ )
+    u8g2_DrawLine(&u8g2, 64+i*8, 63, 127, 30+i*4);
+  u8g2_DrawXBM(&u8g2, 100+frame*8, 40, 16, 16, xbm_logo);
+}
+
+int main(void)
+{
+  uint8_t frame;
+  static uint8_t buf[128*8];
+  
+  /* picture loop, 8 pages */
+  u8g2_SetupBuffer_TGA_LCD(&u8g2, &u8g2_cb_r0);
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+  for( frame = 0; frame < 2; frame++ )
+  {
+    u8g2_FirstPage(&u8g2);
+    do
+    {
+      draw(frame);
+    } while( u8g2_NextPage(&u8g2) );
+  }
+  
+  /* full buffer: the same display, but with a buffer for all 8 tile rows */
+#ifdef U8G2_WITH_PROFILE
+  {
+    u8g2_profile_t *profile = u8g2.profile;
+    u8g2_SetProfile(&u8g2, NULL);
+    u8g2_SetupBuffer(&u8g2, buf, 8, u8g2_ll_hvline_vertical_top_lsb, &u8g2_cb_r0);
+    if ( profile != NULL )
+      u8g2_SetProfile(&u8g2, profile);
+  }
+#else
+  u8g2_SetupBuffer(&u8g2, buf, 8, u8g2_ll_hvline_vertical_top_lsb, &u8g2_cb_r0);
+#endif
+  for( frame = 0; frame < 2; frame++ )
+  {
+    u8g2_ClearBuffer(&u8g2);
+    draw(frame);
+    u8g2_SendBuffer(&u8g2);
+  }
+  
+  tga_save("profile.tga");
+  return 0;
+}
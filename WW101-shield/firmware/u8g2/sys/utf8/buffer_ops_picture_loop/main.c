@@ -0,0 +1,336 @@
+
+#include "u8g2.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/*
+  Buffer operations (u8g2_buffer_ops.c): invert, xor overlay, masked copy
+  and region fill.
+
+  1) Compare the result of each operation with the same operation done
+     with u8g2_DrawPixel/u8g2_DrawBox for all buffer layouts, full buffer
+     and page mode (128x64 display, not connected).
+  2) Measure the throughput against u8g2_DrawBox.
+  3) Show an alert banner on the utf8 display.
+*/
+
+#define OP_INVERT 0
+#define OP_XOR 1
+#define OP_COPY_MASKED 2
+#define OP_FILL 3
+
+#define WIDTH 128
+#define HEIGHT 64
+#define BUF_SIZE (WIDTH*HEIGHT/2)	/* large enough for the 4 bit gray buffer */
+
+u8g2_t u8g2;
+
+uint8_t dut_buf[BUF_SIZE];	/* page or full buffer of the device under test */
+uint8_t frame[BUF_SIZE];	/* all pages of the device under test */
+uint8_t ref_buf[BUF_SIZE];	/* reference, drawn with DrawPixel/DrawBox */
+uint8_t overlay_buf[BUF_SIZE];
+uint8_t mask_buf[BUF_SIZE];
+
+/* the display is not connected */
+uint8_t u8x8_null_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+  return 1;
+}
+
+void setup_buffer(u8g2_t *u8g2, uint8_t *buf, uint8_t rows, u8g2_draw_ll_hvline_cb ll_hvline)
+{
+  if ( ll_hvline == u8g2_ll_hvline_horizontal_gray4 )
+    u8x8_Setup(u8g2_GetU8x8(u8g2), u8x8_d_ssd1325_nhd_128x64, u8x8_cad_001, u8x8_null_cb, u8x8_null_cb);
+  else
+    u8x8_Setup(u8g2_GetU8x8(u8g2), u8x8_d_ssd1306_128x64_noname, u8x8_cad_001, u8x8_null_cb, u8x8_null_cb);
+  u8g2_SetupBuffer(u8g2, buf, rows, ll_hvline, U8G2_R0);
+}
+
+uint8_t get_pixel(u8g2_t *u8g2, const uint8_t *buf, uint16_t x, uint16_t y)
+{
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_gray4 )
+  {
+    if ( x & 1 )
+      return buf[y*WIDTH/2+x/2] & 15;
+    return buf[y*WIDTH/2+x/2] >> 4;
+  }
+  if ( u8g2->ll_hvline == u8g2_ll_hvline_horizontal_right_lsb )
+    return (buf[y*WIDTH/8+x/8] >> (7-(x&7))) & 1;
+  return (buf[(y/8)*WIDTH+x] >> (y&7)) & 1;
+}
+
+void draw_scene(u8g2_t *u8g2)
+{
+  u8g2_SetGrayLevel(u8g2, 9);
+  u8g2_SetDrawColor(u8g2, 1);
+  u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+  u8g2_DrawDisc(u8g2, 40, 30, 20, U8G2_DRAW_ALL);
+  u8g2_SetGrayLevel(u8g2, 15);
+  u8g2_DrawBox(u8g2, 70, 5, 50, 30);
+  u8g2_SetDrawColor(u8g2, 2);
+  u8g2_DrawLine(u8g2, 0, 63, 127, 0);
+  u8g2_SetDrawColor(u8g2, 1);
+}
+
+void draw_overlay(u8g2_t *u8g2)
+{
+  u8g2_SetGrayLevel(u8g2, 6);
+  u8g2_DrawBox(u8g2, 10, 20, 100, 17);
+  u8g2_SetGrayLevel(u8g2, 15);
+  u8g2_DrawCircle(u8g2, 90, 40, 15, U8G2_DRAW_ALL);
+}
+
+void draw_mask(u8g2_t *u8g2)
+{
+  u8g2_SetGrayLevel(u8g2, 15);
+  u8g2_DrawBox(u8g2, 5, 3, 61, 20);
+  u8g2_DrawDisc(u8g2, 100, 45, 12, U8G2_DRAW_ALL);
+}
+
+void render_source(u8g2_draw_ll_hvline_cb ll_hvline, uint8_t *buf, void (*draw)(u8g2_t *u8g2))
+{
+  u8g2_t src;
+  setup_buffer(&src, buf, 8, ll_hvline);
+  u8g2_ClearBuffer(&src);
+  draw(&src);
+}
+
+struct region
+{
+  u8g2_uint_t x, y, w, h;
+};
+
+static const struct region region_list[] = {
+  { 0, 20, 128, 16 },	/* banner */
+  { 0, 0, 128, 64 },
+  { 3, 5, 1, 1 },
+  { 13, 11, 29, 3 },
+  { 1, 7, 7, 26 },
+  { 100, 50, 40, 30 },	/* clipped */
+  { 9, 8, 110, 8 }
+};
+
+#define REGION_CNT (sizeof(region_list)/sizeof(*region_list))
+
+/* apply operation with the buffer procedures */
+void dut_op(u8g2_t *u8g2, uint8_t op, uint8_t color, const struct region *r)
+{
+  switch(op)
+  {
+    case OP_INVERT:
+      u8g2_InvertBuffer(u8g2);
+      break;
+    case OP_XOR:
+      u8g2_XorBuffer(u8g2, overlay_buf);
+      break;
+    case OP_COPY_MASKED:
+      u8g2_CopyBufferMasked(u8g2, overlay_buf, mask_buf);
+      break;
+    case OP_FILL:
+      u8g2_SetGrayLevel(u8g2, 11);
+      u8g2_SetDrawColor(u8g2, color);
+      u8g2_FillBufferRegion(u8g2, r->x, r->y, r->w, r->h);
+      break;
+  }
+}
+
+/* apply operation with DrawPixel and DrawBox */
+void ref_op(u8g2_t *u8g2, uint8_t op, uint8_t color, const struct region *r)
+{
+  uint16_t x, y;
+  uint8_t v;
+  switch(op)
+  {
+    case OP_INVERT:
+      u8g2_SetGrayLevel(u8g2, 15);
+      u8g2_SetDrawColor(u8g2, 2);
+      u8g2_DrawBox(u8g2, 0, 0, WIDTH, HEIGHT);
+      break;
+    case OP_XOR:
+      u8g2_SetDrawColor(u8g2, 2);
+      for( y = 0; y < HEIGHT; y++ )
+	for( x = 0; x < WIDTH; x++ )
+	{
+	  v = get_pixel(u8g2, overlay_buf, x, y);
+	  if ( v != 0 )
+	  {
+	    u8g2_SetGrayLevel(u8g2, v);
+	    u8g2_DrawPixel(u8g2, x, y);
+	  }
+	}
+      break;
+    case OP_COPY_MASKED:
+      for( y = 0; y < HEIGHT; y++ )
+	for( x = 0; x < WIDTH; x++ )
+	{
+	  if ( get_pixel(u8g2, mask_buf, x, y) != 0 )
+	  {
+	    v = get_pixel(u8g2, overlay_buf, x, y);
+	    u8g2_SetDrawColor(u8g2, 0);
+	    u8g2_DrawPixel(u8g2, x, y);
+	    if ( v != 0 )
+	    {
+	      u8g2_SetGrayLevel(u8g2, v);
+	      u8g2_SetDrawColor(u8g2, 1);
+	      u8g2_DrawPixel(u8g2, x, y);
+	    }
+	  }
+	}
+      break;
+    case OP_FILL:
+      u8g2_SetGrayLevel(u8g2, 11);
+      u8g2_SetDrawColor(u8g2, color);
+      u8g2_DrawBox(u8g2, r->x, r->y, r->w, r->h);
+      break;
+  }
+}
+
+/* returns 0 if the page loop with the buffer procedure creates the same picture as the reference */
+int check(u8g2_draw_ll_hvline_cb ll_hvline, uint8_t rows, uint8_t op, uint8_t color, const struct region *r)
+{
+  u8g2_t dut, ref;
+  uint16_t row_size;
+  uint16_t size;
+  uint8_t visible;
+
+  setup_buffer(&dut, dut_buf, rows, ll_hvline);
+  setup_buffer(&ref, ref_buf, 8, ll_hvline);
+  row_size = WIDTH*u8g2_GetBufferTileSize(&dut)/8;
+  size = row_size*8;
+
+  memset(frame, 0x5a, sizeof(frame));
+  u8g2_FirstPage(&dut);
+  do
+  {
+    draw_scene(&dut);
+    dut_op(&dut, op, color, r);
+    visible = rows;
+    if ( dut.tile_curr_row + visible > 8 )
+      visible = 8 - dut.tile_curr_row;
+    memcpy(frame + dut.tile_curr_row*row_size, dut_buf, visible*row_size);
+  } while( u8g2_NextPage(&dut) );
+
+  u8g2_ClearBuffer(&ref);
+  draw_scene(&ref);
+  ref_op(&ref, op, color, r);
+
+  return memcmp(frame, ref_buf, size) != 0;
+}
+
+void check_all(void)
+{
+  static const u8g2_draw_ll_hvline_cb ll_hvline_list[3] = {
+    u8g2_ll_hvline_vertical_top_lsb, u8g2_ll_hvline_horizontal_right_lsb, u8g2_ll_hvline_horizontal_gray4 };
+  static const char *name_list[3] = { "vertical_top_lsb", "horizontal_right_lsb", "horizontal_gray4" };
+  static const uint8_t rows_list[3] = { 8, 3, 1 };
+  unsigned l, n, op, color, i;
+  unsigned cnt, err;
+
+  for( l = 0; l < 3; l++ )
+  {
+    render_source(ll_hvline_list[l], overlay_buf, draw_overlay);
+    render_source(ll_hvline_list[l], mask_buf, draw_mask);
+    cnt = 0;
+    err = 0;
+    for( n = 0; n < 3; n++ )
+    {
+      for( op = OP_INVERT; op < OP_FILL; op++ )
+      {
+	cnt++;
+	if ( check(ll_hvline_list[l], rows_list[n], op, 0, region_list) != 0 )
+	{
+	  printf("FAIL %s rows=%u op=%u\n", name_list[l], rows_list[n], op);
+	  err++;
+	}
+      }
+      for( color = 0; color < 3; color++ )
+      {
+	for( i = 0; i < REGION_CNT; i++ )
+	{
+	  cnt++;
+	  if ( check(ll_hvline_list[l], rows_list[n], OP_FILL, color, region_list+i) != 0 )
+	  {
+	    printf("FAIL %s rows=%u fill color=%u region=%u\n", name_list[l], rows_list[n], color, i);
+	    err++;
+	  }
+	}
+      }
+    }
+    printf("%-20s %3u checks, %u failed\n", name_list[l], cnt, err);
+  }
+}
+
+/*============================================*/
+
+#define LOOPS 20000
+
+double measure(u8g2_t *u8g2, uint8_t op, uint8_t is_ref)
+{
+  clock_t t;
+  unsigned i;
+
+  t = clock();
+  for( i = 0; i < LOOPS; i++ )
+  {
+    if ( is_ref )
+      ref_op(u8g2, op, 2, region_list);
+    else
+      dut_op(u8g2, op, 2, region_list);
+  }
+  t = clock() - t;
+  return (double)LOOPS * CLOCKS_PER_SEC / (double)(t == 0 ? 1 : t);
+}
+
+void measure_all(void)
+{
+  static const u8g2_draw_ll_hvline_cb ll_hvline_list[3] = {
+    u8g2_ll_hvline_vertical_top_lsb, u8g2_ll_hvline_horizontal_right_lsb, u8g2_ll_hvline_horizontal_gray4 };
+  static const char *name_list[3] = { "vertical_top_lsb", "horizontal_right_lsb", "horizontal_gray4" };
+  u8g2_t dut;
+  unsigned l;
+
+  printf("\n%-20s %14s %14s %14s %14s %14s\n", "ops/s, 128x64", "DrawBox full", "InvertBuffer", "DrawBox banner", "FillRegion", "XorBuffer");
+  for( l = 0; l < 3; l++ )
+  {
+    render_source(ll_hvline_list[l], overlay_buf, draw_overlay);
+    setup_buffer(&dut, dut_buf, 8, ll_hvline_list[l]);
+    u8g2_ClearBuffer(&dut);
+    printf("%-20s", name_list[l]);
+    printf(" %14.0f", measure(&dut, OP_INVERT, 1));
+    printf(" %14.0f", measure(&dut, OP_INVERT, 0));
+    printf(" %14.0f", measure(&dut, OP_FILL, 1));
+    printf(" %14.0f", measure(&dut, OP_FILL, 0));
+    printf(" %14.0f\n", measure(&dut, OP_XOR, 0));
+  }
+  printf("\n");
+}
+
+/*============================================*/
+
+int main(void)
+{
+  check_all();
+  measure_all();
+
+  u8g2_SetupBuffer_Utf8(&u8g2, U8G2_R0);
+
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);
+
+  u8g2_FirstPage(&u8g2);
+  do
+  {
+    u8g2_DrawFrame(&u8g2, 0, 0, 102, 32);
+    u8g2_DrawDisc(&u8g2, 20, 16, 12, U8G2_DRAW_ALL);
+    u8g2_DrawTriangle(&u8g2, 50, 28, 70, 4, 90, 28);
+    /* alert banner */
+    u8g2_SetDrawColor(&u8g2, 2);
+    u8g2_FillBufferRegion(&u8g2, 0, 10, 102, 12);
+    u8g2_SetDrawColor(&u8g2, 1);
+  } while( u8g2_NextPage(&u8g2) );
+
+  utf8_show();
+
+  return 0;
+}
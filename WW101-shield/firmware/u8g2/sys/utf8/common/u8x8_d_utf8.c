@@ -153,7 +153,8 @@ static const u8x8_display_info_t u8x8_utf8_info =
   /* default_x_offset = */ 0,
   /* flipmode_x_offset = */ 0,
   /* pixel_width = */ CHGR_WIDTH,
-  /* pixel_height = */ CHGR_HEIGHT
+  /* pixel_height = */ CHGR_HEIGHT,
+  /* flags = */ 0
 };
 
 
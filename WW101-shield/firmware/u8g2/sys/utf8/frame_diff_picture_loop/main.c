@@ -0,0 +1,42 @@
+
+#include "u8g2.h"
+#include <stdio.h>
+
+/* 
+  Frame difference mode: only changed tiles are sent to the display.
+  Requires U8G2_WITH_FRAME_DIFF (see Makefile)
+*/
+  
+u8g2_t u8g2;
+uint8_t shadow[13*8*4];		/* tile_width*8*tile_height of the 102x32 utf8 display */
+
+int main(void)
+{
+  uint8_t frame;
+
+  u8g2_SetupBuffer_Utf8(&u8g2, U8G2_R0);
+  
+  u8g2_InitDisplay(&u8g2);
+  u8g2_SetPowerSave(&u8g2, 0);  
+  
+  u8g2_SetShadowBuffer(&u8g2, shadow);
+  
+  for( frame = 0; frame < 16; frame++ )
+  {
+    u8g2_FirstPage(&u8g2);
+    do
+    {      
+      u8g2_DrawFrame(&u8g2, 0, 0, 96, 32);
+      u8g2_DrawDisc(&u8g2, 70, 16, 10, U8G2_DRAW_ALL);
+      u8g2_DrawBox(&u8g2, 2+frame*3, 12, 8, 8);
+    } while( u8g2_NextPage(&u8g2) );
+    
+    printf("frame %2d: sent %4u bytes, saved %4u bytes\n", frame, 
+      u8g2_GetFrameDiffSentBytes(&u8g2), u8g2_GetFrameDiffSavedBytes(&u8g2));
+  }
+    
+  utf8_show();
+  
+  return 0;
+}
+